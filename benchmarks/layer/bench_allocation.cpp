@@ -0,0 +1,51 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "bench_allocation.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+static std::atomic<int64_t> allocation_count{0};
+static std::atomic<int64_t> allocation_bytes{0};
+
+void *operator new(std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocation_bytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed);
+    if (void *memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept { std::free(memory); }
+
+void operator delete(void *memory, std::size_t) noexcept { std::free(memory); }
+
+int64_t GetAllocationCount() { return allocation_count.load(std::memory_order_relaxed); }
+
+int64_t GetAllocationBytes() { return allocation_bytes.load(std::memory_order_relaxed); }
+
+int64_t GetResidentBytes() {
+#if defined(__linux__)
+    long pages = 0;
+    long resident_pages = 0;
+    FILE *statm = std::fopen("/proc/self/statm", "r");
+    if (statm == nullptr) {
+        return 0;
+    }
+    const int read = std::fscanf(statm, "%ld %ld", &pages, &resident_pages);
+    std::fclose(statm);
+    return read == 2 ? static_cast<int64_t>(resident_pages) * sysconf(_SC_PAGESIZE) : 0;
+#else
+    return 0;
+#endif
+}
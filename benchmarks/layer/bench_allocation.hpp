@@ -0,0 +1,15 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <cstdint>
+
+// Number of operator new calls and bytes allocated since the start of the benchmark process
+int64_t GetAllocationCount();
+int64_t GetAllocationBytes();
+
+// Resident memory of the process, 0 where it can't be queried
+int64_t GetResidentBytes();
@@ -0,0 +1,137 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <benchmark/benchmark.h>
+
+#include "vulkan/layer/vk_layer_settings.h"
+
+#include <string>
+#include <vector>
+
+// VkLayerSettingEXT entries spread over several layers, the benchmarked layer owns a fifth of them
+static void BM_HasLayerSetting_API(benchmark::State &state) {
+    static const char *layer_names[] = {"VK_LAYER_LUNARG_bench", "VK_LAYER_LUNARG_a", "VK_LAYER_LUNARG_b",
+                                        "VK_LAYER_LUNARG_c", "VK_LAYER_LUNARG_d"};
+
+    const std::size_t setting_count = static_cast<std::size_t>(state.range(0));
+
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i < setting_count; ++i) {
+        names.push_back("bench_setting_" + std::to_string(i));
+    }
+
+    const uint32_t value = 76;
+    std::vector<VkLayerSettingEXT> settings;
+    for (std::size_t i = 0; i < setting_count; ++i) {
+        settings.push_back({layer_names[i % std::size(layer_names)], names[i].c_str(), VK_LAYER_SETTING_TYPE_UINT32_EXT, 1, &value});
+    }
+
+    const VkLayerSettingsCreateInfoEXT create_info{VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr,
+                                                   static_cast<uint32_t>(settings.size()), settings.data()};
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_bench", &create_info, nullptr, nullptr, &layerSettingSet);
+
+    std::size_t query_index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(vlHasLayerSetting(layerSettingSet, names[query_index].c_str()));
+        query_index = (query_index + std::size(layer_names)) % setting_count;
+    }
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+BENCHMARK(BM_HasLayerSetting_API)->Arg(10)->Arg(100)->Arg(1000);
+
+// Startup of a layer reading 60 settings, half of them set by VK_EXT_layer_settings
+struct BatchWorkload {
+    BatchWorkload() {
+        for (std::size_t i = 0; i < 60; ++i) {
+            names.push_back("batch_setting_" + std::to_string(i));
+        }
+        for (std::size_t i = 0; i < names.size(); i += 2) {
+            settings.push_back({"VK_LAYER_LUNARG_bench", names[i].c_str(), VK_LAYER_SETTING_TYPE_UINT32_EXT, 1, &value});
+        }
+        create_info = {VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr, static_cast<uint32_t>(settings.size()),
+                       settings.data()};
+    }
+
+    uint32_t value{76};
+    std::vector<std::string> names;
+    std::vector<VkLayerSettingEXT> settings;
+    VkLayerSettingsCreateInfoEXT create_info{};
+};
+
+static void BM_GetLayerSettingValues_PerSetting(benchmark::State &state) {
+    static const BatchWorkload workload;
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_bench", &workload.create_info, nullptr, nullptr, &layerSettingSet);
+
+    std::vector<uint32_t> values(workload.names.size());
+    for (auto _ : state) {
+        for (std::size_t i = 0, n = workload.names.size(); i < n; ++i) {
+            uint32_t value_count = 1;
+            vlGetLayerSettingValues(layerSettingSet, workload.names[i].c_str(), VL_LAYER_SETTING_TYPE_UINT32, &value_count,
+                                    &values[i]);
+        }
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(workload.names.size()));
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+BENCHMARK(BM_GetLayerSettingValues_PerSetting);
+
+static void BM_GetLayerSettingValues_Batch(benchmark::State &state) {
+    static const BatchWorkload workload;
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_bench", &workload.create_info, nullptr, nullptr, &layerSettingSet);
+
+    std::vector<uint32_t> values(workload.names.size());
+    std::vector<VlLayerSettingQuery> queries(workload.names.size());
+    for (auto _ : state) {
+        for (std::size_t i = 0, n = workload.names.size(); i < n; ++i) {
+            queries[i] = {workload.names[i].c_str(), VL_LAYER_SETTING_TYPE_UINT32, 1, &values[i], VK_SUCCESS};
+        }
+        vlGetLayerSettingValuesBatch(layerSettingSet, static_cast<uint32_t>(queries.size()), queries.data());
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(workload.names.size()));
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+BENCHMARK(BM_GetLayerSettingValues_Batch);
+
+#if (defined(__linux__) && !defined(__ANDROID__)) || defined(__APPLE__)
+// Queries of a frozen layer setting set, without (0) and with (1) a settings overlay which isn't written meanwhile
+static void BM_GetLayerSettingValues_Overlay(benchmark::State &state) {
+    static const BatchWorkload workload;
+    const char *segment_name = "vl_bench_overlay";
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_bench", &workload.create_info, nullptr, nullptr, &layerSettingSet);
+    if (state.range(0) != 0) {
+        vlSetLayerSettingsOverlayValue(segment_name, "VK_LAYER_LUNARG_bench", workload.names[1].c_str(), "82");
+        vlAttachLayerSettingsOverlay(layerSettingSet, segment_name, VL_LAYER_SETTINGS_OVERLAY_PRIORITY_HIGHEST);
+    }
+    vlFreezeLayerSettingSet(layerSettingSet);
+
+    std::vector<uint32_t> values(workload.names.size());
+    for (auto _ : state) {
+        for (std::size_t i = 0, n = workload.names.size(); i < n; ++i) {
+            uint32_t value_count = 1;
+            vlGetLayerSettingValues(layerSettingSet, workload.names[i].c_str(), VL_LAYER_SETTING_TYPE_UINT32, &value_count,
+                                    &values[i]);
+        }
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(workload.names.size()));
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+    vlRemoveLayerSettingsOverlay(segment_name);
+}
+BENCHMARK(BM_GetLayerSettingValues_Overlay)->Arg(0)->Arg(1);
+#endif
@@ -0,0 +1,115 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <benchmark/benchmark.h>
+
+#include "vulkan/layer/vk_layer_settings.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+static void SetSettingsPath(const std::filesystem::path &filename) {
+#ifdef _WIN32
+    _putenv_s("VK_LAYER_SETTINGS_PATH", filename.string().c_str());
+#else
+    setenv("VK_LAYER_SETTINGS_PATH", filename.c_str(), 1);
+#endif
+}
+
+static void ClearSettingsPath() {
+#ifdef _WIN32
+    _putenv_s("VK_LAYER_SETTINGS_PATH", "");
+#else
+    unsetenv("VK_LAYER_SETTINGS_PATH");
+#endif
+}
+
+// Creation of a layer setting set with 'setting_count' VK_EXT_layer_settings values and no settings file
+static void BM_CreateLayerSettingSet_API(benchmark::State &state) {
+    const std::size_t setting_count = static_cast<std::size_t>(state.range(0));
+
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i < setting_count; ++i) {
+        names.push_back("bench_setting_" + std::to_string(i));
+    }
+
+    const uint32_t value = 76;
+    std::vector<VkLayerSettingEXT> settings;
+    for (std::size_t i = 0; i < setting_count; ++i) {
+        settings.push_back({"VK_LAYER_LUNARG_bench", names[i].c_str(), VK_LAYER_SETTING_TYPE_UINT32_EXT, 1, &value});
+    }
+
+    const VkLayerSettingsCreateInfoEXT create_info{VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr,
+                                                   static_cast<uint32_t>(settings.size()), settings.data()};
+
+    SetSettingsPath(std::filesystem::temp_directory_path() / "bench_layer_settings_missing.txt");
+    for (auto _ : state) {
+        VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+        vlCreateLayerSettingSet("VK_LAYER_LUNARG_bench", &create_info, nullptr, nullptr, &layerSettingSet);
+        benchmark::DoNotOptimize(layerSettingSet);
+        vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+    }
+    ClearSettingsPath();
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(setting_count));
+}
+BENCHMARK(BM_CreateLayerSettingSet_API)->RangeMultiplier(10)->Range(10, 100000)->Unit(benchmark::kMicrosecond);
+
+// Creation of a layer setting set with a settings file of 'setting_count' settings of the layer, which is only found
+// and parsed by the first query
+static void BM_CreateLayerSettingSet_File(benchmark::State &state) {
+    const std::size_t setting_count = static_cast<std::size_t>(state.range(0));
+
+    const std::filesystem::path filename =
+        std::filesystem::temp_directory_path() / ("bench_layer_settings_create_" + std::to_string(setting_count) + ".txt");
+    {
+        std::ofstream file(filename, std::ios::trunc);
+        for (std::size_t i = 0; i < setting_count; ++i) {
+            file << "lunarg_bench.bench_setting_" << i << " = " << i << "\n";
+        }
+    }
+
+    SetSettingsPath(filename);
+    for (auto _ : state) {
+        VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+        vlCreateLayerSettingSet("VK_LAYER_LUNARG_bench", nullptr, nullptr, nullptr, &layerSettingSet);
+        benchmark::DoNotOptimize(layerSettingSet);
+        vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+    }
+    ClearSettingsPath();
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(setting_count));
+}
+BENCHMARK(BM_CreateLayerSettingSet_File)->RangeMultiplier(10)->Range(10, 100000)->Unit(benchmark::kMicrosecond);
+
+// Creation followed by the first query, which finds and parses the settings file of 'setting_count' settings. The
+// parsed file is shared by the layer setting sets of the process, so this measures the sets created after the first one.
+static void BM_CreateLayerSettingSet_FirstQuery(benchmark::State &state) {
+    const std::size_t setting_count = static_cast<std::size_t>(state.range(0));
+
+    const std::filesystem::path filename =
+        std::filesystem::temp_directory_path() / ("bench_layer_settings_create_" + std::to_string(setting_count) + ".txt");
+    {
+        std::ofstream file(filename, std::ios::trunc);
+        for (std::size_t i = 0; i < setting_count; ++i) {
+            file << "lunarg_bench.bench_setting_" << i << " = " << i << "\n";
+        }
+    }
+
+    SetSettingsPath(filename);
+    for (auto _ : state) {
+        VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+        vlCreateLayerSettingSet("VK_LAYER_LUNARG_bench", nullptr, nullptr, nullptr, &layerSettingSet);
+        benchmark::DoNotOptimize(vlHasLayerSetting(layerSettingSet, "bench_setting_0"));
+        vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+    }
+    ClearSettingsPath();
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(setting_count));
+}
+BENCHMARK(BM_CreateLayerSettingSet_FirstQuery)->RangeMultiplier(10)->Range(10, 100000)->Unit(benchmark::kMicrosecond);
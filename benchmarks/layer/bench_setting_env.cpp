@@ -0,0 +1,87 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <benchmark/benchmark.h>
+
+#include "vulkan/layer/vk_layer_settings.h"
+#include "layer_settings_util.hpp"
+#include "bench_allocation.hpp"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+static const char *bench_setting_names[] = {"env_setting_a", "env_setting_b", "env_setting_c", "env_setting_d",
+                                            "missing_setting_a", "missing_setting_b", "missing_setting_c", "missing_setting_d"};
+
+static void SetBenchEnvironment() {
+#ifdef _WIN32
+    _putenv("VK_LUNARG_BENCH_ENV_SETTING_A=1");
+    _putenv("VK_BENCH_ENV_SETTING_B=2");
+    _putenv("VK_ENV_SETTING_C=3");
+    _putenv("VK_LUNARG_BENCH_ENV_SETTING_D=4");
+#else
+    setenv("VK_LUNARG_BENCH_ENV_SETTING_A", "1", 1);
+    setenv("VK_BENCH_ENV_SETTING_B", "2", 1);
+    setenv("VK_ENV_SETTING_C", "3", 1);
+    setenv("VK_LUNARG_BENCH_ENV_SETTING_D", "4", 1);
+#endif
+}
+
+// Per query lookup of the environment as done before the environment was indexed at creation
+static std::string GetEnvSettingPerQuery(const char *pLayerName, const char *pSettingName, int64_t &getenv_count) {
+    for (int i = vl::TRIM_FIRST, n = vl::TRIM_LAST; i <= n; ++i) {
+        const std::string &env_name = vl::GetEnvSettingName(pLayerName, pSettingName, static_cast<vl::TrimMode>(i));
+        ++getenv_count;
+        const char *value = std::getenv(env_name.c_str());
+        if (value != nullptr && value[0] != '\0') {
+            return value;
+        }
+    }
+    return "";
+}
+
+// A query looks up the environment twice: once for vlHasLayerSetting and once for vlGetLayerSettingValues
+static void BM_EnvSetting_PerQueryGetenv(benchmark::State &state) {
+    SetBenchEnvironment();
+
+    int64_t getenv_count = 0;
+    const int64_t allocation_begin = GetAllocationCount();
+    for (auto _ : state) {
+        for (const char *name : bench_setting_names) {
+            benchmark::DoNotOptimize(GetEnvSettingPerQuery("VK_LAYER_LUNARG_bench", name, getenv_count).empty());
+            benchmark::DoNotOptimize(GetEnvSettingPerQuery("VK_LAYER_LUNARG_bench", name, getenv_count));
+        }
+    }
+    const double queries = static_cast<double>(state.iterations() * static_cast<int64_t>(std::size(bench_setting_names)));
+    state.counters["getenv_per_query"] = static_cast<double>(getenv_count) / queries;
+    state.counters["allocations_per_query"] = static_cast<double>(GetAllocationCount() - allocation_begin) / queries;
+}
+BENCHMARK(BM_EnvSetting_PerQueryGetenv);
+
+static void BM_EnvSetting_Indexed(benchmark::State &state) {
+    SetBenchEnvironment();
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_bench", nullptr, nullptr, nullptr, &layerSettingSet);
+
+    const int64_t allocation_begin = GetAllocationCount();
+    for (auto _ : state) {
+        for (const char *name : bench_setting_names) {
+            if (vlHasLayerSetting(layerSettingSet, name)) {
+                uint32_t value = 0;
+                uint32_t value_count = 1;
+                vlGetLayerSettingValues(layerSettingSet, name, VL_LAYER_SETTING_TYPE_UINT32, &value_count, &value);
+                benchmark::DoNotOptimize(value);
+            }
+        }
+    }
+    const double queries = static_cast<double>(state.iterations() * static_cast<int64_t>(std::size(bench_setting_names)));
+    state.counters["getenv_per_query"] = 0.0;
+    state.counters["allocations_per_query"] = static_cast<double>(GetAllocationCount() - allocation_begin) / queries;
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+BENCHMARK(BM_EnvSetting_Indexed);
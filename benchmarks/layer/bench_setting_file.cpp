@@ -0,0 +1,123 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <benchmark/benchmark.h>
+
+#include "layer_settings_cache.hpp"
+#include "layer_settings_file.hpp"
+#include "layer_settings_util.hpp"
+#include "bench_allocation.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+
+// Generated settings file of 50k lines: 100 layers of 400 settings with comments and blank lines
+static const std::filesystem::path &GetSettingsFile() {
+    static const std::filesystem::path filename = [] {
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "bench_layer_settings_50k.txt";
+        std::ofstream file(path);
+        for (int layer = 0; layer < 100; ++layer) {
+            file << "# Settings of VK_LAYER_LUNARG_bench_" << layer << "\n\n";
+            for (int setting = 0; setting < 400; ++setting) {
+                file << "lunarg_bench_" << layer << ".setting_" << setting << " = " << setting << "," << layer << "\n";
+                if (setting % 4 == 0) {
+                    file << "# Description of setting_" << setting << "\n";
+                }
+            }
+            file << "lunarg_bench_" << layer << ".message_id_filter = 0x4dae5635,0x76589099,0xc05b3a9d\n";
+            file << "\n\n\n";
+        }
+        return path;
+    }();
+    return filename;
+}
+
+// Parser used before vl::SettingsFile: std::getline, substr copies and a std::map
+static std::unique_ptr<std::map<std::string, std::string>> ParseSettingsFileStream(const std::filesystem::path &filename) {
+    std::unique_ptr<std::map<std::string, std::string>> setting_file_values(new std::map<std::string, std::string>);
+
+    std::ifstream file(filename);
+    if (file.good()) {
+        for (std::string line; std::getline(file, line);) {
+            const auto comments_pos = line.find_first_of('#');
+            if (comments_pos != std::string::npos) line.erase(comments_pos);
+
+            const auto value_pos = line.find_first_of('=');
+            if (value_pos != std::string::npos) {
+                const std::string setting_key = vl::TrimWhitespace(line.substr(0, value_pos));
+                const std::string setting_value = vl::TrimWhitespace(line.substr(value_pos + 1));
+                (*setting_file_values)[setting_key] = setting_value;
+            }
+        }
+    }
+
+    return setting_file_values;
+}
+
+static std::unique_ptr<vl::SettingsFile> ParseSettingsFileRead(const std::filesystem::path &filename) {
+    std::unique_ptr<vl::SettingsFile> settings_file(new vl::SettingsFile);
+    settings_file->ParseFile(filename);
+    return settings_file;
+}
+
+// Report the memory held by one parsed file: heap allocations and resident memory
+template <typename Parse>
+static void ParseSettingsFile(benchmark::State &state, Parse parse) {
+    const std::filesystem::path &filename = GetSettingsFile();
+
+    // Measured on the first run only, before the iterations leave freed memory to the allocator.
+    // Run the benchmark alone with --benchmark_filter for a meaningful resident memory.
+    struct Memory {
+        int64_t heap_bytes;
+        int64_t allocations;
+        int64_t resident_bytes;
+    };
+    static const Memory memory = [&] {
+        const int64_t resident_begin = GetResidentBytes();
+        const int64_t allocation_bytes_begin = GetAllocationBytes();
+        const int64_t allocation_count_begin = GetAllocationCount();
+        auto parsed = parse(filename);
+        return Memory{GetAllocationBytes() - allocation_bytes_begin, GetAllocationCount() - allocation_count_begin,
+                      GetResidentBytes() - resident_begin};
+    }();
+    state.counters["heap_bytes"] = static_cast<double>(memory.heap_bytes);
+    state.counters["allocations"] = static_cast<double>(memory.allocations);
+    state.counters["resident_bytes"] = static_cast<double>(memory.resident_bytes);
+
+    for (auto _ : state) {
+        auto parsed = parse(filename);
+        benchmark::DoNotOptimize(parsed.get());
+    }
+    state.SetItemsProcessed(state.iterations() * 50000);
+}
+
+static void BM_ParseSettingsFile_Stream(benchmark::State &state) { ParseSettingsFile(state, ParseSettingsFileStream); }
+BENCHMARK(BM_ParseSettingsFile_Stream)->Unit(benchmark::kMillisecond);
+
+static void BM_ParseSettingsFile_Read(benchmark::State &state) { ParseSettingsFile(state, ParseSettingsFileRead); }
+BENCHMARK(BM_ParseSettingsFile_Read)->Unit(benchmark::kMillisecond);
+
+// Settings of one of the 100 layers precompiled by vlCompileLayerSettingsCache, loaded instead of parsing the whole file
+static void BM_LoadSettingsCache(benchmark::State &state) {
+    const std::filesystem::path &filename = GetSettingsFile();
+    const std::filesystem::path cache_filename = vl::GetSettingsCachePath(filename, "lunarg_bench_0.");
+
+    vl::SettingsFile settings_file;
+    settings_file.ParseFile(filename);
+    if (!vl::WriteSettingsCache(cache_filename, filename, settings_file, "lunarg_bench_0.")) {
+        state.SkipWithError("Failed to write the settings cache");
+        return;
+    }
+
+    for (auto _ : state) {
+        auto loaded = vl::LoadSettingsCache(cache_filename, filename, "lunarg_bench_0.", nullptr);
+        benchmark::DoNotOptimize(loaded.get());
+    }
+    state.SetItemsProcessed(state.iterations() * 401);
+}
+BENCHMARK(BM_LoadSettingsCache)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,98 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <benchmark/benchmark.h>
+
+#include "vulkan/layer/vk_layer_settings.hpp"
+
+#include <random>
+#include <vector>
+
+// Hundreds of overlapping framesets with steps from 1 to 8, bounded and unbounded, starting in the first 100k frames
+static const std::vector<VlFrameset> &GetFramesets() {
+    static const std::vector<VlFrameset> framesets = [] {
+        std::mt19937 random(76);
+        std::vector<VlFrameset> result;
+        for (int i = 0; i < 400; ++i) {
+            const uint32_t first = random() % 100000;
+            const uint32_t count = i % 10 == 0 ? 0 : random() % 2000;
+            const uint32_t step = 1 + random() % 8;
+            result.push_back(VlFrameset{first, count, step});
+        }
+        return result;
+    }();
+    return framesets;
+}
+
+// What capture and screenshot layers do on each vkQueuePresentKHR: iterate the framesets
+static bool IsFrameSelected(const std::vector<VlFrameset> &framesets, uint64_t frame) {
+    for (const VlFrameset &frameset : framesets) {
+        if (frameset.step == 0 || frame < frameset.first || (frame - frameset.first) % frameset.step != 0) {
+            continue;
+        }
+        if (frameset.count == 0 || (frame - frameset.first) / frameset.step < frameset.count) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void BM_FrameSelected_Iterate(benchmark::State &state) {
+    const std::vector<VlFrameset> &framesets = GetFramesets();
+
+    uint64_t frame = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(IsFrameSelected(framesets, frame));
+        frame = (frame + 1) % 120000;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FrameSelected_Iterate);
+
+static void BM_FrameSelected_Schedule(benchmark::State &state) {
+    const VlFrameSchedule schedule(GetFramesets());
+
+    uint64_t frame = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(schedule.IsSelected(frame));
+        frame = (frame + 1) % 120000;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FrameSelected_Schedule);
+
+static void BM_FrameSelected_ScheduleRandom(benchmark::State &state) {
+    const VlFrameSchedule schedule(GetFramesets());
+
+    std::mt19937 random(82);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(schedule.IsSelected(random() % 120000));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FrameSelected_ScheduleRandom);
+
+static void BM_NextSelectedFrame_Schedule(benchmark::State &state) {
+    const VlFrameSchedule schedule(GetFramesets());
+
+    uint64_t frame = 0;
+    for (auto _ : state) {
+        const uint64_t next = schedule.NextSelected(frame);
+        benchmark::DoNotOptimize(next);
+        frame = next >= 120000 ? 0 : next + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_NextSelectedFrame_Schedule);
+
+static void BM_CompileFrameSchedule(benchmark::State &state) {
+    const std::vector<VlFrameset> &framesets = GetFramesets();
+
+    for (auto _ : state) {
+        VlFrameSchedule schedule(framesets);
+        benchmark::DoNotOptimize(&schedule);
+    }
+}
+BENCHMARK(BM_CompileFrameSchedule)->Unit(benchmark::kMillisecond);
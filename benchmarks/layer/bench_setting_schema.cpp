@@ -0,0 +1,197 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <benchmark/benchmark.h>
+
+#include "vulkan/layer/vk_layer_settings.hpp"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Settings of a layer read at startup, the lists come from environment variables
+struct SchemaSettings {
+    VL_LAYER_SETTING(bool, validate_core, true);
+    VL_LAYER_SETTING(bool, validate_sync, false);
+    VL_LAYER_SETTING(uint32_t, duplicate_message_limit, 10);
+    VL_LAYER_SETTING(std::vector<std::string>, message_id_filter, {});
+    VL_LAYER_SETTING(std::vector<uint32_t>, message_ids, {});
+    VL_LAYER_SETTING(std::string, log_filename, "stdout");
+    VL_LAYER_SETTING(double, timeout, 1.0);
+    VL_LAYER_SETTING(int64_t, unset_value, 0);
+
+    auto GetLayerSettings() {
+        return std::tie(validate_core, validate_sync, duplicate_message_limit, message_id_filter, message_ids, log_filename,
+                        timeout, unset_value);
+    }
+};
+
+static void SetSchemaEnvironment() {
+    std::string message_id_filter;
+    std::string message_ids;
+    for (int i = 0; i < 64; ++i) {
+        message_id_filter += (i == 0 ? "" : ",") + std::string("VUID-vkCmdDraw-None-") + std::to_string(2000 + i);
+        message_ids += (i == 0 ? "" : ",") + std::to_string(0x10000 + i);
+    }
+
+    static const std::string variables[] = {
+        "VK_LUNARG_SCHEMA_VALIDATE_SYNC=true",       "VK_LUNARG_SCHEMA_DUPLICATE_MESSAGE_LIMIT=20",
+        "VK_LUNARG_SCHEMA_MESSAGE_ID_FILTER=" + message_id_filter, "VK_LUNARG_SCHEMA_MESSAGE_IDS=" + message_ids,
+        "VK_LUNARG_SCHEMA_LOG_FILENAME=layer.txt",   "VK_LUNARG_SCHEMA_TIMEOUT=2.5"};
+    for (const std::string &variable : variables) {
+#ifdef _WIN32
+        _putenv(variable.c_str());
+#else
+        putenv(const_cast<char *>(variable.c_str()));
+#endif
+    }
+}
+
+static void BM_GetLayerSettings_PerSetting(benchmark::State &state) {
+    SetSchemaEnvironment();
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_schema", nullptr, nullptr, nullptr, &layerSettingSet);
+
+    for (auto _ : state) {
+        SchemaSettings settings;
+        vlGetLayerSettingValue(layerSettingSet, "validate_core", settings.validate_core.value);
+        vlGetLayerSettingValue(layerSettingSet, "validate_sync", settings.validate_sync.value);
+        vlGetLayerSettingValue(layerSettingSet, "duplicate_message_limit", settings.duplicate_message_limit.value);
+        vlGetLayerSettingValues(layerSettingSet, "message_id_filter", settings.message_id_filter.value);
+        vlGetLayerSettingValues(layerSettingSet, "message_ids", settings.message_ids.value);
+        vlGetLayerSettingValue(layerSettingSet, "log_filename", settings.log_filename.value);
+        vlGetLayerSettingValue(layerSettingSet, "timeout", settings.timeout.value);
+        vlGetLayerSettingValue(layerSettingSet, "unset_value", settings.unset_value.value);
+        benchmark::DoNotOptimize(settings);
+    }
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+BENCHMARK(BM_GetLayerSettings_PerSetting);
+
+static void BM_GetLayerSettings_Schema(benchmark::State &state) {
+    SetSchemaEnvironment();
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_schema", nullptr, nullptr, nullptr, &layerSettingSet);
+
+    for (auto _ : state) {
+        SchemaSettings settings;
+        vlGetLayerSettings(layerSettingSet, settings);
+        benchmark::DoNotOptimize(settings);
+    }
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+BENCHMARK(BM_GetLayerSettings_Schema);
+
+// A layer reading 200 settings at startup, only 5 of which are set: most queries are for unset settings
+static const std::vector<std::string> &GetWideSchemaNames() {
+    static const std::vector<std::string> names = []() {
+        std::vector<std::string> result;
+        for (int i = 0; i < 200; ++i) {
+            result.push_back("wide_setting_" + std::to_string(i));
+        }
+        return result;
+    }();
+    return names;
+}
+
+static void SetWideSchemaEnvironment() {
+    static const std::string variables[] = {"VK_LUNARG_WIDE_SCHEMA_WIDE_SETTING_0=true", "VK_LUNARG_WIDE_SCHEMA_WIDE_SETTING_40=20",
+                                            "VK_LUNARG_WIDE_SCHEMA_WIDE_SETTING_80=layer.txt",
+                                            "VK_LUNARG_WIDE_SCHEMA_WIDE_SETTING_120=2.5",
+                                            "VK_LUNARG_WIDE_SCHEMA_WIDE_SETTING_160=1,2,3"};
+    for (const std::string &variable : variables) {
+#ifdef _WIN32
+        _putenv(variable.c_str());
+#else
+        putenv(const_cast<char *>(variable.c_str()));
+#endif
+    }
+}
+
+static void BM_HasLayerSetting_WideSchema(benchmark::State &state) {
+    SetWideSchemaEnvironment();
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_wide_schema", nullptr, nullptr, nullptr, &layerSettingSet);
+
+    const std::vector<std::string> &names = GetWideSchemaNames();
+    for (auto _ : state) {
+        uint32_t found_count = 0;
+        for (const std::string &name : names) {
+            found_count += vlHasLayerSetting(layerSettingSet, name.c_str());
+        }
+        benchmark::DoNotOptimize(found_count);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(names.size()));
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+BENCHMARK(BM_HasLayerSetting_WideSchema);
+
+static void BM_GetLayerSettingValues_WideSchema(benchmark::State &state) {
+    SetWideSchemaEnvironment();
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_wide_schema", nullptr, nullptr, nullptr, &layerSettingSet);
+
+    const std::vector<std::string> &names = GetWideSchemaNames();
+    for (auto _ : state) {
+        uint32_t value_count_sum = 0;
+        for (const std::string &name : names) {
+            uint32_t value_count = 0;
+            vlGetLayerSettingValues(layerSettingSet, name.c_str(), VL_LAYER_SETTING_TYPE_STRING, &value_count, nullptr);
+            value_count_sum += value_count;
+        }
+        benchmark::DoNotOptimize(value_count_sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(names.size()));
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+BENCHMARK(BM_GetLayerSettingValues_WideSchema);
+
+// Listing the 5 settings set, compared to probing the 200 names of the schema with BM_HasLayerSetting_WideSchema.
+// Enumerates a live (0) or frozen (1) layer setting set.
+static void BM_EnumerateLayerSettings_WideSchema(benchmark::State &state) {
+    SetWideSchemaEnvironment();
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_wide_schema", nullptr, nullptr, nullptr, &layerSettingSet);
+    if (state.range(0) != 0) {
+        vlFreezeLayerSettingSet(layerSettingSet);
+    }
+
+    std::vector<VlLayerSettingInfo> settings(GetWideSchemaNames().size());
+    for (auto _ : state) {
+        uint32_t setting_count = static_cast<uint32_t>(settings.size());
+        vlEnumerateLayerSettings(layerSettingSet, "wide_setting_*", &setting_count, settings.data());
+        benchmark::DoNotOptimize(setting_count);
+    }
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+BENCHMARK(BM_EnumerateLayerSettings_WideSchema)->Arg(0)->Arg(1);
+
+// Fingerprint of a live (0) or frozen (1) layer setting set, as a layer computing the key of a cache stored on disk
+static void BM_GetLayerSettingsFingerprint_WideSchema(benchmark::State &state) {
+    SetWideSchemaEnvironment();
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_wide_schema", nullptr, nullptr, nullptr, &layerSettingSet);
+    if (state.range(0) != 0) {
+        vlFreezeLayerSettingSet(layerSettingSet);
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(vlGetLayerSettingsFingerprint(layerSettingSet));
+    }
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+BENCHMARK(BM_GetLayerSettingsFingerprint_WideSchema)->Arg(0)->Arg(1);
@@ -0,0 +1,74 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <benchmark/benchmark.h>
+
+#include "vulkan/layer/vk_layer_settings.h"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Settings of a typical layer: a few scalar settings from VK_EXT_layer_settings and list settings from the environment
+struct SnapshotWorkload {
+    SnapshotWorkload() {
+        for (std::size_t i = 0; i < 32; ++i) {
+            names.push_back("api_setting_" + std::to_string(i));
+        }
+        for (std::size_t i = 0, n = names.size(); i < n; ++i) {
+            settings.push_back({"VK_LAYER_LUNARG_bench", names[i].c_str(), VK_LAYER_SETTING_TYPE_UINT32_EXT, 1, &value});
+        }
+        create_info = {VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr, static_cast<uint32_t>(settings.size()),
+                       settings.data()};
+
+#ifdef _WIN32
+        _putenv("VK_LUNARG_BENCH_ENV_LIST=1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16");
+#else
+        setenv("VK_LUNARG_BENCH_ENV_LIST", "1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16", 1);
+#endif
+    }
+
+    uint32_t value{76};
+    std::vector<std::string> names;
+    std::vector<VkLayerSettingEXT> settings;
+    VkLayerSettingsCreateInfoEXT create_info{};
+};
+
+static const SnapshotWorkload &GetSnapshotWorkload() {
+    static const SnapshotWorkload workload;
+    return workload;
+}
+
+static void QuerySettings(benchmark::State &state, VlLayerSettingSetCreateFlags flags) {
+    const SnapshotWorkload &workload = GetSnapshotWorkload();
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSetWithFlags("VK_LAYER_LUNARG_bench", &workload.create_info, nullptr, nullptr, flags, &layerSettingSet);
+
+    uint32_t list_values[16];
+    for (auto _ : state) {
+        for (const std::string &name : workload.names) {
+            uint32_t value = 0;
+            uint32_t value_count = 1;
+            vlGetLayerSettingValues(layerSettingSet, name.c_str(), VL_LAYER_SETTING_TYPE_UINT32, &value_count, &value);
+            benchmark::DoNotOptimize(value);
+        }
+
+        uint32_t list_count = 16;
+        vlGetLayerSettingValues(layerSettingSet, "env_list", VL_LAYER_SETTING_TYPE_UINT32, &list_count, list_values);
+        benchmark::DoNotOptimize(list_values);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(workload.names.size() + 1));
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+static void BM_GetLayerSettingValues_Live(benchmark::State &state) { QuerySettings(state, 0); }
+BENCHMARK(BM_GetLayerSettingValues_Live);
+
+static void BM_GetLayerSettingValues_ResolvedSnapshot(benchmark::State &state) {
+    QuerySettings(state, VL_LAYER_SETTING_SET_CREATE_RESOLVED_SNAPSHOT_BIT);
+}
+BENCHMARK(BM_GetLayerSettingValues_ResolvedSnapshot);
@@ -0,0 +1,137 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <benchmark/benchmark.h>
+
+#include "vulkan/layer/vk_layer_settings.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// One setting of each VlLayerSettingType set by each source. Each source has a layer of its own so that a source
+// with a higher priority never hides the measured one: VK_LAYER_LUNARG_bench_env, VK_LAYER_LUNARG_bench_file, ...
+enum BenchSource { BENCH_SOURCE_API, BENCH_SOURCE_FILE, BENCH_SOURCE_ENV };
+
+static const char *bench_source_names[] = {"API", "File", "Env"};
+static const char *bench_layer_names[] = {"VK_LAYER_LUNARG_bench_api", "VK_LAYER_LUNARG_bench_file", "VK_LAYER_LUNARG_bench_env"};
+
+struct BenchType {
+    VlLayerSettingType type;
+    const char *type_name;
+    const char *setting_name;
+    const char *value;  // Value of the settings file and environment variable
+};
+
+static const BenchType bench_types[] = {
+    {VL_LAYER_SETTING_TYPE_BOOL32, "BOOL32", "bool_setting", "true"},
+    {VL_LAYER_SETTING_TYPE_INT32, "INT32", "int32_setting", "-76"},
+    {VL_LAYER_SETTING_TYPE_INT64, "INT64", "int64_setting", "-82"},
+    {VL_LAYER_SETTING_TYPE_UINT32, "UINT32", "uint32_setting", "76"},
+    {VL_LAYER_SETTING_TYPE_UINT64, "UINT64", "uint64_setting", "82"},
+    {VL_LAYER_SETTING_TYPE_FLOAT32, "FLOAT32", "float32_setting", "76.5"},
+    {VL_LAYER_SETTING_TYPE_FLOAT64, "FLOAT64", "float64_setting", "82.5"},
+    {VL_LAYER_SETTING_TYPE_STRING, "STRING", "string_setting", "value"},
+    {VL_LAYER_SETTING_TYPE_FRAMESET, "FRAMESET", "frameset_setting", "76-100-10"},
+    {VL_LAYER_SETTING_TYPE_FRAMESET_STRING, "FRAMESET_STRING", "frameset_string_setting", "76-100-10"},
+};
+
+static void SetEnv(const std::string &name, const std::string &value) {
+#ifdef _WIN32
+    _putenv_s(name.c_str(), value.c_str());
+#else
+    setenv(name.c_str(), value.c_str(), 1);
+#endif
+}
+
+static void UnsetEnv(const char *name) {
+#ifdef _WIN32
+    _putenv_s(name, "");
+#else
+    unsetenv(name);
+#endif
+}
+
+// Values of the VK_EXT_layer_settings source, in the native type of each setting
+struct BenchApiSettings {
+    BenchApiSettings() {
+        const char *layer_name = bench_layer_names[BENCH_SOURCE_API];
+        settings.push_back({layer_name, "bool_setting", VK_LAYER_SETTING_TYPE_BOOL32_EXT, 1, &bool_value});
+        settings.push_back({layer_name, "int32_setting", VK_LAYER_SETTING_TYPE_INT32_EXT, 1, &int32_value});
+        settings.push_back({layer_name, "int64_setting", VK_LAYER_SETTING_TYPE_INT64_EXT, 1, &int64_value});
+        settings.push_back({layer_name, "uint32_setting", VK_LAYER_SETTING_TYPE_UINT32_EXT, 1, &uint32_value});
+        settings.push_back({layer_name, "uint64_setting", VK_LAYER_SETTING_TYPE_UINT64_EXT, 1, &uint64_value});
+        settings.push_back({layer_name, "float32_setting", VK_LAYER_SETTING_TYPE_FLOAT32_EXT, 1, &float32_value});
+        settings.push_back({layer_name, "float64_setting", VK_LAYER_SETTING_TYPE_FLOAT64_EXT, 1, &float64_value});
+        settings.push_back({layer_name, "string_setting", VK_LAYER_SETTING_TYPE_STRING_EXT, 1, &string_value});
+        settings.push_back({layer_name, "frameset_setting", VK_LAYER_SETTING_TYPE_UINT32_EXT, 3, &frameset_value});
+        settings.push_back({layer_name, "frameset_string_setting", VK_LAYER_SETTING_TYPE_STRING_EXT, 1, &frameset_string_value});
+        create_info = {VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr, static_cast<uint32_t>(settings.size()),
+                       settings.data()};
+    }
+
+    VkBool32 bool_value{VK_TRUE};
+    int32_t int32_value{-76};
+    int64_t int64_value{-82};
+    uint32_t uint32_value{76};
+    uint64_t uint64_value{82};
+    float float32_value{76.5f};
+    double float64_value{82.5};
+    const char *string_value{"value"};
+    VlFrameset frameset_value{76, 100, 10};
+    const char *frameset_string_value{"76-100-10"};
+    std::vector<VkLayerSettingEXT> settings;
+    VkLayerSettingsCreateInfoEXT create_info{};
+};
+
+static void BM_GetLayerSettingValues_Type(benchmark::State &state, BenchSource source, const BenchType &bench_type) {
+    static const BenchApiSettings api_settings;
+
+    const std::filesystem::path filename = std::filesystem::temp_directory_path() / "bench_layer_settings_types.txt";
+    std::string env_name = std::string("VK_LUNARG_BENCH_ENV_") + bench_type.setting_name;
+    for (char &c : env_name) {
+        c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+
+    if (source == BENCH_SOURCE_FILE) {
+        std::ofstream file(filename, std::ios::trunc);
+        file << "lunarg_bench_file." << bench_type.setting_name << " = " << bench_type.value << "\n";
+        SetEnv("VK_LAYER_SETTINGS_PATH", filename.string());
+    } else if (source == BENCH_SOURCE_ENV) {
+        SetEnv(env_name, bench_type.value);
+    }
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet(bench_layer_names[source], &api_settings.create_info, nullptr, nullptr, &layerSettingSet);
+
+    // Large enough for a value of any type
+    alignas(8) char values[64];
+    for (auto _ : state) {
+        uint32_t value_count = 1;
+        benchmark::DoNotOptimize(
+            vlGetLayerSettingValues(layerSettingSet, bench_type.setting_name, bench_type.type, &value_count, values));
+        benchmark::DoNotOptimize(values);
+    }
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+    UnsetEnv("VK_LAYER_SETTINGS_PATH");
+    UnsetEnv(env_name.c_str());
+}
+
+// BM_GetLayerSettingValues_Type/<source>/<type>, for each VlLayerSettingType and each source
+static const bool bench_types_registered = [] {
+    for (int source = BENCH_SOURCE_API; source <= BENCH_SOURCE_ENV; ++source) {
+        for (const BenchType &bench_type : bench_types) {
+            const std::string name =
+                std::string("BM_GetLayerSettingValues_Type/") + bench_source_names[source] + "/" + bench_type.type_name;
+            benchmark::RegisterBenchmark(name.c_str(), BM_GetLayerSettingValues_Type, static_cast<BenchSource>(source),
+                                         bench_type);
+        }
+    }
+    return true;
+}();
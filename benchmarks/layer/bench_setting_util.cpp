@@ -0,0 +1,224 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <benchmark/benchmark.h>
+
+#include "vulkan/layer/vk_layer_settings.hpp"
+#include "layer_settings_util.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <regex>
+#include <string>
+#include <vector>
+
+// Message ID filter lists, such as the message_id_filter of the validation layer
+static const std::vector<std::string> &GetMessageIds() {
+    static const std::vector<std::string> message_ids = [] {
+        std::vector<std::string> result;
+        for (uint32_t i = 0; i < 10000; ++i) {
+            char message_id[16];
+            std::snprintf(message_id, sizeof(message_id), "0x%08x", i * 2654435761u);
+            result.push_back(message_id);
+        }
+        return result;
+    }();
+    return message_ids;
+}
+
+static void BM_IsInteger_Regex(benchmark::State &state) {
+    static const std::regex integer_regex("^-?([0-9]*|0x[0-9|a-z|A-Z]*)$");
+
+    for (auto _ : state) {
+        for (const std::string &message_id : GetMessageIds()) {
+            benchmark::DoNotOptimize(std::regex_search(message_id, integer_regex));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(GetMessageIds().size()));
+}
+BENCHMARK(BM_IsInteger_Regex);
+
+static void BM_IsInteger(benchmark::State &state) {
+    for (auto _ : state) {
+        for (const std::string &message_id : GetMessageIds()) {
+            benchmark::DoNotOptimize(vl::IsInteger(message_id));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(GetMessageIds().size()));
+}
+BENCHMARK(BM_IsInteger);
+
+// Validation and conversion of a 10k entries list setting, end to end
+static void BM_GetLayerSettingValues_MessageIdList(benchmark::State &state) {
+    std::string message_id_list;
+    for (const std::string &message_id : GetMessageIds()) {
+        message_id_list += message_id + ",";
+    }
+#ifdef _WIN32
+    _putenv_s("VK_LUNARG_BENCH_UTIL_MESSAGE_ID_FILTER", message_id_list.c_str());
+#else
+    setenv("VK_LUNARG_BENCH_UTIL_MESSAGE_ID_FILTER", message_id_list.c_str(), 1);
+#endif
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_bench_util", nullptr, nullptr, nullptr, &layerSettingSet);
+
+    std::vector<uint32_t> values(GetMessageIds().size());
+    for (auto _ : state) {
+        uint32_t value_count = static_cast<uint32_t>(values.size());
+        vlGetLayerSettingValues(layerSettingSet, "message_id_filter", VL_LAYER_SETTING_TYPE_UINT32, &value_count, values.data());
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(values.size()));
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+BENCHMARK(BM_GetLayerSettingValues_MessageIdList);
+
+static void BM_Split(benchmark::State &state) {
+    std::string message_id_list;
+    for (const std::string &message_id : GetMessageIds()) {
+        message_id_list += message_id + ",";
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(vl::Split(message_id_list, ','));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(GetMessageIds().size()));
+}
+BENCHMARK(BM_Split);
+
+// Frameset lists of 'count' framesets of the three forms: "76", "76-100" and "76-100-10"
+static void BM_ToFrameSets(benchmark::State &state) {
+    const std::size_t frameset_count = static_cast<std::size_t>(state.range(0));
+
+    std::string framesets;
+    for (std::size_t i = 0; i < frameset_count; ++i) {
+        const std::string first = std::to_string(i * 100);
+        switch (i % 3) {
+            case 0:
+                framesets += first;
+                break;
+            case 1:
+                framesets += first + "-" + std::to_string(i * 100 + 50);
+                break;
+            default:
+                framesets += first + "-" + std::to_string(i * 100 + 50) + "-5";
+                break;
+        }
+        framesets += ",";
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(vl::ToFrameSets(framesets));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(frameset_count));
+}
+BENCHMARK(BM_ToFrameSets)->RangeMultiplier(10)->Range(10, 100000);
+
+// VkLayerSettingsCreateInfoEXT of 'count' settings checked against a layer knowing half of them
+static void BM_GetUnknownSettings(benchmark::State &state) {
+    const std::size_t setting_count = static_cast<std::size_t>(state.range(0));
+
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i < setting_count; ++i) {
+        names.push_back("bench_setting_" + std::to_string(i));
+    }
+
+    const uint32_t value = 76;
+    std::vector<VkLayerSettingEXT> settings;
+    std::vector<const char *> known_settings;
+    for (std::size_t i = 0; i < setting_count; ++i) {
+        settings.push_back({"VK_LAYER_LUNARG_bench", names[i].c_str(), VK_LAYER_SETTING_TYPE_UINT32_EXT, 1, &value});
+        if (i % 2 == 0) {
+            known_settings.push_back(names[i].c_str());
+        }
+    }
+
+    const VkLayerSettingsCreateInfoEXT create_info{VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr,
+                                                   static_cast<uint32_t>(settings.size()), settings.data()};
+
+    std::vector<const char *> unknown_settings(setting_count);
+    for (auto _ : state) {
+        uint32_t unknown_setting_count = static_cast<uint32_t>(unknown_settings.size());
+        vlGetUnknownSettings(&create_info, static_cast<uint32_t>(known_settings.size()), known_settings.data(),
+                             &unknown_setting_count, unknown_settings.data());
+        benchmark::DoNotOptimize(unknown_settings.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(setting_count));
+}
+BENCHMARK(BM_GetUnknownSettings)->RangeMultiplier(10)->Range(10, 10000)->Unit(benchmark::kMicrosecond);
+
+// Same check with a registry of the known settings built once
+static void BM_GetUnknownLayerSettings(benchmark::State &state) {
+    const std::size_t setting_count = static_cast<std::size_t>(state.range(0));
+
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i < setting_count; ++i) {
+        names.push_back("bench_setting_" + std::to_string(i));
+    }
+
+    const uint32_t value = 76;
+    std::vector<VkLayerSettingEXT> settings;
+    std::vector<const char *> known_settings;
+    for (std::size_t i = 0; i < setting_count; ++i) {
+        settings.push_back({"VK_LAYER_LUNARG_bench", names[i].c_str(), VK_LAYER_SETTING_TYPE_UINT32_EXT, 1, &value});
+        if (i % 2 == 0) {
+            known_settings.push_back(names[i].c_str());
+        }
+    }
+
+    const VkLayerSettingsCreateInfoEXT create_info{VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr,
+                                                   static_cast<uint32_t>(settings.size()), settings.data()};
+
+    VlKnownLayerSettings known_layer_settings = VK_NULL_HANDLE;
+    vlCreateKnownLayerSettings(static_cast<uint32_t>(known_settings.size()), known_settings.data(), nullptr, &known_layer_settings);
+
+    std::vector<const char *> unknown_settings(setting_count);
+    for (auto _ : state) {
+        uint32_t unknown_setting_count = static_cast<uint32_t>(unknown_settings.size());
+        vlGetUnknownLayerSettings(known_layer_settings, &create_info, &unknown_setting_count, unknown_settings.data());
+        benchmark::DoNotOptimize(unknown_settings.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(setting_count));
+
+    vlDestroyKnownLayerSettings(known_layer_settings, nullptr);
+}
+BENCHMARK(BM_GetUnknownLayerSettings)->RangeMultiplier(10)->Range(10, 10000)->Unit(benchmark::kMicrosecond);
+
+// Message ID filter of 'count' IDs tested for each emitted message, half of the messages are filtered
+static std::vector<uint32_t> GetFilteredMessageIds(std::size_t count) {
+    std::vector<uint32_t> message_ids;
+    for (std::size_t i = 0; i < count; ++i) {
+        message_ids.push_back(static_cast<uint32_t>(std::strtoul(GetMessageIds()[i].c_str(), nullptr, 16)));
+    }
+    return message_ids;
+}
+
+static void BM_MessageIdFilter_Vector(benchmark::State &state) {
+    const std::vector<uint32_t> filter = GetFilteredMessageIds(static_cast<std::size_t>(state.range(0)));
+
+    std::size_t message_index = 0;
+    for (auto _ : state) {
+        const uint32_t message_id = message_index % 2 == 0 ? filter[message_index % filter.size()] : static_cast<uint32_t>(message_index);
+        benchmark::DoNotOptimize(std::find(filter.begin(), filter.end(), message_id) != filter.end());
+        ++message_index;
+    }
+}
+BENCHMARK(BM_MessageIdFilter_Vector)->RangeMultiplier(10)->Range(10, 10000);
+
+static void BM_MessageIdFilter_Uint32Set(benchmark::State &state) {
+    const std::vector<uint32_t> filter = GetFilteredMessageIds(static_cast<std::size_t>(state.range(0)));
+    const VlUint32Set filter_set(static_cast<uint32_t>(filter.size()), filter.data());
+
+    std::size_t message_index = 0;
+    for (auto _ : state) {
+        const uint32_t message_id = message_index % 2 == 0 ? filter[message_index % filter.size()] : static_cast<uint32_t>(message_index);
+        benchmark::DoNotOptimize(filter_set.Contains(message_id));
+        ++message_index;
+    }
+}
+BENCHMARK(BM_MessageIdFilter_Uint32Set)->RangeMultiplier(10)->Range(10, 10000);
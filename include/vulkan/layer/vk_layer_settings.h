@@ -30,6 +30,27 @@ typedef enum VlLayerSettingType {
 
 VK_DEFINE_HANDLE(VlLayerSettingSet)
 
+typedef enum VlLayerSettingSetCreateFlagBits {
+    // Merge the environment variables, vk_layer_settings.txt and VkLayerSettingsCreateInfoEXT once at creation into a
+    // read-only snapshot. Typed values are kept after their first query so that later vlGetLayerSettingValues calls
+    // only copy them.
+    VL_LAYER_SETTING_SET_CREATE_RESOLVED_SNAPSHOT_BIT = 0x00000001,
+    // Watch vk_layer_settings.txt and reload it when it changes, see vlSetLayerSettingsChangedCallback.
+    // Only supported on Linux. vlCreateLayerSettingSetWithFlags returns VK_ERROR_INITIALIZATION_FAILED when combined with
+    // VL_LAYER_SETTING_SET_CREATE_RESOLVED_SNAPSHOT_BIT.
+    VL_LAYER_SETTING_SET_CREATE_WATCH_SETTINGS_FILE_BIT = 0x00000002,
+    // Count the lookups, the allocations and the time spent resolving settings, see vlGetLayerSettingStatistics.
+    VL_LAYER_SETTING_SET_CREATE_STATISTICS_BIT = 0x00000004,
+    // Collect the statistics and log them with the VlLayerSettingLogCallback when the layer setting set is destroyed.
+    VL_LAYER_SETTING_SET_CREATE_LOG_STATISTICS_BIT = 0x00000008,
+    // Log the messages from a background thread so that queries never wait for stderr or the VlLayerSettingLogCallback.
+    // Each message of a setting is logged once, at most 100 messages are logged per second by default, see
+    // vlSetLayerSettingLogRateLimit. vlDestroyLayerSettingSet logs the pending messages.
+    VL_LAYER_SETTING_SET_CREATE_ASYNC_LOG_BIT = 0x00000010,
+    VL_LAYER_SETTING_SET_CREATE_FLAG_BITS_MAX_ENUM = 0x7FFFFFFF
+} VlLayerSettingSetCreateFlagBits;
+typedef VkFlags VlLayerSettingSetCreateFlags;
+
 // - `first` is an integer related to the first frame to be processed.
 //    The frame numbering is 0-based.
 //  - `count` is an integer related to the number of frames to be
@@ -51,15 +72,173 @@ VkResult vlCreateLayerSettingSet(const char *pLayerName, const VkLayerSettingsCr
                              const VkAllocationCallbacks *pAllocator, VlLayerSettingLogCallback pCallback,
                                  VlLayerSettingSet *pLayerSettingSet);
 
+// Create a layer setting set with VlLayerSettingSetCreateFlagBits options.
+VkResult vlCreateLayerSettingSetWithFlags(const char *pLayerName, const VkLayerSettingsCreateInfoEXT *pCreateInfo,
+                                          const VkAllocationCallbacks *pAllocator, VlLayerSettingLogCallback pCallback,
+                                          VlLayerSettingSetCreateFlags flags, VlLayerSettingSet *pLayerSettingSet);
+
 void vlDestroyLayerSettingSet(VlLayerSettingSet layerSettingSet, const VkAllocationCallbacks *pAllocator);
 
+typedef struct VlLayerSettingSetMemoryUsage {
+    size_t allocatedBytes;      // Memory currently allocated by the layer setting set
+    size_t peakAllocatedBytes;  // Highest value of 'allocatedBytes' since the creation of the layer setting set
+} VlLayerSettingSetMemoryUsage;
+
+// Report the memory allocated by a layer setting set with the VkAllocationCallbacks given at its creation, or with
+// malloc without them. The parse of vk_layer_settings.txt shared by the layer setting sets created without
+// VkAllocationCallbacks isn't included.
+void vlGetLayerSettingSetMemoryUsage(VlLayerSettingSet layerSettingSet, VlLayerSettingSetMemoryUsage *pMemoryUsage);
+
+typedef struct VlLayerSettingStatistics {
+    uint64_t envLookupCount;                    // Lookups of a setting in the environment variables
+    uint64_t fileLookupCount;                   // Lookups of a setting in vk_layer_settings.txt
+    uint64_t apiLookupCount;                    // Lookups of a setting in VkLayerSettingsCreateInfoEXT
+    uint64_t cacheHitCount;                     // Queries answered with the values resolved by a previous query
+    uint64_t cacheMissCount;                    // Queries of resolved snapshot or frozen layer setting sets resolving values
+    uint64_t getenvCount;                       // Environment variables or Android properties read, and environment scans
+    uint64_t parseFailureCount;                 // Values which are invalid or out of range for the queried type
+    uint64_t allocatedBytes;                    // As reported by vlGetLayerSettingSetMemoryUsage
+    uint64_t peakAllocatedBytes;
+    uint64_t findSettingsFileNanoseconds;       // Time spent locating vk_layer_settings.txt
+    uint64_t parseSettingsFileNanoseconds;      // Time spent parsing or loading vk_layer_settings.txt, reloads included
+    uint64_t getLayerSettingValuesCount;        // Queries of vlGetLayerSettingValues and vlGetLayerSettingValuesBatch
+    uint64_t getLayerSettingValuesNanoseconds;  // Time spent in these queries
+} VlLayerSettingStatistics;
+
+// Read the statistics of a layer setting set created with VL_LAYER_SETTING_SET_CREATE_STATISTICS_BIT or
+// VL_LAYER_SETTING_SET_CREATE_LOG_STATISTICS_BIT, return VK_ERROR_FEATURE_NOT_PRESENT otherwise.
+VkResult vlGetLayerSettingStatistics(VlLayerSettingSet layerSettingSet, VlLayerSettingStatistics *pStatistics);
+
+// Compile the vk_layer_settings.txt settings of a layer into a binary cache stored next to the settings file, such as
+// vk_layer_settings.lunarg_test.cache for VK_LAYER_LUNARG_test. vlCreateLayerSettingSet loads the cache instead of
+// parsing the settings file while the settings file keeps the size and modification time it was compiled with.
+// Environment variables and VkLayerSettingsCreateInfoEXT still override the cached values.
+// Return VK_ERROR_INITIALIZATION_FAILED if the settings file can't be read or the cache can't be written.
+VkResult vlCompileLayerSettingsCache(const char *pLayerName);
+
+typedef void (VKAPI_PTR *VlLayerSettingsChangedCallback)(void *pUserData, uint32_t settingCount, const char *const *ppSettingNames);
+
+// Set the callback called when a reload of vk_layer_settings.txt changes settings of the layer, replacing the previous
+// callback. The callback is called on the thread watching the file with the names of the changed settings.
+// Once it returns, the layer setting set has the new values. A NULL 'pCallback' removes the callback.
+// Return VK_ERROR_FEATURE_NOT_PRESENT if the layer setting set doesn't watch the settings file.
+VkResult vlSetLayerSettingsChangedCallback(VlLayerSettingSet layerSettingSet, VlLayerSettingsChangedCallback pCallback,
+                                           void *pUserData);
+
+// Set the number of messages logged per second by a layer setting set created with
+// VL_LAYER_SETTING_SET_CREATE_ASYNC_LOG_BIT, 0 removes the limit. The number of suppressed messages is logged instead.
+// Return VK_ERROR_FEATURE_NOT_PRESENT if the layer setting set doesn't log asynchronously.
+VkResult vlSetLayerSettingLogRateLimit(VlLayerSettingSet layerSettingSet, uint32_t messagesPerSecond);
+
+// Wait until the messages logged so far by a layer setting set created with VL_LAYER_SETTING_SET_CREATE_ASYNC_LOG_BIT
+// are passed to the VlLayerSettingLogCallback or written to stderr.
+// Return VK_ERROR_FEATURE_NOT_PRESENT if the layer setting set doesn't log asynchronously.
+VkResult vlFlushLayerSettingLog(VlLayerSettingSet layerSettingSet);
+
+typedef enum VlLayerSettingsOverlayPriority {
+    // The overlay overrides the environment variables, vk_layer_settings.txt and VkLayerSettingsCreateInfoEXT
+    VL_LAYER_SETTINGS_OVERLAY_PRIORITY_HIGHEST = 0,
+    // The environment variables override the overlay, which overrides vk_layer_settings.txt and VkLayerSettingsCreateInfoEXT
+    VL_LAYER_SETTINGS_OVERLAY_PRIORITY_BELOW_ENV = 1,
+    // The environment variables and vk_layer_settings.txt override the overlay, which overrides VkLayerSettingsCreateInfoEXT
+    VL_LAYER_SETTINGS_OVERLAY_PRIORITY_BELOW_FILE = 2,
+    // The overlay only sets the settings no other source sets
+    VL_LAYER_SETTINGS_OVERLAY_PRIORITY_LOWEST = 3,
+    VL_LAYER_SETTINGS_OVERLAY_PRIORITY_MAX_ENUM = 0x7FFFFFFF
+} VlLayerSettingsOverlayPriority;
+
+// Read settings from the POSIX shared memory segment 'pSegmentName', written by other processes with
+// vlSetLayerSettingsOverlayValue while this process runs. The segment is created empty if it doesn't exist yet.
+// Each query checks whether the segment was written since the previous query and loads the new values if so. For a
+// frozen layer setting set, a background thread loads and freezes the new values while queries keep reading the
+// previous ones. Values are read as vk_layer_settings.txt values.
+// A layer setting set reads a single overlay, attached before it's queried by other threads.
+// Return VK_ERROR_FEATURE_NOT_PRESENT if POSIX shared memory isn't supported, as on Windows and Android, or for a
+// layer setting set created with VL_LAYER_SETTING_SET_CREATE_RESOLVED_SNAPSHOT_BIT.
+// Return VK_ERROR_INITIALIZATION_FAILED if the segment can't be mapped or an overlay is already attached.
+VkResult vlAttachLayerSettingsOverlay(VlLayerSettingSet layerSettingSet, const char *pSegmentName,
+                                      VlLayerSettingsOverlayPriority priority);
+
+// Set the value of a setting in the shared memory segment 'pSegmentName', created if needed. The value is written as
+// in vk_layer_settings.txt, such as "76" or "value1,value2". A NULL or empty 'pValue' removes the setting.
+// The segment holds up to 256 settings, with names of up to 127 characters including the layer prefix and values of up
+// to 383 characters. Return VK_ERROR_INITIALIZATION_FAILED if the value can't be written.
+// Writers of a segment wait up to a second for the write in progress. When the process writing exited while writing, the
+// next writer takes the segment over after that second, and the setting the exited writer was writing may be left
+// corrupted.
+VkResult vlSetLayerSettingsOverlayValue(const char *pSegmentName, const char *pLayerName, const char *pSettingName,
+                                        const char *pValue);
+
+// Remove the shared memory segment 'pSegmentName'. The layer setting sets reading it keep the last values written.
+VkResult vlRemoveLayerSettingsOverlay(const char *pSegmentName);
+
+// Resolve the values of every setting so that the layer setting set is no longer modified by queries.
+// Once frozen, vlHasLayerSetting and vlGetLayerSettingValues may be called concurrently from any thread and the
+// strings they return remain valid until the layer setting set is destroyed. Freezing again has no effect.
+// Frozen queries don't lock or allocate for the settings set by a source, named as in the source, and for the settings
+// no source sets. Other case spellings of the names of set settings, and every setting no source sets on Android where
+// system properties can't be listed, are resolved by their first query under a lock.
+VkResult vlFreezeLayerSettingSet(VlLayerSettingSet layerSettingSet);
+
 // Check whether a setting was set either programmatically, from vk_layer_settings.txt or an environment variable
 VkBool32 vlHasLayerSetting(VlLayerSettingSet layerSettingSet, const char *pSettingName);
 
-// Query setting values
+// Query setting values. Integers of environment variables and vk_layer_settings.txt are decimal or "0x" hexadecimal,
+// negative values of UINT32 and UINT64 settings wrap: "-1" is 0xFFFFFFFF. Values out of the range of the type are
+// clamped and logged.
 VkResult vlGetLayerSettingValues(VlLayerSettingSet layerSettingSet, const char *pSettingName, VlLayerSettingType type,
                                  uint32_t *pValueCount, void *pValues);
 
+// Query of vlGetLayerSettingValuesBatch
+typedef struct VlLayerSettingQuery {
+    const char *pSettingName;
+    VlLayerSettingType type;
+    uint32_t valueCount;  // Capacity of 'pValues', or the number of values when 'pValues' is NULL
+    void *pValues;
+    VkResult result;      // Result of the query, as returned by vlGetLayerSettingValues
+} VlLayerSettingQuery;
+
+// Query the values of several settings, each query behaves as a vlGetLayerSettingValues call.
+// Return VK_SUCCESS if every query succeeded, otherwise the result of the first query that didn't.
+VkResult vlGetLayerSettingValuesBatch(VlLayerSettingSet layerSettingSet, uint32_t queryCount, VlLayerSettingQuery *pQueries);
+
+// Source of the values of a setting, when several sources set it
+typedef enum VlLayerSettingSource {
+    VL_LAYER_SETTING_SOURCE_ENV = 0,      // Environment variable, or Android system property
+    VL_LAYER_SETTING_SOURCE_FILE = 1,     // vk_layer_settings.txt
+    VL_LAYER_SETTING_SOURCE_API = 2,      // VkLayerSettingsCreateInfoEXT
+    VL_LAYER_SETTING_SOURCE_OVERLAY = 3,  // Settings overlay, see vlAttachLayerSettingsOverlay
+    VL_LAYER_SETTING_SOURCE_MAX_ENUM = 0x7FFFFFFF
+} VlLayerSettingSource;
+
+typedef struct VlLayerSettingInfo {
+    const char *pSettingName;  // Valid until the layer setting set is destroyed
+    VlLayerSettingSource source;
+} VlLayerSettingInfo;
+
+// Enumerate the settings of the layer set by any source, sorted by name, with the source their values come from.
+// Settings set by environment variables are named in lower case, such as "my_setting" for VK_LUNARG_TEST_MY_SETTING,
+// and aren't enumerated on Android where system properties can't be listed. Only the variables with the layer name,
+// VK_LUNARG_TEST_ or VK_TEST_ for VK_LAYER_LUNARG_test, are enumerated, by the name of their most specific prefix:
+// VK_LUNARG_TEST_MY_SETTING is enumerated as "my_setting" only. VK_MY_SETTING is read when "my_setting" is queried, but
+// the VK_ variables can't be told apart from the ones of the loader, such as VK_LOADER_DEBUG.
+// Only settings which names start with 'pPrefix' are enumerated, a trailing '*' is ignored: "message_*" enumerates
+// "message_id" and "message_severity". A NULL or empty 'pPrefix' enumerates every setting.
+// With a NULL 'pSettings', 'pSettingCount' returns the number of settings, otherwise it's the capacity of 'pSettings'
+// and returns the number of settings written. Return VK_INCOMPLETE if 'pSettings' is too small.
+VkResult vlEnumerateLayerSettings(VlLayerSettingSet layerSettingSet, const char *pPrefix, uint32_t *pSettingCount,
+                                  VlLayerSettingInfo *pSettings);
+
+// Return a 64-bit hash of every setting the queries find and their values, to key data derived from the settings, such
+// as caches stored on disk. Besides the settings enumerated by vlEnumerateLayerSettings, the VK_ environment variables
+// are hashed as settings: the loader variables, such as VK_LOADER_DEBUG, change the fingerprint too. The values are
+// hashed as spelled in vk_layer_settings.txt and environment variables, so that different spellings such as "7" and
+// "07" give different fingerprints. VK_EXT_layer_settings values are hashed as their usual spelling: VK_TRUE as "true",
+// 76 as "76" and 1.0f as "1.0", with the decimals which tell floats apart. The fingerprint is the same in every process
+// with the same settings. A frozen layer setting set computes it when frozen, otherwise it's computed by the first call
+// after the settings file, the overlay or test_helper_SetLayerSetting change a value.
+uint64_t vlGetLayerSettingsFingerprint(VlLayerSettingSet layerSettingSet);
+
 // Find the VkLayerSettingsCreateInfoEXT in the VkInstanceCreateInfo pNext chain, return NULL if not present
 const VkLayerSettingsCreateInfoEXT *vlFindLayerSettingsCreateInfo(const VkInstanceCreateInfo *pCreateInfo);
 
@@ -67,6 +246,20 @@ const VkLayerSettingsCreateInfoEXT *vlFindLayerSettingsCreateInfo(const VkInstan
 VkResult vlGetUnknownSettings(const VkLayerSettingsCreateInfoEXT *pCreateInfo, uint32_t settingsCount, const char **pSettings,
                               uint32_t *pUnknownSettingCount, const char **pUnknownSettings);
 
+VK_DEFINE_HANDLE(VlKnownLayerSettings)
+
+// Create the registry of the settings known by a layer, built once so that checking the settings of
+// VkLayerSettingsCreateInfoEXT is one hash lookup per setting. Setting names are case sensitive.
+// Return VK_ERROR_INITIALIZATION_FAILED if a setting name is listed twice.
+VkResult vlCreateKnownLayerSettings(uint32_t settingsCount, const char *const *pSettings, const VkAllocationCallbacks *pAllocator,
+                                    VlKnownLayerSettings *pKnownLayerSettings);
+
+void vlDestroyKnownLayerSettings(VlKnownLayerSettings knownLayerSettings, const VkAllocationCallbacks *pAllocator);
+
+// Return the list of settings of VkLayerSettingsCreateInfoEXT which aren't in the registry, as vlGetUnknownSettings
+VkResult vlGetUnknownLayerSettings(VlKnownLayerSettings knownLayerSettings, const VkLayerSettingsCreateInfoEXT *pCreateInfo,
+                                   uint32_t *pUnknownSettingCount, const char **pUnknownSettings);
+
 #ifdef __cplusplus
 }
 #endif
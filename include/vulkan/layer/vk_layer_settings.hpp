@@ -10,8 +10,14 @@
 #pragma once
 
 #include "vk_layer_settings.h"
+#include <atomic>
+#include <cstddef>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <type_traits>
 
 void vlGetLayerSettingValue(VlLayerSettingSet layerSettingSet,
     const char *pSettingName, bool &settingValue);
@@ -61,12 +67,90 @@ void vlGetLayerSettingValue(VlLayerSettingSet layerSettingSet,
 void vlGetLayerSettingValues(VlLayerSettingSet layerSettingSet,
     const char *pSettingName, std::vector<std::string> &settingValues);
 
+// Views of the strings owned by the layer setting set, valid until it's destroyed. Repeated queries return views of the
+// same strings without copying them.
+void vlGetLayerSettingValues(VlLayerSettingSet layerSettingSet,
+    const char *pSettingName, std::vector<std::string_view> &settingValues);
+
 void vlGetLayerSettingValue(VlLayerSettingSet layerSettingSet,
     const char *pSettingName, VlFrameset &settingValue);
 
 void vlGetLayerSettingValues(VlLayerSettingSet layerSettingSet,
     const char *pSettingName, std::vector<VlFrameset> &settingValues);
 
+// Frames selected by a list of VlFrameset, compiled so that the per frame queries of capture and screenshot layers don't
+// iterate the framesets. A frameset selects 'count' frames from 'first' every 'step' frames, every 'step' frames from
+// 'first' when 'count' is 0, and no frame when 'step' is 0. Queries don't allocate and may run concurrently, they are
+// constant time when the frames are queried in increasing order.
+class VlFrameSchedule {
+  public:
+    static constexpr uint64_t NO_FRAME = ~0ull;
+
+    VlFrameSchedule() = default;
+    VlFrameSchedule(uint32_t framesetCount, const VlFrameset *pFramesets);
+    explicit VlFrameSchedule(const std::vector<VlFrameset> &framesets);
+
+    VlFrameSchedule(const VlFrameSchedule &other);
+    VlFrameSchedule &operator=(const VlFrameSchedule &other);
+
+    bool IsSelected(uint64_t frame) const;
+
+    // Return the first selected frame from 'frame', or NO_FRAME if no later frame is selected
+    uint64_t NextSelected(uint64_t frame) const;
+
+  private:
+    // Frames from 'begin' to the begin of the next segment share the same selected frames modulo 'period'.
+    // Selected frames are set in a bit mask of 'period' bits when it's short enough, otherwise they are 'count'
+    // progressions of 'progressions'.
+    struct Segment {
+        uint64_t begin;
+        uint64_t period;  // 0 when no frame is selected
+        std::size_t offset;
+        std::size_t count;
+    };
+
+    struct Progression {
+        uint64_t step;
+        uint64_t residue;  // Selected frames are the frames which modulo 'step' is 'residue'
+    };
+
+    std::size_t FindSegment(uint64_t frame) const;
+    uint64_t NextSelectedInSegment(const Segment &segment, uint64_t frame) const;
+
+    std::vector<Segment> segments;
+    std::vector<uint64_t> masks;
+    std::vector<Progression> progressions;
+    mutable std::atomic<std::size_t> segment_hint{0};  // Segment of the last query
+};
+
+// Immutable set of uint32_t, for list settings such as message ID filters tested for every message emitted. Values
+// are listed as integers or as inclusive ranges such as "100-200" or "0x10-0x1f". Dense values are stored in a bitmap,
+// sparse values as sorted ranges. Lookups don't allocate and may run concurrently.
+class VlUint32Set {
+  public:
+    VlUint32Set() = default;
+    VlUint32Set(uint32_t valueCount, const uint32_t *pValues);
+
+    // Inclusive ranges of values, which may overlap
+    explicit VlUint32Set(std::vector<std::pair<uint32_t, uint32_t>> ranges);
+
+    bool Contains(uint32_t value) const;
+
+    bool Empty() const { return this->bitmap.empty() && this->range_firsts.empty(); }
+
+  private:
+    std::vector<uint64_t> bitmap;  // Bit 'value - bitmap_begin' is set for each value of a dense set
+    uint32_t bitmap_begin{0};
+    uint64_t bitmap_size{0};
+    std::vector<uint32_t> range_firsts;  // Sorted disjoint ranges of a sparse set
+    std::vector<uint32_t> range_lasts;
+};
+
+// Read a list setting of integers and ranges, return VK_ERROR_FORMAT_NOT_SUPPORTED if a value is neither. The valid
+// values are still added to 'settingValues'.
+VkResult vlGetLayerSettingValues(VlLayerSettingSet layerSettingSet,
+    const char *pSettingName, VlUint32Set &settingValues);
+
 // Required by vk_safe_struct
 typedef std::pair<uint32_t, uint32_t> VlCustomSTypeInfo;
 
@@ -74,6 +158,198 @@ void vlGetLayerSettingValues(VlLayerSettingSet layerSettingSet,
     const char *pSettingName,
     std::vector<VlCustomSTypeInfo> &settingValues);
 
+VkResult vlEnumerateLayerSettings(VlLayerSettingSet layerSettingSet, const char *pPrefix, std::vector<VlLayerSettingInfo> &settings);
+
 // Return the list of Unknown setting in VkLayerSettingsCreateInfoEXT
 VkResult vlGetUnknownSettings(const VkLayerSettingsCreateInfoEXT *pCreateInfo, uint32_t settingsCount, const char **pSettings,
                               std::vector<const char *>& unknownSettings);
+
+VkResult vlGetUnknownLayerSettings(VlKnownLayerSettings knownLayerSettings, const VkLayerSettingsCreateInfoEXT *pCreateInfo,
+                                   std::vector<const char *> &unknownSettings);
+
+// Case insensitive hash of a setting name, the one used by the layer setting set to index the settings
+constexpr uint64_t vlHashLayerSettingName(const char *pSettingName) {
+    uint64_t hash = 14695981039346656037ull;
+    for (const char *c = pSettingName; *c != '\0'; ++c) {
+        const char lower_c = (*c >= 'A' && *c <= 'Z') ? static_cast<char>(*c - 'A' + 'a') : *c;
+        hash ^= static_cast<uint8_t>(lower_c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Setting of a layer settings schema, declared with VL_LAYER_SETTING
+template <typename T, uint64_t SettingNameHash>
+struct VlLayerSetting {
+    static constexpr uint64_t settingNameHash = SettingNameHash;
+
+    const char *pSettingName;
+    T value;
+};
+
+// Declare a setting of a layer settings schema: the member is named after the setting and the name is hashed at compile
+// time. For example: VL_LAYER_SETTING(std::vector<uint32_t>, duplicate_message_limit, {10, 20});
+#define VL_LAYER_SETTING(type, name, ...) VlLayerSetting<type, vlHashLayerSettingName(#name)> name{#name, __VA_ARGS__}
+
+// Type erased setting of a layer settings schema
+struct VlLayerSettingField {
+    const char *pSettingName;
+    uint64_t settingNameHash;
+    VlLayerSettingType type;
+    void *pStorage;
+    void (*pAssign)(void *pStorage, uint32_t valueCount, const void *pValues);
+};
+
+// Fill the fields of a layer settings schema, each setting is parsed once.
+// Fields of settings that are not set, or whose values are invalid, keep their default values.
+void vlGetLayerSettingFields(VlLayerSettingSet layerSettingSet, uint32_t fieldCount, const VlLayerSettingField *pFields);
+
+// VlLayerSettingType of the values of each C++ type of a settings schema and conversion from these values
+template <typename T>
+struct VlLayerSettingTraits;
+
+template <typename T, VlLayerSettingType Type>
+struct VlLayerSettingNumericTraits {
+    static constexpr VlLayerSettingType type = Type;
+    static void Assign(T &value, uint32_t valueCount, const T *pValues) {
+        (void)valueCount;
+        value = pValues[0];
+    }
+};
+
+template <>
+struct VlLayerSettingTraits<int32_t> : VlLayerSettingNumericTraits<int32_t, VL_LAYER_SETTING_TYPE_INT32> {};
+template <>
+struct VlLayerSettingTraits<int64_t> : VlLayerSettingNumericTraits<int64_t, VL_LAYER_SETTING_TYPE_INT64> {};
+template <>
+struct VlLayerSettingTraits<uint32_t> : VlLayerSettingNumericTraits<uint32_t, VL_LAYER_SETTING_TYPE_UINT32> {};
+template <>
+struct VlLayerSettingTraits<uint64_t> : VlLayerSettingNumericTraits<uint64_t, VL_LAYER_SETTING_TYPE_UINT64> {};
+template <>
+struct VlLayerSettingTraits<float> : VlLayerSettingNumericTraits<float, VL_LAYER_SETTING_TYPE_FLOAT32> {};
+template <>
+struct VlLayerSettingTraits<double> : VlLayerSettingNumericTraits<double, VL_LAYER_SETTING_TYPE_FLOAT64> {};
+template <>
+struct VlLayerSettingTraits<VlFrameset> : VlLayerSettingNumericTraits<VlFrameset, VL_LAYER_SETTING_TYPE_FRAMESET> {};
+
+template <>
+struct VlLayerSettingTraits<bool> {
+    static constexpr VlLayerSettingType type = VL_LAYER_SETTING_TYPE_BOOL32;
+    static void Assign(bool &value, uint32_t valueCount, const VkBool32 *pValues) {
+        (void)valueCount;
+        value = pValues[0] == VK_TRUE;
+    }
+};
+
+// Like vlGetLayerSettingValue, a string setting gets every value separated by commas
+template <>
+struct VlLayerSettingTraits<std::string> {
+    static constexpr VlLayerSettingType type = VL_LAYER_SETTING_TYPE_STRING;
+    static void Assign(std::string &value, uint32_t valueCount, const char *const *pValues) {
+        value.clear();
+        for (uint32_t i = 0; i < valueCount; ++i) {
+            if (i > 0) {
+                value += ",";
+            }
+            value += pValues[i];
+        }
+    }
+};
+
+template <typename T>
+struct VlLayerSettingTraits<std::vector<T>> {
+    static constexpr VlLayerSettingType type = VlLayerSettingTraits<T>::type;
+    template <typename V>
+    static void Assign(std::vector<T> &values, uint32_t valueCount, const V *pValues) {
+        values.resize(valueCount);
+        for (uint32_t i = 0; i < valueCount; ++i) {
+            T value{};
+            VlLayerSettingTraits<T>::Assign(value, 1, &pValues[i]);
+            values[i] = value;
+        }
+    }
+};
+
+template <>
+struct VlLayerSettingTraits<std::vector<std::string>> {
+    static constexpr VlLayerSettingType type = VL_LAYER_SETTING_TYPE_STRING;
+    static void Assign(std::vector<std::string> &values, uint32_t valueCount, const char *const *pValues) {
+        values.assign(pValues, pValues + valueCount);
+    }
+};
+
+// Type of the values passed to VlLayerSettingTraits<T>::Assign
+template <VlLayerSettingType Type>
+struct VlLayerSettingValueType;
+template <>
+struct VlLayerSettingValueType<VL_LAYER_SETTING_TYPE_BOOL32> { using type = VkBool32; };
+template <>
+struct VlLayerSettingValueType<VL_LAYER_SETTING_TYPE_INT32> { using type = int32_t; };
+template <>
+struct VlLayerSettingValueType<VL_LAYER_SETTING_TYPE_INT64> { using type = int64_t; };
+template <>
+struct VlLayerSettingValueType<VL_LAYER_SETTING_TYPE_UINT32> { using type = uint32_t; };
+template <>
+struct VlLayerSettingValueType<VL_LAYER_SETTING_TYPE_UINT64> { using type = uint64_t; };
+template <>
+struct VlLayerSettingValueType<VL_LAYER_SETTING_TYPE_FLOAT32> { using type = float; };
+template <>
+struct VlLayerSettingValueType<VL_LAYER_SETTING_TYPE_FLOAT64> { using type = double; };
+template <>
+struct VlLayerSettingValueType<VL_LAYER_SETTING_TYPE_FRAMESET> { using type = VlFrameset; };
+template <>
+struct VlLayerSettingValueType<VL_LAYER_SETTING_TYPE_STRING> { using type = const char *; };
+
+template <typename T, uint64_t SettingNameHash>
+VlLayerSettingField vlMakeLayerSettingField(VlLayerSetting<T, SettingNameHash> &setting) {
+    using Traits = VlLayerSettingTraits<T>;
+    using ValueType = typename VlLayerSettingValueType<Traits::type>::type;
+
+    VlLayerSettingField field{};
+    field.pSettingName = setting.pSettingName;
+    field.settingNameHash = SettingNameHash;
+    field.type = Traits::type;
+    field.pStorage = &setting.value;
+    field.pAssign = [](void *pStorage, uint32_t valueCount, const void *pValues) {
+        Traits::Assign(*static_cast<T *>(pStorage), valueCount, static_cast<const ValueType *>(pValues));
+    };
+    return field;
+}
+
+template <std::size_t Count>
+constexpr bool vlHasUniqueLayerSettingNames(const uint64_t (&settingNameHashes)[Count]) {
+    for (std::size_t i = 0; i < Count; ++i) {
+        for (std::size_t j = i + 1; j < Count; ++j) {
+            if (settingNameHashes[i] == settingNameHashes[j]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Fill a layer settings schema: a struct of VL_LAYER_SETTING members with a GetLayerSettings() method returning
+// std::tie of the members. For example:
+//
+// struct MyLayerSettings {
+//     VL_LAYER_SETTING(bool, validate_sync, false);
+//     VL_LAYER_SETTING(std::vector<std::string>, message_id_filter, {});
+//
+//     auto GetLayerSettings() { return std::tie(validate_sync, message_id_filter); }
+// };
+//
+// Settings are filled in one pass, settings declared twice are a build error.
+template <typename Settings>
+void vlGetLayerSettings(VlLayerSettingSet layerSettingSet, Settings &settings) {
+    std::apply(
+        [&](auto &...setting) {
+            static_assert(sizeof...(setting) > 0, "A layer settings schema needs at least one setting");
+
+            constexpr uint64_t setting_name_hashes[] = {std::decay_t<decltype(setting)>::settingNameHash...};
+            static_assert(vlHasUniqueLayerSettingNames(setting_name_hashes), "A setting is declared twice in the layer settings schema");
+
+            const VlLayerSettingField fields[] = {vlMakeLayerSettingField(setting)...};
+            vlGetLayerSettingFields(layerSettingSet, static_cast<uint32_t>(sizeof...(setting)), fields);
+        },
+        settings.GetLayerSettings());
+}
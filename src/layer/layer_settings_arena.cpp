@@ -0,0 +1,142 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "layer_settings_arena.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstddef>
+
+namespace vl {
+
+Arena::Arena(const VkAllocationCallbacks *pAllocator) : has_allocator(pAllocator != nullptr) {
+    if (pAllocator != nullptr) {
+        this->allocator = *pAllocator;
+    }
+}
+
+Arena::~Arena() {
+    while (this->blocks != nullptr) {
+        Block *next = this->blocks->next;
+        this->FreeBlock(this->blocks);
+        this->blocks = next;
+    }
+}
+
+void *Arena::AllocateSystem(const VkAllocationCallbacks *pAllocator, std::size_t size) {
+    if (pAllocator == nullptr) {
+        return std::malloc(size);
+    }
+    return pAllocator->pfnAllocation(pAllocator->pUserData, size, alignof(std::max_align_t), VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+}
+
+void Arena::FreeSystem(const VkAllocationCallbacks *pAllocator, void *pointer) {
+    if (pAllocator == nullptr) {
+        std::free(pointer);
+    } else {
+        pAllocator->pfnFree(pAllocator->pUserData, pointer);
+    }
+}
+
+Arena::Block *Arena::AllocateBlock(std::size_t size) {
+    const std::size_t block_size = offsetof(Block, alignment) + size;
+
+    Block *block = static_cast<Block *>(AllocateSystem(this->has_allocator ? &this->allocator : nullptr, block_size));
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    block->previous = nullptr;
+    block->next = this->blocks;
+    block->size = block_size;
+    if (this->blocks != nullptr) {
+        this->blocks->previous = block;
+    }
+    this->blocks = block;
+
+    this->allocated_bytes += block_size;
+    this->peak_allocated_bytes = std::max(this->peak_allocated_bytes, this->allocated_bytes);
+
+    return block;
+}
+
+void Arena::FreeBlock(Block *block) {
+    this->allocated_bytes -= block->size;
+    FreeSystem(this->has_allocator ? &this->allocator : nullptr, block);
+}
+
+static std::size_t GetSizeClass(std::size_t size) {
+    std::size_t size_class = 0;
+    while ((std::size_t(1) << size_class) < size) {
+        ++size_class;
+    }
+    return size_class;
+}
+
+void *Arena::Allocate(std::size_t size) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    const std::size_t size_class = std::max(GetSizeClass(size), MIN_SIZE_CLASS);
+    if (size_class > MAX_SIZE_CLASS) {
+        return this->AllocateBlock(size)->alignment;
+    }
+
+    void *&free_list = this->free_lists[size_class];
+    if (free_list != nullptr) {
+        void *memory = free_list;
+        free_list = *static_cast<void **>(memory);
+        return memory;
+    }
+
+    const std::size_t class_size = std::size_t(1) << size_class;
+    if (static_cast<std::size_t>(this->block_end - this->block_cursor) < class_size) {
+        Block *block = this->AllocateBlock(BLOCK_SIZE);
+        this->block_cursor = reinterpret_cast<char *>(block->alignment);
+        this->block_end = this->block_cursor + BLOCK_SIZE;
+    }
+
+    void *memory = this->block_cursor;
+    this->block_cursor += class_size;
+    return memory;
+}
+
+void Arena::Deallocate(void *pointer, std::size_t size) {
+    if (pointer == nullptr) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    const std::size_t size_class = std::max(GetSizeClass(size), MIN_SIZE_CLASS);
+    if (size_class > MAX_SIZE_CLASS) {
+        Block *block = reinterpret_cast<Block *>(static_cast<char *>(pointer) - offsetof(Block, alignment));
+        if (block->previous != nullptr) {
+            block->previous->next = block->next;
+        } else {
+            this->blocks = block->next;
+        }
+        if (block->next != nullptr) {
+            block->next->previous = block->previous;
+        }
+        this->FreeBlock(block);
+        return;
+    }
+
+    // Freed memory links the free list of its size class
+    *static_cast<void **>(pointer) = this->free_lists[size_class];
+    this->free_lists[size_class] = pointer;
+}
+
+std::size_t Arena::GetAllocatedBytes() const {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->allocated_bytes;
+}
+
+std::size_t Arena::GetPeakAllocatedBytes() const {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->peak_allocated_bytes;
+}
+
+}  // namespace vl
@@ -0,0 +1,180 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace vl {
+    // Memory of a layer setting set. Blocks are allocated with the VkAllocationCallbacks of the layer setting set, or
+    // malloc without them, and are all released at once when the arena is destroyed. Small allocations are carved in
+    // blocks and recycled by size class, large ones get a block of their own released when deallocated. Thread-safe.
+    class Arena {
+      public:
+        explicit Arena(const VkAllocationCallbacks *pAllocator);
+        ~Arena();
+
+        Arena(const Arena &) = delete;
+        Arena &operator=(const Arena &) = delete;
+
+        // Memory aligned for any fundamental type, throw std::bad_alloc when the allocation callback fails
+        void *Allocate(std::size_t size);
+        void Deallocate(void *pointer, std::size_t size);
+
+        template <typename T, typename... Args>
+        T *New(Args &&...args) {
+            static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types are not supported");
+            void *memory = this->Allocate(sizeof(T));
+            return ::new (memory) T(std::forward<Args>(args)...);
+        }
+
+        template <typename T>
+        void Delete(T *object) {
+            if (object != nullptr) {
+                object->~T();
+                this->Deallocate(object, sizeof(T));
+            }
+        }
+
+        // Return the allocation callbacks of the arena copied in 'allocator', or nullptr when the arena uses malloc
+        const VkAllocationCallbacks *GetAllocationCallbacks(VkAllocationCallbacks &allocator) const {
+            allocator = this->allocator;
+            return this->has_allocator ? &allocator : nullptr;
+        }
+
+        // Memory currently allocated from the allocation callbacks, and its highest value
+        std::size_t GetAllocatedBytes() const;
+        std::size_t GetPeakAllocatedBytes() const;
+
+        // Allocate and free with the allocation callbacks of the arena, for objects outside the arena
+        static void *AllocateSystem(const VkAllocationCallbacks *pAllocator, std::size_t size);
+        static void FreeSystem(const VkAllocationCallbacks *pAllocator, void *pointer);
+
+      private:
+        static constexpr std::size_t MIN_SIZE_CLASS = 4;   // 16 bytes
+        static constexpr std::size_t MAX_SIZE_CLASS = 12;  // 4 KB, larger allocations get a block of their own
+        static constexpr std::size_t BLOCK_SIZE = 64 * 1024;
+
+        struct Block {
+            Block *previous;
+            Block *next;
+            std::size_t size;
+            std::max_align_t alignment[1];  // Start of the memory of the block
+        };
+
+        Block *AllocateBlock(std::size_t size);
+        void FreeBlock(Block *block);
+
+        bool has_allocator{false};
+        VkAllocationCallbacks allocator{};
+
+        mutable std::mutex mutex;
+        Block *blocks{nullptr};
+        char *block_cursor{nullptr};  // Unused memory of the last block of small allocations
+        char *block_end{nullptr};
+        std::array<void *, MAX_SIZE_CLASS + 1> free_lists{};
+        std::size_t allocated_bytes{0};
+        std::size_t peak_allocated_bytes{0};
+    };
+
+    // Standard allocator allocating from an Arena, or from the global heap without an arena. Containers using it pass
+    // the arena to the elements they construct, so that strings stored in a vector share the arena of the vector.
+    template <typename T>
+    class ArenaAllocator {
+      public:
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        ArenaAllocator() = default;
+        explicit ArenaAllocator(Arena *arena) : arena(arena) {}
+
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U> &other) : arena(other.GetArena()) {}
+
+        T *allocate(std::size_t count) {
+            static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types are not supported");
+            if (this->arena == nullptr) {
+                return static_cast<T *>(::operator new(count * sizeof(T)));
+            }
+            return static_cast<T *>(this->arena->Allocate(count * sizeof(T)));
+        }
+
+        void deallocate(T *pointer, std::size_t count) {
+            if (this->arena == nullptr) {
+                ::operator delete(pointer);
+            } else {
+                this->arena->Deallocate(pointer, count * sizeof(T));
+            }
+        }
+
+        template <typename U, typename... Args>
+        void construct(U *pointer, Args &&...args) {
+            if constexpr (std::uses_allocator<U, ArenaAllocator>::value &&
+                          std::is_constructible<U, Args..., const ArenaAllocator &>::value) {
+                ::new (static_cast<void *>(pointer)) U(std::forward<Args>(args)..., *this);
+            } else {
+                ::new (static_cast<void *>(pointer)) U(std::forward<Args>(args)...);
+            }
+        }
+
+        Arena *GetArena() const { return this->arena; }
+
+      private:
+        Arena *arena{nullptr};
+    };
+
+    template <typename T, typename U>
+    bool operator==(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) {
+        return a.GetArena() == b.GetArena();
+    }
+
+    template <typename T, typename U>
+    bool operator!=(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) {
+        return a.GetArena() != b.GetArena();
+    }
+
+    using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+
+    template <typename T>
+    using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+    // Orders strings of any allocator, and allows lookups by std::string_view
+    struct ArenaStringLess {
+        using is_transparent = void;
+
+        bool operator()(std::string_view a, std::string_view b) const { return a < b; }
+    };
+
+    // Owner of an object created with Arena::New
+    struct ArenaDeleter {
+        Arena *arena{nullptr};
+
+        template <typename T>
+        void operator()(T *object) const {
+            this->arena->Delete(object);
+        }
+    };
+
+    template <typename T>
+    using ArenaPtr = std::unique_ptr<T, ArenaDeleter>;
+
+    template <typename T, typename... Args>
+    ArenaPtr<T> MakeArenaPtr(Arena &arena, Args &&...args) {
+        return ArenaPtr<T>(arena.New<T>(std::forward<Args>(args)...), ArenaDeleter{&arena});
+    }
+}  // namespace vl
@@ -0,0 +1,158 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "layer_settings_cache.hpp"
+#include "layer_settings_util.hpp"
+
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace vl {
+
+static int GetPid() {
+#if defined(_WIN32)
+    return _getpid();
+#else
+    return static_cast<int>(getpid());
+#endif
+}
+
+// Size and modification time identifying a version of the settings file
+static bool GetFileVersion(const std::filesystem::path &filename, uint64_t &size, int64_t &time) {
+    std::error_code error;
+    size = static_cast<uint64_t>(std::filesystem::file_size(filename, error));
+    if (error) {
+        return false;
+    }
+
+    time = static_cast<int64_t>(std::filesystem::last_write_time(filename, error).time_since_epoch().count());
+    return !error;
+}
+
+std::filesystem::path GetSettingsCachePath(const std::filesystem::path &settings_filename, std::string_view prefix) {
+    std::filesystem::path cache_filename = settings_filename;
+    cache_filename.replace_extension();
+    cache_filename += ".";
+    cache_filename += std::string(prefix);
+    cache_filename += "cache";
+    return cache_filename;
+}
+
+bool WriteSettingsCache(const std::filesystem::path &cache_filename, const std::filesystem::path &settings_filename,
+                        const SettingsFile &settings_file, std::string_view prefix) {
+    SettingsCacheHeader header{};
+    header.magic = SETTINGS_CACHE_MAGIC;
+    header.version = SETTINGS_CACHE_VERSION;
+    header.prefix_hash = HashSettingName(prefix);
+    if (!GetFileVersion(settings_filename, header.settings_file_size, header.settings_file_time)) {
+        return false;
+    }
+
+    std::vector<SettingsCacheEntry> entries;
+    std::string strings;
+    for (const SettingsFile::Entry &entry : settings_file.GetEntries()) {
+        if (entry.key.compare(0, prefix.size(), prefix) != 0) {
+            continue;
+        }
+
+        SettingsCacheEntry cache_entry{};
+        cache_entry.key_hash = HashSettingName(entry.key);
+        cache_entry.key_offset = static_cast<uint32_t>(strings.size());
+        cache_entry.key_size = static_cast<uint32_t>(entry.key.size());
+        strings.append(entry.key);
+        cache_entry.value_offset = static_cast<uint32_t>(strings.size());
+        cache_entry.value_size = static_cast<uint32_t>(entry.value.size());
+        strings.append(entry.value);
+        entries.push_back(cache_entry);
+    }
+
+    header.entry_count = static_cast<uint32_t>(entries.size());
+    header.strings_size = static_cast<uint32_t>(strings.size());
+
+    std::string content(reinterpret_cast<const char *>(entries.data()), entries.size() * sizeof(SettingsCacheEntry));
+    content.append(strings);
+    header.content_hash = HashString(content);
+
+    std::filesystem::path temporary_filename = cache_filename;
+    temporary_filename += ".tmp" + std::to_string(GetPid());
+    {
+        std::ofstream stream(temporary_filename, std::ios::binary | std::ios::trunc);
+        stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        stream.write(content.data(), static_cast<std::streamsize>(content.size()));
+        if (!stream.good()) {
+            stream.close();
+            std::error_code error;
+            std::filesystem::remove(temporary_filename, error);
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary_filename, cache_filename, error);
+    if (error) {
+        std::filesystem::remove(temporary_filename, error);
+        return false;
+    }
+
+    return true;
+}
+
+std::shared_ptr<const SettingsFile> LoadSettingsCache(const std::filesystem::path &cache_filename,
+                                                      const std::filesystem::path &settings_filename, std::string_view prefix,
+                                                      Arena *arena) {
+    std::string data;
+    if (!ReadFile(cache_filename, data) || data.size() < sizeof(SettingsCacheHeader)) {
+        return nullptr;
+    }
+
+    // The string data isn't aligned for the records, so they are copied before being read
+    SettingsCacheHeader header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (header.magic != SETTINGS_CACHE_MAGIC || header.version != SETTINGS_CACHE_VERSION ||
+        header.prefix_hash != HashSettingName(prefix)) {
+        return nullptr;
+    }
+
+    const std::string_view content = std::string_view(data).substr(sizeof(header));
+    const std::size_t entries_size = static_cast<std::size_t>(header.entry_count) * sizeof(SettingsCacheEntry);
+    if (content.size() != entries_size + header.strings_size || HashString(content) != header.content_hash) {
+        return nullptr;
+    }
+
+    uint64_t settings_file_size = 0;
+    int64_t settings_file_time = 0;
+    if (!GetFileVersion(settings_filename, settings_file_size, settings_file_time) ||
+        settings_file_size != header.settings_file_size || settings_file_time != header.settings_file_time) {
+        return nullptr;
+    }
+
+    std::shared_ptr<SettingsFile> settings_file = std::allocate_shared<SettingsFile>(ArenaAllocator<SettingsFile>(arena), arena);
+    const std::string_view strings = settings_file->SetContent(content.substr(entries_size), header.entry_count);
+
+    for (std::size_t i = 0, n = header.entry_count; i < n; ++i) {
+        SettingsCacheEntry entry;
+        std::memcpy(&entry, content.data() + i * sizeof(SettingsCacheEntry), sizeof(entry));
+        if (static_cast<uint64_t>(entry.key_offset) + entry.key_size > strings.size() ||
+            static_cast<uint64_t>(entry.value_offset) + entry.value_size > strings.size()) {
+            return nullptr;
+        }
+
+        settings_file->AddEntry(entry.key_hash, strings.substr(entry.key_offset, entry.key_size),
+                                strings.substr(entry.value_offset, entry.value_size));
+    }
+
+    return settings_file;
+}
+
+}  // namespace vl
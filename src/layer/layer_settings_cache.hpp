@@ -0,0 +1,56 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "layer_settings_arena.hpp"
+#include "layer_settings_file.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+
+namespace vl {
+    // Precompiled vk_layer_settings.txt settings of one layer. The file is made of a SettingsCacheHeader, 'entry_count'
+    // SettingsCacheEntry and the keys and values, so that it's loaded with a single copy and no tokenizing nor hashing.
+    // It's written with the byte order of the machine and is only valid while the settings file keeps its size and
+    // modification time.
+    constexpr uint32_t SETTINGS_CACHE_MAGIC = 0x43534c56;  // "VLSC"
+    constexpr uint32_t SETTINGS_CACHE_VERSION = 1;
+
+    struct SettingsCacheHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t prefix_hash;         // HashSettingName of the file setting prefix of the layer, "lunarg_test."
+        uint64_t settings_file_size;
+        int64_t settings_file_time;   // Modification time of the settings file in file clock ticks
+        uint64_t content_hash;        // FNV-1a of everything following the header
+        uint32_t entry_count;
+        uint32_t strings_size;
+    };
+
+    struct SettingsCacheEntry {
+        uint64_t key_hash;  // HashSettingName of the key
+        uint32_t key_offset;
+        uint32_t key_size;
+        uint32_t value_offset;
+        uint32_t value_size;
+    };
+
+    // "vk_layer_settings.lunarg_test.cache" next to "vk_layer_settings.txt" for the "lunarg_test." prefix
+    std::filesystem::path GetSettingsCachePath(const std::filesystem::path &settings_filename, std::string_view prefix);
+
+    // Write the settings of 'settings_file' starting with 'prefix', parsed from 'settings_filename'. The cache is
+    // written to a temporary file renamed once complete, so that concurrent processes never load a partial cache.
+    bool WriteSettingsCache(const std::filesystem::path &cache_filename, const std::filesystem::path &settings_filename,
+                            const SettingsFile &settings_file, std::string_view prefix);
+
+    // Load the settings written by WriteSettingsCache in 'arena', return nullptr if the cache is missing, corrupted or
+    // older than 'settings_filename'
+    std::shared_ptr<const SettingsFile> LoadSettingsCache(const std::filesystem::path &cache_filename,
+                                                          const std::filesystem::path &settings_filename,
+                                                          std::string_view prefix, Arena *arena);
+}  // namespace vl
@@ -0,0 +1,52 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "layer_settings_epoch.hpp"
+
+#include <thread>
+
+namespace vl {
+
+uint32_t SnapshotEpoch::GetStripe() {
+    // Constant initialized, so that reading it doesn't check for a dynamic initialization
+    static thread_local uint32_t stripe = STRIPE_COUNT;
+    if (stripe == STRIPE_COUNT) {
+        static std::atomic<uint32_t> next_stripe{0};
+        stripe = next_stripe.fetch_add(1, std::memory_order_relaxed) % STRIPE_COUNT;
+    }
+    return stripe;
+}
+
+void SnapshotEpoch::WaitReaders(uint32_t epoch_parity) const {
+    for (const ReaderCount &reader_count : this->readers[epoch_parity]) {
+        while (reader_count.count.load(std::memory_order_acquire) != 0) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void SnapshotEpoch::Synchronize() {
+    std::lock_guard<std::mutex> lock(this->synchronize_mutex);
+
+    // Order the publication of the new snapshots before the reads of the reader counts: a query counted after the
+    // reads loads the new snapshots
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // A query may load the epoch before the first flip and count itself in the previous parity after the wait for
+    // it, the second flip waits for it too
+    for (int flip = 0; flip < 2; ++flip) {
+        const uint32_t previous_epoch = this->epoch.fetch_add(1, std::memory_order_seq_cst);
+        this->WaitReaders(previous_epoch & 1);
+    }
+}
+
+SnapshotReadGuard::SnapshotReadGuard(SnapshotEpoch &epoch)
+    : count(epoch.readers[epoch.epoch.load(std::memory_order_seq_cst) & 1][SnapshotEpoch::GetStripe()].count) {
+    this->count.fetch_add(1, std::memory_order_seq_cst);
+}
+
+SnapshotReadGuard::~SnapshotReadGuard() { this->count.fetch_sub(1, std::memory_order_release); }
+
+}  // namespace vl
@@ -0,0 +1,60 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace vl {
+    // Reclamation of the snapshots a layer setting set publishes with an atomic store: the settings file and overlay
+    // parses and the frozen settings. Queries read the published snapshots inside a SnapshotReadGuard. A writer
+    // replacing a snapshot releases the previous one once Synchronize returns, when no query which could have loaded
+    // it is still running. Queries load the snapshots with std::memory_order_seq_cst, ordered after their reader count,
+    // a plain load on x86 and ARMv8.
+    class SnapshotEpoch {
+      public:
+        SnapshotEpoch() = default;
+
+        SnapshotEpoch(const SnapshotEpoch &) = delete;
+        SnapshotEpoch &operator=(const SnapshotEpoch &) = delete;
+
+        // Wait for the queries which began before the call. Must not be called inside a SnapshotReadGuard or with a
+        // lock taken by the queries.
+        void Synchronize();
+
+      private:
+        friend class SnapshotReadGuard;
+
+        // Readers of a thread count in their own stripe so that concurrent queries don't share a cache line
+        static constexpr uint32_t STRIPE_COUNT = 8;
+        struct ReaderCount {
+            std::atomic<uint32_t> count{0};
+            char padding[64 - sizeof(std::atomic<uint32_t>)];
+        };
+
+        static uint32_t GetStripe();
+        void WaitReaders(uint32_t epoch_parity) const;
+
+        std::atomic<uint32_t> epoch{0};
+        std::array<std::array<ReaderCount, STRIPE_COUNT>, 2> readers{};
+        std::mutex synchronize_mutex;
+    };
+
+    // Count a query as a reader of the epoch current when it began, two atomic increments of a thread local counter
+    class SnapshotReadGuard {
+      public:
+        explicit SnapshotReadGuard(SnapshotEpoch &epoch);
+        ~SnapshotReadGuard();
+
+        SnapshotReadGuard(const SnapshotReadGuard &) = delete;
+        SnapshotReadGuard &operator=(const SnapshotReadGuard &) = delete;
+
+      private:
+        std::atomic<uint32_t> &count;
+    };
+}  // namespace vl
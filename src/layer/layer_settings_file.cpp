@@ -0,0 +1,175 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "layer_settings_file.hpp"
+#include "layer_settings_util.hpp"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace vl {
+
+static std::string_view TrimWhitespace(std::string_view s) {
+    const char *whitespace = " \t\f\v\n\r";
+
+    const std::size_t trimmed_beg = s.find_first_not_of(whitespace);
+    if (trimmed_beg == std::string_view::npos) {
+        return std::string_view();
+    }
+
+    const std::size_t trimmed_end = s.find_last_not_of(whitespace);
+    return s.substr(trimmed_beg, trimmed_end - trimmed_beg + 1);
+}
+
+SettingsFile::SettingsFile(Arena *arena)
+    : content(ArenaAllocator<char>(arena)),
+      inserted_strings(ArenaAllocator<ArenaString>(arena)),
+      entries(ArenaAllocator<Entry>(arena)),
+      index(arena) {}
+
+void SettingsFile::ParseFile(const std::filesystem::path &filename) {
+    if (ReadFile(filename, this->content)) {
+        this->Parse(this->content);
+    }
+}
+
+void SettingsFile::Parse(std::string_view content) {
+    // Generated settings files are about 40 characters per line, reserve to avoid growing the index while parsing
+    this->entries.reserve(this->entries.size() + content.size() / 40);
+    this->index.Reserve(this->entries.capacity());
+
+    for (std::size_t line_begin = 0; line_begin < content.size();) {
+        std::size_t line_end = content.find('\n', line_begin);
+        if (line_end == std::string_view::npos) {
+            line_end = content.size();
+        }
+
+        std::string_view line = content.substr(line_begin, line_end - line_begin);
+        line_begin = line_end + 1;
+
+        // Discard comments, which start with '#'
+        const std::size_t comments_pos = line.find('#');
+        if (comments_pos != std::string_view::npos) {
+            line = line.substr(0, comments_pos);
+        }
+
+        const std::size_t value_pos = line.find('=');
+        if (value_pos == std::string_view::npos) {
+            continue;
+        }
+
+        const Entry entry{TrimWhitespace(line.substr(0, value_pos)), TrimWhitespace(line.substr(value_pos + 1))};
+
+        const uint32_t position = this->FindPosition(std::string_view(), HashSettingName(std::string_view()), entry.key);
+        if (position == HashIndex::NOT_FOUND) {
+            this->index.Insert(HashSettingName(entry.key), static_cast<uint32_t>(this->entries.size()),
+                               [](uint32_t) { return false; });
+            this->entries.push_back(entry);
+        } else {
+            this->entries[position].value = entry.value;
+        }
+    }
+}
+
+void SettingsFile::Insert(std::string_view key, std::string_view value) {
+    if (this->Find(key) != nullptr) {
+        return;
+    }
+
+    const ArenaString &stored_key = this->inserted_strings.emplace_back(key);
+    const ArenaString &stored_value = this->inserted_strings.emplace_back(value);
+
+    this->index.Insert(HashSettingName(stored_key), static_cast<uint32_t>(this->entries.size()), [](uint32_t) { return false; });
+    this->entries.push_back(Entry{stored_key, stored_value});
+}
+
+std::string_view SettingsFile::SetContent(std::string_view content, std::size_t entry_count) {
+    this->entries.reserve(this->entries.size() + entry_count);
+    this->index.Reserve(this->entries.capacity());
+
+    this->content.assign(content);
+    return this->content;
+}
+
+void SettingsFile::AddEntry(uint64_t key_hash, std::string_view key, std::string_view value) {
+    this->index.Insert(key_hash, static_cast<uint32_t>(this->entries.size()), [](uint32_t) { return false; });
+    this->entries.push_back(Entry{key, value});
+}
+
+uint32_t SettingsFile::FindPosition(std::string_view prefix, uint64_t prefix_hash, std::string_view name) const {
+    return this->index.Find(HashSettingName(name, prefix_hash), [&](uint32_t position) {
+        const std::string_view key = this->entries[position].key;
+        return key.size() == prefix.size() + name.size() && key.compare(0, prefix.size(), prefix) == 0 &&
+               key.compare(prefix.size(), name.size(), name) == 0;
+    });
+}
+
+const SettingsFile::Entry *SettingsFile::Find(std::string_view prefix, uint64_t prefix_hash, std::string_view name) const {
+    const uint32_t position = this->FindPosition(prefix, prefix_hash, name);
+    return position == HashIndex::NOT_FOUND ? nullptr : &this->entries[position];
+}
+
+const SettingsFile::Entry *SettingsFile::Find(std::string_view key) const {
+    return this->Find(std::string_view(), HashSettingName(std::string_view()), key);
+}
+
+struct CachedSettingsFile {
+    std::uintmax_t size;
+    std::filesystem::file_time_type last_write_time;
+    std::weak_ptr<const SettingsFile> settings_file;
+};
+
+struct SettingsFileCache {
+    std::mutex mutex;
+    std::unordered_map<std::string, CachedSettingsFile> files;
+};
+
+static SettingsFileCache &GetSettingsFileCache() {
+    // Never destroyed: layer setting sets may be destroyed by other static destructors at exit
+    static SettingsFileCache *cache = new SettingsFileCache;
+    return *cache;
+}
+
+std::shared_ptr<const SettingsFile> ParseSettingsFile(const std::filesystem::path &filename, Arena *arena) {
+    std::shared_ptr<SettingsFile> settings_file = std::allocate_shared<SettingsFile>(ArenaAllocator<SettingsFile>(arena), arena);
+    settings_file->ParseFile(filename);
+    return settings_file;
+}
+
+static std::shared_ptr<const SettingsFile> AcquireSettingsFile(const std::filesystem::path &filename, bool reload) {
+    std::error_code error;
+    const std::uintmax_t size = std::filesystem::file_size(filename, error);
+    const std::filesystem::file_time_type last_write_time = error ? std::filesystem::file_time_type() : std::filesystem::last_write_time(filename, error);
+    if (error) {
+        static const std::shared_ptr<const SettingsFile> empty_settings_file = std::make_shared<SettingsFile>();
+        return empty_settings_file;
+    }
+
+    SettingsFileCache &cache = GetSettingsFileCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+
+    CachedSettingsFile &cached_file = cache.files[filename.lexically_normal().string()];
+    std::shared_ptr<const SettingsFile> settings_file = cached_file.settings_file.lock();
+    if (!reload && settings_file != nullptr && cached_file.size == size && cached_file.last_write_time == last_write_time) {
+        return settings_file;
+    }
+
+    // Parsed with the lock held so that concurrent layers wait for a single parse of the file
+    std::shared_ptr<SettingsFile> parsed_settings_file = std::make_shared<SettingsFile>();
+    parsed_settings_file->ParseFile(filename);
+
+    cached_file = CachedSettingsFile{size, last_write_time, parsed_settings_file};
+    return parsed_settings_file;
+}
+
+std::shared_ptr<const SettingsFile> AcquireSettingsFile(const std::filesystem::path &filename) {
+    return AcquireSettingsFile(filename, false);
+}
+
+std::shared_ptr<const SettingsFile> ReloadSettingsFile(const std::filesystem::path &filename) {
+    return AcquireSettingsFile(filename, true);
+}
+
+}  // namespace vl
@@ -0,0 +1,107 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "layer_settings_arena.hpp"
+#include "layer_settings_index.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vl {
+    // Read the whole file in 'content' with a single allocation when the size is known.
+    // Return false if the file can't be read, the content is then empty.
+    template <typename String>
+    bool ReadFile(const std::filesystem::path &filename, String &content) {
+        content.clear();
+
+        std::ifstream stream(filename, std::ios::binary | std::ios::ate);
+        if (!stream.good()) {
+            return false;
+        }
+
+        const std::streamoff size = stream.tellg();
+        if (size > 0) {
+            content.resize(static_cast<std::size_t>(size));
+            stream.seekg(0);
+            stream.read(&content[0], size);
+            content.resize(static_cast<std::size_t>(stream.gcount()));
+        } else {
+            // Empty files and files without a size, such as pipes
+            stream.clear();
+            stream.seekg(0);
+            content.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        }
+
+        return true;
+    }
+
+    // vk_layer_settings.txt "key = value" pairs. Keys and values are views in a single copy of the file content
+    // so that parsing doesn't copy them, only values set afterward are stored.
+    class SettingsFile {
+      public:
+        struct Entry {
+            std::string_view key;
+            std::string_view value;
+        };
+
+        SettingsFile() = default;
+
+        // Store the content and the entries in 'arena' instead of the global heap
+        explicit SettingsFile(Arena *arena);
+
+        // Tokenize the file in a single pass, for duplicated keys the last value is kept
+        void ParseFile(const std::filesystem::path &filename);
+
+        // Entries are views in 'content' which must outlive the SettingsFile
+        void Parse(std::string_view content);
+
+        // Add a setting unless the key is already set
+        void Insert(std::string_view key, std::string_view value);
+
+        // Copy 'content' in an empty SettingsFile and return the copy, for the 'entry_count' entries added with AddEntry to view it
+        std::string_view SetContent(std::string_view content, std::size_t entry_count);
+
+        // Add an entry which key isn't set yet without tokenizing nor hashing, 'key_hash' is HashSettingName(key)
+        void AddEntry(uint64_t key_hash, std::string_view key, std::string_view value);
+
+        // Find a "prefix" + "name" key without building it, 'prefix_hash' is HashSettingName(prefix)
+        const Entry *Find(std::string_view prefix, uint64_t prefix_hash, std::string_view name) const;
+        const Entry *Find(std::string_view key) const;
+
+        const ArenaVector<Entry> &GetEntries() const { return this->entries; }
+
+      private:
+        uint32_t FindPosition(std::string_view prefix, uint64_t prefix_hash, std::string_view name) const;
+
+        // Parsed files are shared and may outlive changes of the file, so the file is read here instead of being
+        // mapped: accessing the pages of a mapped file truncated by another process raises SIGBUS.
+        ArenaString content;
+        std::deque<ArenaString, ArenaAllocator<ArenaString>> inserted_strings;
+        ArenaVector<Entry> entries;
+        HashIndex index;
+    };
+
+    // Parse 'filename' in 'arena', without sharing the parse
+    std::shared_ptr<const SettingsFile> ParseSettingsFile(const std::filesystem::path &filename, Arena *arena);
+
+    // Return the parse of 'filename', shared by every caller while the path, size and modification time of the file
+    // are unchanged. The parse is released with the last reference. Thread-safe.
+    std::shared_ptr<const SettingsFile> AcquireSettingsFile(const std::filesystem::path &filename);
+
+    // Parse 'filename' even when its size and modification time are unchanged, which happens when a file is rewritten
+    // with the same size within the timestamp granularity, and share the new parse with later AcquireSettingsFile calls.
+    // Thread-safe.
+    std::shared_ptr<const SettingsFile> ReloadSettingsFile(const std::filesystem::path &filename);
+}  // namespace vl
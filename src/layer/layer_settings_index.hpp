@@ -0,0 +1,157 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "layer_settings_arena.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace vl {
+    // Open addressing hash table mapping precomputed hashes to positions in an array owned by the caller.
+    // The caller provides the key comparison so that lookups never build temporary keys.
+    class HashIndex {
+      public:
+        static constexpr uint32_t NOT_FOUND = ~0u;
+
+        HashIndex() = default;
+        explicit HashIndex(Arena *arena) : slots(ArenaAllocator<Slot>(arena)) {}
+
+        // Remove every entry and size the table for 'count' entries
+        void Reserve(std::size_t count) {
+            std::size_t capacity = 16;
+            while (capacity < count * 2) {
+                capacity *= 2;
+            }
+
+            this->Allocate(capacity);
+            this->size = 0;
+        }
+
+        std::size_t Size() const { return this->size; }
+
+        // Return false if an entry comparing equal is already indexed, the first entry is kept
+        template <typename Equal>
+        bool Insert(uint64_t hash, uint32_t position, Equal equal) {
+            if ((this->size + 1) * 2 > this->slots.size()) {
+                this->Grow();
+            }
+
+            for (std::size_t slot_index = hash & this->mask;; slot_index = (slot_index + 1) & this->mask) {
+                Slot &slot = this->slots[slot_index];
+                if (slot.position == NOT_FOUND) {
+                    slot.hash = hash;
+                    slot.position = position;
+                    ++this->size;
+                    return true;
+                }
+                if (slot.hash == hash && equal(slot.position)) {
+                    return false;
+                }
+            }
+        }
+
+        template <typename Equal>
+        uint32_t Find(uint64_t hash, Equal equal) const {
+            if (this->size == 0) {
+                return NOT_FOUND;
+            }
+
+            for (std::size_t slot_index = hash & this->mask;; slot_index = (slot_index + 1) & this->mask) {
+                const Slot &slot = this->slots[slot_index];
+                if (slot.position == NOT_FOUND) {
+                    return NOT_FOUND;
+                }
+                if (slot.hash == hash && equal(slot.position)) {
+                    return slot.position;
+                }
+            }
+        }
+
+      private:
+        struct Slot {
+            uint64_t hash;
+            uint32_t position;
+        };
+
+        void Allocate(std::size_t capacity) {
+            this->slots.assign(capacity, Slot{0, NOT_FOUND});
+            this->mask = capacity - 1;
+        }
+
+        void Grow() {
+            ArenaVector<Slot> old_slots(this->slots.get_allocator());
+            old_slots.swap(this->slots);
+
+            this->Allocate(old_slots.empty() ? 16 : old_slots.size() * 2);
+            for (const Slot &slot : old_slots) {
+                if (slot.position == NOT_FOUND) {
+                    continue;
+                }
+
+                std::size_t slot_index = slot.hash & this->mask;
+                while (this->slots[slot_index].position != NOT_FOUND) {
+                    slot_index = (slot_index + 1) & this->mask;
+                }
+                this->slots[slot_index] = slot;
+            }
+        }
+
+        ArenaVector<Slot> slots;
+        std::size_t mask{0};
+        std::size_t size{0};
+    };
+
+    // Blocked Bloom filter of precomputed hashes: both bits of a hash are in the same word, so a lookup reads a single
+    // word. May report a hash which was never inserted, never misses an inserted one. Insert may run concurrently with
+    // MayContain, Reserve may not.
+    class PresenceFilter {
+      public:
+        PresenceFilter() = default;
+        explicit PresenceFilter(Arena *arena) : words(ArenaAllocator<std::atomic<uint64_t>>(arena)) {}
+
+        // Remove every hash and size the filter for 'count' hashes, 16 bits per hash
+        void Reserve(std::size_t count) {
+            std::size_t word_count = 8;
+            while (word_count * 64 < count * 16) {
+                word_count *= 2;
+            }
+
+            ArenaVector<std::atomic<uint64_t>> reserved_words(word_count, this->words.get_allocator());
+            this->words.swap(reserved_words);
+            this->mask = word_count - 1;
+        }
+
+        void Insert(uint64_t hash) {
+            this->words[GetWordIndex(hash)].fetch_or(GetBits(hash), std::memory_order_relaxed);
+        }
+
+        // Every hash may be contained until the filter is reserved
+        bool MayContain(uint64_t hash) const {
+            if (this->words.empty()) {
+                return true;
+            }
+
+            const uint64_t bits = GetBits(hash);
+            return (this->words[GetWordIndex(hash)].load(std::memory_order_relaxed) & bits) == bits;
+        }
+
+      private:
+        // Setting name hashes are FNV-1a, mixed so that the word index and the bits use independent bits of the hash
+        static uint64_t Mix(uint64_t hash) { return (hash ^ (hash >> 32)) * 0x9e3779b97f4a7c15ull; }
+
+        std::size_t GetWordIndex(uint64_t hash) const { return static_cast<std::size_t>(Mix(hash) >> 40) & this->mask; }
+
+        static uint64_t GetBits(uint64_t hash) {
+            const uint64_t mixed = Mix(hash);
+            return (1ull << (mixed & 63)) | (1ull << ((mixed >> 6) & 63));
+        }
+
+        ArenaVector<std::atomic<uint64_t>> words;
+        std::size_t mask{0};
+    };
+}  // namespace vl
@@ -0,0 +1,186 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "layer_settings_log.hpp"
+#include "layer_settings_util.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+namespace vl {
+
+// Copy a string to a slot buffer, a truncated string ends with "..."
+static void CopyTruncated(char *destination, std::size_t destination_size, const char *source) {
+    const std::size_t length = std::strlen(source);
+    if (length < destination_size) {
+        std::memcpy(destination, source, length + 1);
+        return;
+    }
+
+    std::memcpy(destination, source, destination_size - 4);
+    std::memcpy(destination + destination_size - 4, "...", 4);
+}
+
+LogSink::LogSink(const char *pLayerName, VlLayerSettingLogCallback pCallback)
+    : layer_name(pLayerName), pCallback(pCallback), rate_window_begin(std::chrono::steady_clock::now()) {
+    for (std::size_t i = 0; i < RING_SIZE; ++i) {
+        this->ring[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    this->thread = std::thread([this]() {
+        std::unique_lock<std::mutex> lock(this->drain_mutex);
+        while (!this->stopping.load(std::memory_order_acquire)) {
+            this->Drain();
+            // Log notifies without locking, the timeout picks up a notification sent before waiting
+            this->wake.wait_for(lock, std::chrono::milliseconds(10));
+        }
+    });
+}
+
+LogSink::~LogSink() { this->Stop(); }
+
+void LogSink::Log(const char *pSettingName, const char *pMessage) {
+    const uint64_t hash = HashCombine(HashString(pSettingName), HashString(pMessage));
+    if (this->recent_hashes[hash % RING_SIZE].load(std::memory_order_relaxed) == hash) {
+        this->duplicate_count.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Bounded multi-producer queue: a slot is claimed by advancing the write position when its sequence matches
+    uint64_t position = this->write_position.load(std::memory_order_relaxed);
+    Slot *slot = nullptr;
+    for (;;) {
+        slot = &this->ring[position % RING_SIZE];
+        const uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+        if (sequence == position) {
+            if (this->write_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (sequence < position) {
+            this->dropped_count.fetch_add(1, std::memory_order_relaxed);  // Full, the slot wasn't read yet
+            return;
+        } else {
+            position = this->write_position.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->hash = hash;
+    CopyTruncated(slot->setting_name, SETTING_NAME_SIZE, pSettingName);
+    CopyTruncated(slot->message, MESSAGE_SIZE, pMessage);
+    slot->sequence.store(position + 1, std::memory_order_release);
+
+    this->wake.notify_one();
+}
+
+void LogSink::Flush() {
+    std::lock_guard<std::mutex> lock(this->drain_mutex);
+
+    this->Drain();
+    this->ReportDiscarded();
+}
+
+void LogSink::Stop() {
+    if (this->thread.joinable()) {
+        this->stopping.store(true, std::memory_order_release);
+        this->wake.notify_one();
+        this->thread.join();
+
+        this->Flush();
+    }
+}
+
+void LogSink::Drain() {
+    for (;;) {
+        Slot &slot = this->ring[this->read_position % RING_SIZE];
+        if (slot.sequence.load(std::memory_order_acquire) != this->read_position + 1) {
+            return;  // Empty, or the next slot is still being written
+        }
+
+        if (this->IsLogged(slot.hash)) {
+            this->duplicate_count.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            const auto now = std::chrono::steady_clock::now();
+            if (now - this->rate_window_begin >= std::chrono::seconds(1)) {
+                this->ReportDiscarded();
+                this->rate_window_begin = now;
+                this->rate_window_count = 0;
+            }
+
+            const uint32_t limit = this->messages_per_second.load(std::memory_order_relaxed);
+            if (limit != 0 && this->rate_window_count >= limit) {
+                ++this->rate_limited_count;
+            } else {
+                ++this->rate_window_count;
+                this->Output(slot.setting_name, slot.message);
+
+                this->MarkLogged(slot.hash);
+                this->recent_hashes[slot.hash % RING_SIZE].store(slot.hash, std::memory_order_relaxed);
+            }
+        }
+
+        slot.sequence.store(this->read_position + RING_SIZE, std::memory_order_release);
+        ++this->read_position;
+    }
+}
+
+void LogSink::ReportDiscarded() {
+    const uint64_t dropped_count = this->dropped_count.load(std::memory_order_relaxed);
+    const uint64_t duplicate_count = this->duplicate_count.load(std::memory_order_relaxed);
+
+    if (dropped_count > this->reported_dropped_count) {
+        const std::string &message = FormatString("%llu messages dropped, the log queue was full.",
+                                                  static_cast<unsigned long long>(dropped_count - this->reported_dropped_count));
+        this->Output(this->layer_name.c_str(), message.c_str());
+        this->reported_dropped_count = dropped_count;
+    }
+
+    if (duplicate_count > this->reported_duplicate_count) {
+        const std::string &message = FormatString("%llu duplicate messages suppressed.",
+                                                  static_cast<unsigned long long>(duplicate_count - this->reported_duplicate_count));
+        this->Output(this->layer_name.c_str(), message.c_str());
+        this->reported_duplicate_count = duplicate_count;
+    }
+
+    if (this->rate_limited_count > 0) {
+        const std::string &message = FormatString("%llu messages suppressed by the rate limit.",
+                                                  static_cast<unsigned long long>(this->rate_limited_count));
+        this->Output(this->layer_name.c_str(), message.c_str());
+        this->rate_limited_count = 0;
+    }
+}
+
+// Open addressing set of hashes, 0 marks an empty slot. Once half full, new messages are no longer recorded, so
+// there is always an empty slot ending the probe.
+static uint64_t GetLoggedKey(uint64_t hash) { return hash == 0 ? 1 : hash; }
+
+std::size_t LogSink::FindLogged(uint64_t hash) const {
+    const uint64_t key = GetLoggedKey(hash);
+
+    std::size_t index = key % LOGGED_HASH_COUNT;
+    while (this->logged_hashes[index] != key && this->logged_hashes[index] != 0) {
+        index = (index + 1) % LOGGED_HASH_COUNT;
+    }
+    return index;
+}
+
+bool LogSink::IsLogged(uint64_t hash) const { return this->logged_hashes[this->FindLogged(hash)] != 0; }
+
+void LogSink::MarkLogged(uint64_t hash) {
+    const std::size_t index = this->FindLogged(hash);
+    if (this->logged_hashes[index] == 0 && this->logged_hash_count * 2 < LOGGED_HASH_COUNT) {
+        this->logged_hashes[index] = GetLoggedKey(hash);
+        ++this->logged_hash_count;
+    }
+}
+
+void LogSink::Output(const char *pSettingName, const char *pMessage) const {
+    if (this->pCallback == nullptr) {
+        fprintf(stderr, "LAYER SETTING (%s) error: %s\n", pSettingName, pMessage);
+    } else {
+        this->pCallback(pSettingName, pMessage);
+    }
+}
+
+}  // namespace vl
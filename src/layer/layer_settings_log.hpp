@@ -0,0 +1,100 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "vulkan/layer/vk_layer_settings.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace vl {
+    // Messages of a layer setting set logged by a background thread, see VL_LAYER_SETTING_SET_CREATE_ASYNC_LOG_BIT.
+    // Log never blocks: messages are written to a lock-free ring buffer, a message is dropped when the ring buffer is
+    // full. The background thread logs each (setting, message) pair once and at most 'messages per second' messages.
+    class LogSink {
+      public:
+        static constexpr uint32_t DEFAULT_MESSAGES_PER_SECOND = 100;
+
+        LogSink(const char *pLayerName, VlLayerSettingLogCallback pCallback);
+        ~LogSink();
+
+        LogSink(const LogSink &) = delete;
+        LogSink &operator=(const LogSink &) = delete;
+
+        // Called by any thread, longer setting names and messages are truncated
+        void Log(const char *pSettingName, const char *pMessage);
+
+        // 0 removes the limit
+        void SetRateLimit(uint32_t messagesPerSecond) { this->messages_per_second.store(messagesPerSecond, std::memory_order_relaxed); }
+
+        // Log the messages written before the call and the number of messages dropped or suppressed so far
+        void Flush();
+
+        // Flush and wait for the background thread, Log must not be called afterward
+        void Stop();
+
+      private:
+        static constexpr std::size_t RING_SIZE = 64;
+        static constexpr std::size_t SETTING_NAME_SIZE = 64;
+        static constexpr std::size_t MESSAGE_SIZE = 512;
+        static constexpr std::size_t LOGGED_HASH_COUNT = 1024;
+
+        // 'sequence' is the ring position the slot can be written at, or that position + 1 once the slot is written
+        struct Slot {
+            std::atomic<uint64_t> sequence{0};
+            uint64_t hash{0};
+            char setting_name[SETTING_NAME_SIZE];
+            char message[MESSAGE_SIZE];
+        };
+
+        // Log the messages of the ring buffer, called with 'drain_mutex' locked
+        void Drain();
+
+        // Log the number of messages dropped or suppressed since the previous report
+        void ReportDiscarded();
+
+        // Position of 'hash' in 'logged_hashes', or of the empty slot it would be recorded at
+        std::size_t FindLogged(uint64_t hash) const;
+        bool IsLogged(uint64_t hash) const;
+        // Record a message once output, rate limited messages may be logged in a later window
+        void MarkLogged(uint64_t hash);
+
+        void Output(const char *pSettingName, const char *pMessage) const;
+
+        std::string layer_name;
+        VlLayerSettingLogCallback pCallback{nullptr};
+        std::atomic<uint32_t> messages_per_second{DEFAULT_MESSAGES_PER_SECOND};
+
+        std::array<Slot, RING_SIZE> ring;
+        std::atomic<uint64_t> write_position{0};
+        std::atomic<uint64_t> dropped_count{0};
+        std::atomic<uint64_t> duplicate_count{0};
+        // Hashes of recently output messages, read by Log to skip duplicates without writing them to the ring buffer
+        std::array<std::atomic<uint64_t>, RING_SIZE> recent_hashes{};
+
+        // Guards the members below, only the thread draining the ring buffer reads it
+        std::mutex drain_mutex;
+        uint64_t read_position{0};
+        std::array<uint64_t, LOGGED_HASH_COUNT> logged_hashes{};
+        std::size_t logged_hash_count{0};
+        uint64_t rate_limited_count{0};
+        uint64_t reported_dropped_count{0};
+        uint64_t reported_duplicate_count{0};
+        std::chrono::steady_clock::time_point rate_window_begin;
+        uint32_t rate_window_count{0};
+
+        std::condition_variable wake;
+        std::atomic<bool> stopping{false};
+        std::thread thread;
+    };
+}  // namespace vl
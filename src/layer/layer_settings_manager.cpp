@@ -7,6 +7,7 @@
 // Author(s):
 // - Christophe Riccio <christophe@lunarg.com>
 #include "layer_settings_manager.hpp"
+#include "layer_settings_cache.hpp"
 #include "layer_settings_util.hpp"
 
 #include <sys/stat.h>
@@ -20,17 +21,27 @@
 #define GetCurrentDir getcwd
 #endif
 
+#if defined(__APPLE__)
+#include <crt_externs.h>
+#elif !defined(_WIN32)
+extern char **environ;
+#endif
+
 #ifdef __ANDROID__
 #include <sys/system_properties.h>
 #endif
 
 #include <cassert>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
-#include <fstream>
-#include <sstream>
 #include <array>
 #include <algorithm>
+#include <cctype>
+#include <tuple>
+#include <utility>
 
 #if defined(__ANDROID__)
 static std::string GetAndroidProperty(const char *name) {
@@ -64,11 +75,72 @@ static std::string GetEnvironment(const char *variable) {
 #endif
 }
 
-static bool IsEnvironment(const char *variable) {
-    const std::string& result = GetEnvironment(variable);
-    return !result.empty();
+#if !defined(__ANDROID__)
+// Return every "NAME=VALUE" environment variable which name starts with 'prefix'
+static void GetEnvironmentVariables(const char *prefix, vl::ArenaVector<vl::ArenaString> &result) {
+    const std::size_t prefix_size = std::strlen(prefix);
+
+#if defined(_WIN32)
+    char *environment = GetEnvironmentStringsA();
+    if (environment != nullptr) {
+        for (const char *variable = environment; *variable != '\0'; variable += std::strlen(variable) + 1) {
+            if (_strnicmp(variable, prefix, prefix_size) == 0) {
+                result.push_back(variable);
+            }
+        }
+        FreeEnvironmentStringsA(environment);
+    }
+#else
+#if defined(__APPLE__)
+    char **environment = *_NSGetEnviron();
+#else
+    char **environment = environ;
+#endif
+    for (char **variable = environment; variable != nullptr && *variable != nullptr; ++variable) {
+        if (std::strncmp(*variable, prefix, prefix_size) == 0) {
+            result.emplace_back(*variable);
+        }
+    }
+#endif
+}
+
+// Compare a character of an environment variable name with an upper case character, names are case insensitive on Windows
+static bool IsEnvironmentChar(char variable_char, char upper_char) {
+#if defined(_WIN32)
+    return std::toupper(static_cast<unsigned char>(variable_char)) == upper_char;
+#else
+    return variable_char == upper_char;
+#endif
 }
 
+static bool IsEnvironmentPrefix(std::string_view variable_name, const std::string &prefix) {
+    if (variable_name.size() < prefix.size()) {
+        return false;
+    }
+
+    for (std::size_t i = 0, n = prefix.size(); i < n; ++i) {
+        if (!IsEnvironmentChar(variable_name[i], prefix[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Whether 'env_name' is the environment variable spelling of 'setting_name': MY_SETTING for my_setting
+static bool IsEnvironmentSettingName(std::string_view env_name, const char *setting_name) {
+    std::size_t i = 0;
+    for (std::size_t n = env_name.size(); i < n; ++i) {
+        if (setting_name[i] == '\0' ||
+            !IsEnvironmentChar(env_name[i], static_cast<char>(std::toupper(static_cast<unsigned char>(setting_name[i]))))) {
+            return false;
+        }
+    }
+
+    return setting_name[i] == '\0';
+}
+#endif
+
 #if defined(WIN32)
 // Check for admin rights
 static inline bool IsHighIntegrity() {
@@ -106,34 +178,601 @@ static void AddWorkaroundLayerNames(std::vector<std::string> &layer_names) {
 namespace vl {
 
 LayerSettings::LayerSettings(const char *pLayerName, const VkLayerSettingsCreateInfoEXT *pCreateInfo,
-                             const VkAllocationCallbacks *pAllocator, VlLayerSettingLogCallback pCallback)
-    : layer_name(pLayerName), create_info(pCreateInfo), pCallback(pCallback) {
-    (void)pAllocator;
+                             const VkAllocationCallbacks *pAllocator, VlLayerSettingLogCallback pCallback,
+                             VlLayerSettingSetCreateFlags flags)
+    : arena(pAllocator),
+      retired_setting_files(ArenaAllocator<std::shared_ptr<const SettingsFile>>(&arena)),
+      setting_file_values(&arena),
+      file_setting_prefix(ArenaAllocator<char>(&arena)),
+      setting_name_filter(&arena),
+      string_pool(&arena),
+      setting_strings(ArenaAllocator<char>(&arena)),
+      resolved_settings(ArenaAllocator<char>(&arena)),
+      unset_setting(&arena),
+      layer_name(pLayerName, ArenaAllocator<char>(&arena)),
+      layer_name_hash(vl::HashSettingName(pLayerName)),
+      api_settings(ArenaAllocator<const VkLayerSettingEXT *>(&arena)),
+      api_setting_index(&arena),
+      env_variables(ArenaAllocator<ArenaString>(&arena)),
+      env_settings(ArenaAllocator<EnvSetting>(&arena)),
+      env_setting_index(&arena),
+      pCallback(pCallback),
+      has_allocator(pAllocator != nullptr),
+      retired_frozen_settings(ArenaAllocator<ArenaPtr<FrozenLayerSettings>>(&arena)) {
     assert(pLayerName != nullptr);
 
-    std::filesystem::path settings_file = this->FindSettingsFile();
-    this->ParseSettingsFile(settings_file);
+    if (flags & (VL_LAYER_SETTING_SET_CREATE_STATISTICS_BIT | VL_LAYER_SETTING_SET_CREATE_LOG_STATISTICS_BIT)) {
+        this->statistics = MakeArenaPtr<LayerSettingStatistics>(this->arena);
+        this->log_statistics = (flags & VL_LAYER_SETTING_SET_CREATE_LOG_STATISTICS_BIT) != 0;
+    }
+
+    if (flags & VL_LAYER_SETTING_SET_CREATE_ASYNC_LOG_BIT) {
+        this->log_sink = MakeArenaPtr<LogSink>(this->arena, pLayerName, pCallback);
+    }
+
+    this->IndexAPISettings(pCreateInfo);
+    this->IndexEnvSettings();
+
+    this->file_setting_prefix.assign(vl::GetFileSettingName(pLayerName, ""));
+    this->file_setting_prefix_hash = vl::HashSettingName(this->file_setting_prefix);
+
+    if (flags & VL_LAYER_SETTING_SET_CREATE_RESOLVED_SNAPSHOT_BIT) {
+        this->ResolveSnapshot();
+    } else if (flags & VL_LAYER_SETTING_SET_CREATE_WATCH_SETTINGS_FILE_BIT) {
+        this->GetSettingsFile();  // The watcher needs the location of the settings file
+        this->watching_setting_file =
+            this->setting_file_watcher.Start(this->setting_file_path, [this]() { this->ReloadSettingsFile(); });
+    }
 }
 
-LayerSettings::~LayerSettings() {}
+LayerSettings::~LayerSettings() {
+    this->setting_file_watcher.Stop();
+    this->StopOverlay();
+
+    if (this->log_sink != nullptr) {
+        this->log_sink->Stop();
+    }
+
+    if (this->log_statistics) {
+        this->LogStatistics();
+    }
+}
+
+void LayerSettings::LogStatistics() const {
+    const LayerSettingStatistics &counters = *this->statistics;
+    const std::string &message = vl::FormatString(
+        "lookups env %llu file %llu api %llu, cache hits %llu misses %llu, getenv %llu, parse failures %llu, "
+        "allocated bytes %llu peak %llu, FindSettingsFile %llu ns, ParseSettingsFile %llu ns, "
+        "vlGetLayerSettingValues %llu calls %llu ns",
+        static_cast<unsigned long long>(counters.env_lookup_count.load()),
+        static_cast<unsigned long long>(counters.file_lookup_count.load()),
+        static_cast<unsigned long long>(counters.api_lookup_count.load()),
+        static_cast<unsigned long long>(counters.cache_hit_count.load()),
+        static_cast<unsigned long long>(counters.cache_miss_count.load()),
+        static_cast<unsigned long long>(counters.getenv_count.load()),
+        static_cast<unsigned long long>(counters.parse_failure_count.load()),
+        static_cast<unsigned long long>(sizeof(LayerSettings) + this->arena.GetAllocatedBytes()),
+        static_cast<unsigned long long>(sizeof(LayerSettings) + this->arena.GetPeakAllocatedBytes()),
+        static_cast<unsigned long long>(counters.find_settings_file_ns.load()),
+        static_cast<unsigned long long>(counters.parse_settings_file_ns.load()),
+        static_cast<unsigned long long>(counters.get_values_count.load()),
+        static_cast<unsigned long long>(counters.get_values_ns.load()));
+
+    if (this->pCallback == nullptr) {
+        fprintf(stderr, "LAYER SETTING (%s) statistics: %s\n", this->layer_name.c_str(), message.c_str());
+    } else {
+        this->pCallback(this->layer_name.c_str(), message.c_str());
+    }
+}
+
+std::string LayerSettings::ReadEnvironment(const char *variable) const {
+    this->Count(&LayerSettingStatistics::getenv_count);
+    return GetEnvironment(variable);
+}
+
+const SettingsFile &LayerSettings::GetSettingsFile() const {
+    // A layer setting set is never created const, loading the settings file only completes its initialization
+    std::call_once(this->setting_file_once, [this]() { const_cast<LayerSettings *>(this)->LoadSettingsFile(); });
+    // Sequentially consistent with the reader count of the query, see SnapshotEpoch
+    return *this->setting_file.load(std::memory_order_seq_cst);
+}
+
+void LayerSettings::LoadSettingsFile() {
+    {
+        StatisticsTimer timer(this->GetStatistics(), &LayerSettingStatistics::find_settings_file_ns);
+        this->setting_file_path = this->FindSettingsFile();
+    }
+    this->ParseSettingsFile(this->setting_file_path);
+    this->FilterSettingNames();
+}
+
+void LayerSettings::FilterSettingNames() {
+    const SettingsFile &settings_file = *this->setting_file.load(std::memory_order_relaxed);
+    this->setting_name_filter.Reserve(this->env_settings.size() + this->api_settings.size() + settings_file.GetEntries().size());
+
+    for (const EnvSetting &env_setting : this->env_settings) {
+        this->setting_name_filter.Insert(vl::HashSettingName(env_setting.name));
+    }
+
+    for (const VkLayerSettingEXT *setting : this->api_settings) {
+        if (setting->pLayerName == this->layer_name) {
+            this->setting_name_filter.Insert(vl::HashSettingName(setting->pSettingName));
+        }
+    }
+
+    this->FilterFileSettingNames(settings_file);
+}
+
+void LayerSettings::FilterFileSettingNames(const SettingsFile &settings_file) {
+    for (const SettingsFile::Entry &entry : settings_file.GetEntries()) {
+        if (entry.key.compare(0, this->file_setting_prefix.size(), this->file_setting_prefix) == 0) {
+            this->setting_name_filter.Insert(vl::HashSettingName(std::string_view(entry.key).substr(this->file_setting_prefix.size())));
+        }
+    }
+}
 
 void LayerSettings::ParseSettingsFile(const std::filesystem::path &filename) {
-    // Extract option = value pairs from a file
-    std::ifstream file(filename);
-    if (file.good()) {
-        for (std::string line; std::getline(file, line);) {
-            // discard comments, which start with '#'
-            const auto comments_pos = line.find_first_of('#');
-            if (comments_pos != std::string::npos) line.erase(comments_pos);
-
-            const auto value_pos = line.find_first_of('=');
-            if (value_pos != std::string::npos) {
-                const std::string setting_key = vl::TrimWhitespace(line.substr(0, value_pos));
-                const std::string setting_value = vl::TrimWhitespace(line.substr(value_pos + 1));
-                this->setting_file_values[setting_key] = setting_value;
+    StatisticsTimer timer(this->GetStatistics(), &LayerSettingStatistics::parse_settings_file_ns);
+
+    // Without a settings file, there is no cache to look for either
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(filename, error)) {
+        this->setting_file_owner = std::allocate_shared<SettingsFile>(ArenaAllocator<SettingsFile>(&this->arena), &this->arena);
+        this->setting_file.store(this->setting_file_owner.get(), std::memory_order_release);
+        return;
+    }
+
+    // Load the settings of the layer precompiled by vlCompileLayerSettingsCache when the settings file is unchanged
+    std::shared_ptr<const SettingsFile> settings_file =
+        vl::LoadSettingsCache(vl::GetSettingsCachePath(filename, this->file_setting_prefix), filename, this->file_setting_prefix,
+                              this->has_allocator ? &this->arena : nullptr);
+
+    // Otherwise extract option = value pairs from the file. The shared parse is allocated on the global heap, so a layer
+    // setting set with VkAllocationCallbacks parses its own copy.
+    if (settings_file == nullptr) {
+        settings_file = this->has_allocator ? vl::ParseSettingsFile(filename, &this->arena) : vl::AcquireSettingsFile(filename);
+    }
+
+    this->setting_file_owner = std::move(settings_file);
+    this->setting_file.store(this->setting_file_owner.get(), std::memory_order_release);
+}
+
+bool LayerSettings::CompileSettingsCache() const {
+    this->GetSettingsFile();  // Find the settings file
+
+    SettingsFile settings_file;
+    settings_file.ParseFile(this->setting_file_path);
+
+    return vl::WriteSettingsCache(vl::GetSettingsCachePath(this->setting_file_path, this->file_setting_prefix),
+                                  this->setting_file_path, settings_file, this->file_setting_prefix);
+}
+
+// Add the names of the settings of 'file' starting with 'prefix' which value differs in 'other_file'
+static void AddChangedSettings(const SettingsFile &file, const SettingsFile &other_file, std::string_view prefix,
+                               bool add_modified, std::vector<std::string> &setting_names) {
+    for (const SettingsFile::Entry &entry : file.GetEntries()) {
+        if (entry.key.compare(0, prefix.size(), prefix) != 0) {
+            continue;
+        }
+
+        const SettingsFile::Entry *other_entry = other_file.Find(entry.key);
+        if (other_entry == nullptr || (add_modified && other_entry->value != entry.value)) {
+            setting_names.emplace_back(entry.key.substr(prefix.size()));
+        }
+    }
+}
+
+// Called by the settings file watcher thread
+void LayerSettings::ReloadSettingsFile() {
+    std::shared_ptr<const SettingsFile> reloaded_file;
+    {
+        StatisticsTimer timer(this->GetStatistics(), &LayerSettingStatistics::parse_settings_file_ns);
+        // The file was written, so the process cache is bypassed: its size and modification time may be unchanged
+        reloaded_file = this->has_allocator ? vl::ParseSettingsFile(this->setting_file_path, &this->arena)
+                                            : vl::ReloadSettingsFile(this->setting_file_path);
+    }
+
+    std::vector<std::string> setting_names;
+    VlLayerSettingsChangedCallback changed_callback = nullptr;
+    void *changed_user_data = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(this->watch_mutex);
+
+        const SettingsFile *previous_file = this->setting_file.load(std::memory_order_relaxed);
+        if (reloaded_file.get() == previous_file) {
+            return;
+        }
+
+        AddChangedSettings(*reloaded_file, *previous_file, this->file_setting_prefix, true, setting_names);
+        AddChangedSettings(*previous_file, *reloaded_file, this->file_setting_prefix, false, setting_names);
+
+        // Names removed by the reload stay in the filter, only costing the lookups of the sources
+        this->FilterFileSettingNames(*reloaded_file);
+
+        this->retired_setting_files.push_back(std::move(this->setting_file_owner));
+        this->setting_file_owner = reloaded_file;
+        this->setting_file.store(reloaded_file.get(), std::memory_order_release);
+        this->source_generation.fetch_add(1, std::memory_order_release);
+
+        if (this->GetFrozenSettings() != nullptr) {
+            this->Freeze();
+        }
+
+        this->ReleaseRetiredSnapshots();
+
+        changed_callback = this->pChangedCallback;
+        changed_user_data = this->pChangedUserData;
+    }
+
+    if (changed_callback != nullptr && !setting_names.empty()) {
+        std::vector<const char *> names;
+        for (const std::string &setting_name : setting_names) {
+            names.push_back(setting_name.c_str());
+        }
+        changed_callback(changed_user_data, static_cast<uint32_t>(names.size()), names.data());
+    }
+}
+
+VkResult LayerSettings::AttachOverlay(const char *pSegmentName, VlLayerSettingsOverlayPriority priority) {
+    if (!vl::IsSettingsOverlaySupported() || this->resolved_snapshot) {
+        return VK_ERROR_FEATURE_NOT_PRESENT;
+    }
+
+    if (this->overlay != nullptr) {
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    ArenaPtr<SettingsOverlay> overlay = MakeArenaPtr<SettingsOverlay>(this->arena);
+    if (!overlay->Open(pSegmentName)) {
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    this->overlay_priority = priority;
+    this->overlay = std::move(overlay);
+    this->LoadOverlay();
+
+    this->overlay_thread = std::thread(&LayerSettings::WatchOverlay, this);
+
+    return VK_SUCCESS;
+}
+
+void LayerSettings::UpdateOverlay() {
+    if (this->overlay == nullptr) {
+        return;
+    }
+
+    // Odd while a writer modifies the segment, the query after it's done loads the new values
+    const uint64_t sequence = this->overlay->GetSequence();
+    if (sequence == this->overlay_sequence.load(std::memory_order_acquire) || (sequence & 1) != 0) {
+        return;
+    }
+
+    if (this->GetFrozenSettings() == nullptr) {
+        this->LoadOverlay();
+        return;
+    }
+
+    // Freezing again takes longer than a query, so concurrent queries keep reading the current frozen settings
+    if (!this->overlay_load_pending.exchange(true, std::memory_order_acq_rel)) {
+        std::lock_guard<std::mutex> lock(this->overlay_mutex);
+        this->overlay_load_requested = true;
+        this->overlay_wake.notify_one();
+    }
+}
+
+void LayerSettings::LoadOverlay() {
+    this->GetSettingsFile();  // The overlay names are added to the presence filter, which is sized by the file parse
+
+    std::lock_guard<std::mutex> lock(this->watch_mutex);
+
+    uint64_t sequence = 0;
+    std::shared_ptr<const SettingsFile> overlay_file = this->overlay->Read(&this->arena, sequence);
+    if (overlay_file == nullptr || sequence == this->overlay_sequence.load(std::memory_order_relaxed)) {
+        return;  // A writer keeps modifying the segment and the next query tries again, or another query loaded it
+    }
+
+    // Names removed from the overlay stay in the filter, only costing the lookups of the sources
+    this->FilterFileSettingNames(*overlay_file);
+
+    if (this->overlay_file_owner != nullptr) {
+        this->retired_setting_files.push_back(std::move(this->overlay_file_owner));
+    }
+    this->overlay_file_owner = std::move(overlay_file);
+    this->overlay_file.store(this->overlay_file_owner.get(), std::memory_order_release);
+    this->source_generation.fetch_add(1, std::memory_order_release);
+
+    if (this->GetFrozenSettings() != nullptr) {
+        this->Freeze();
+    }
+
+    // Published once frozen, so that queries don't request loading the values being frozen
+    this->overlay_sequence.store(sequence, std::memory_order_release);
+
+    this->ReleaseRetiredSnapshots();
+}
+
+void LayerSettings::WatchOverlay() {
+    std::unique_lock<std::mutex> lock(this->overlay_mutex);
+    for (;;) {
+        this->overlay_wake.wait(lock, [this]() { return this->overlay_load_requested || this->overlay_stopping; });
+        if (this->overlay_stopping) {
+            return;
+        }
+        this->overlay_load_requested = false;
+
+        lock.unlock();
+        // Cleared before loading, so that a write during the load is requested again
+        this->overlay_load_pending.store(false, std::memory_order_release);
+        this->LoadOverlay();
+        lock.lock();
+    }
+}
+
+void LayerSettings::StopOverlay() {
+    if (this->overlay_thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(this->overlay_mutex);
+            this->overlay_stopping = true;
+            this->overlay_wake.notify_one();
+        }
+        this->overlay_thread.join();
+    }
+}
+
+void LayerSettings::Freeze() {
+    std::lock_guard<std::mutex> lock(this->frozen_mutex);
+
+    ArenaPtr<FrozenLayerSettings> frozen = MakeArenaPtr<FrozenLayerSettings>(this->arena, &this->arena);
+
+    const std::vector<std::string> &setting_names = this->GetSettingNames(true);
+    frozen->settings.reserve(setting_names.size());
+    frozen->index.Reserve(setting_names.size());
+
+    for (const std::string &setting_name : setting_names) {
+        const uint32_t position = static_cast<uint32_t>(frozen->settings.size());
+        const bool inserted = frozen->index.Insert(vl::HashSettingName(setting_name), position, [&](uint32_t position) {
+            return std::string_view(frozen->settings[position]->name) == setting_name;
+        });
+        if (inserted) {
+            frozen->settings.push_back(vl::ResolveLayerSetting(*this, setting_name.c_str()));
+        }
+    }
+
+    // Settings only set by the VK_ names of environment variables are fingerprinted, but not enumerated
+    std::vector<std::string> layer_setting_names = this->GetSettingNames(false);
+    std::sort(layer_setting_names.begin(), layer_setting_names.end());
+
+    frozen->sorted_settings.reserve(frozen->settings.size());
+    for (const ArenaPtr<ResolvedSetting> &setting : frozen->settings) {
+        if (setting->value.found) {
+            setting->enumerated =
+                std::binary_search(layer_setting_names.begin(), layer_setting_names.end(), std::string_view(setting->name));
+            frozen->sorted_settings.push_back(setting.get());
+        }
+    }
+    std::sort(frozen->sorted_settings.begin(), frozen->sorted_settings.end(),
+              [](const ResolvedSetting *a, const ResolvedSetting *b) { return a->name < b->name; });
+
+    // The string values are resolved with the other types, folding them costs a hash of each value
+    for (const ResolvedSetting *setting : frozen->sorted_settings) {
+        const LayerSettingTypedValues *strings = setting->typed_values[VL_LAYER_SETTING_TYPE_STRING].get();
+        const bool valid = strings->count_result == VK_SUCCESS && strings->result == VK_SUCCESS;
+        const VkLayerSettingEXT *api_setting =
+            setting->value.source == VL_LAYER_SETTING_SOURCE_API ? setting->value.api_setting : nullptr;
+        frozen->fingerprint =
+            vl::FingerprintLayerSetting(frozen->fingerprint, setting->name, api_setting, valid ? strings->count : 0,
+                                        reinterpret_cast<const char *const *>(strings->data.data()));
+    }
+
+    if (this->frozen_settings_owner != nullptr) {
+        this->retired_frozen_settings.push_back(std::move(this->frozen_settings_owner));
+    }
+    this->frozen_settings_owner = std::move(frozen);
+    this->frozen_settings.store(this->frozen_settings_owner.get(), std::memory_order_release);
+}
+
+void LayerSettings::ReleaseRetiredSnapshots() {
+    ArenaVector<std::shared_ptr<const SettingsFile>> setting_files(ArenaAllocator<std::shared_ptr<const SettingsFile>>(&this->arena));
+    setting_files.swap(this->retired_setting_files);
+
+    ArenaVector<ArenaPtr<FrozenLayerSettings>> frozen_settings_list(ArenaAllocator<ArenaPtr<FrozenLayerSettings>>(&this->arena));
+    {
+        std::lock_guard<std::mutex> lock(this->frozen_mutex);
+        frozen_settings_list.swap(this->retired_frozen_settings);
+    }
+
+    if (setting_files.empty() && frozen_settings_list.empty()) {
+        return;
+    }
+
+    // The snapshots were retired before the call, no query beginning afterward can load them
+    this->snapshot_epoch.Synchronize();
+}
+
+std::vector<std::string> LayerSettings::GetSettingNames(bool namespace_env_settings) const {
+    std::vector<std::string> setting_names;
+
+    for (const VkLayerSettingEXT *setting : this->api_settings) {
+        if (setting->pLayerName == this->layer_name) {
+            setting_names.push_back(setting->pSettingName);
+        }
+    }
+
+    const SettingsFile *settings_files[] = {&this->GetSettingsFile(), &this->setting_file_values,
+                                            this->overlay_file.load(std::memory_order_seq_cst)};
+    for (const SettingsFile *settings_file : settings_files) {
+        if (settings_file == nullptr) {
+            continue;
+        }
+
+        for (const SettingsFile::Entry &entry : settings_file->GetEntries()) {
+            if (entry.key.compare(0, this->file_setting_prefix.size(), this->file_setting_prefix) == 0) {
+                setting_names.emplace_back(entry.key.substr(this->file_setting_prefix.size()));
+            }
+        }
+    }
+
+    // Environment variable names are upper case versions of the setting names
+    for (const EnvSetting &env_setting : this->env_settings) {
+        if (namespace_env_settings || env_setting.layer_owned) {
+            setting_names.push_back(vl::ToLower(std::string(env_setting.name)));
+        }
+    }
+
+    return setting_names;
+}
+
+// Large enough for a double in fixed notation, which has up to 309 integer digits or 340 significant decimals
+static const std::size_t FINGERPRINT_BUFFER_SIZE = 1024;
+
+// Floats with the fewest decimals which parse back to the same value, with at least one: "1.0" for 1.0f and
+// "1.0000001" for 1.0000001f, as written in vk_layer_settings.txt and environment variables
+template <typename T>
+static std::string_view FormatFingerprintFloat(char (&buffer)[FINGERPRINT_BUFFER_SIZE], T value) {
+    std::size_t size = 0;
+    if (!std::isfinite(value)) {
+        size = static_cast<std::size_t>(std::max(std::snprintf(buffer, FINGERPRINT_BUFFER_SIZE, "%f", static_cast<double>(value)), 0));
+        return std::string_view(buffer, size);
+    }
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    const std::to_chars_result result = std::to_chars(buffer, buffer + FINGERPRINT_BUFFER_SIZE - 2, value, std::chars_format::fixed);
+    size = static_cast<std::size_t>(result.ptr - buffer);
+#else
+    for (int precision = 0; precision < 400; ++precision) {
+        size = static_cast<std::size_t>(
+            std::max(std::snprintf(buffer, FINGERPRINT_BUFFER_SIZE - 2, "%.*f", precision, static_cast<double>(value)), 0));
+        if (static_cast<T>(std::strtod(buffer, nullptr)) == value) {
+            break;
+        }
+    }
+#endif
+
+    if (std::memchr(buffer, '.', size) == nullptr) {
+        buffer[size++] = '.';
+        buffer[size++] = '0';
+    }
+    return std::string_view(buffer, size);
+}
+
+template <typename T>
+static uint64_t FingerprintLayerSettingNumbers(uint64_t fingerprint, const VkLayerSettingEXT &api_setting) {
+    char buffer[FINGERPRINT_BUFFER_SIZE];
+    for (uint32_t i = 0; i < api_setting.count; ++i) {
+        const T value = static_cast<const T *>(api_setting.pValues)[i];
+        if constexpr (std::is_floating_point<T>::value) {
+            fingerprint = vl::HashCombine(fingerprint, vl::HashString(FormatFingerprintFloat(buffer, value)));
+        } else {
+            const std::to_chars_result result = std::to_chars(buffer, buffer + FINGERPRINT_BUFFER_SIZE, value);
+            fingerprint = vl::HashCombine(fingerprint, vl::HashString(std::string_view(buffer, static_cast<std::size_t>(result.ptr - buffer))));
+        }
+    }
+    return fingerprint;
+}
+
+uint64_t FingerprintLayerSetting(uint64_t fingerprint, std::string_view setting_name, const VkLayerSettingEXT *api_setting,
+                                 uint32_t value_count, const char *const *pValues) {
+    // Setting names are case insensitive, the names of environment variables are lower case
+    fingerprint = vl::HashCombine(fingerprint, vl::HashSettingName(setting_name));
+
+    if (api_setting != nullptr && api_setting->type != VK_LAYER_SETTING_TYPE_STRING_EXT) {
+        fingerprint = vl::HashCombine(fingerprint, api_setting->count);
+        switch (api_setting->type) {
+            case VK_LAYER_SETTING_TYPE_BOOL32_EXT:
+                for (uint32_t i = 0; i < api_setting->count; ++i) {
+                    const bool value = static_cast<const VkBool32 *>(api_setting->pValues)[i] == VK_TRUE;
+                    fingerprint = vl::HashCombine(fingerprint, vl::HashString(value ? "true" : "false"));
+                }
+                return fingerprint;
+            case VK_LAYER_SETTING_TYPE_INT32_EXT:
+                return FingerprintLayerSettingNumbers<int32_t>(fingerprint, *api_setting);
+            case VK_LAYER_SETTING_TYPE_INT64_EXT:
+                return FingerprintLayerSettingNumbers<int64_t>(fingerprint, *api_setting);
+            case VK_LAYER_SETTING_TYPE_UINT32_EXT:
+                return FingerprintLayerSettingNumbers<uint32_t>(fingerprint, *api_setting);
+            case VK_LAYER_SETTING_TYPE_UINT64_EXT:
+                return FingerprintLayerSettingNumbers<uint64_t>(fingerprint, *api_setting);
+            case VK_LAYER_SETTING_TYPE_FLOAT32_EXT:
+                return FingerprintLayerSettingNumbers<float>(fingerprint, *api_setting);
+            case VK_LAYER_SETTING_TYPE_FLOAT64_EXT:
+                return FingerprintLayerSettingNumbers<double>(fingerprint, *api_setting);
+            default:
+                return fingerprint;
+        }
+    }
+
+    fingerprint = vl::HashCombine(fingerprint, value_count);
+    for (uint32_t i = 0; i < value_count; ++i) {
+        fingerprint = vl::HashCombine(fingerprint, vl::HashString(pValues[i]));
+    }
+    return fingerprint;
+}
+
+bool LayerSettings::FindFingerprint(uint64_t source_generation, uint64_t &fingerprint) {
+    std::lock_guard<std::mutex> lock(this->fingerprint_mutex);
+
+    fingerprint = this->fingerprint;
+    return this->fingerprint_generation == source_generation;
+}
+
+void LayerSettings::CacheFingerprint(uint64_t source_generation, uint64_t fingerprint) {
+    std::lock_guard<std::mutex> lock(this->fingerprint_mutex);
+
+    this->fingerprint_generation = source_generation;
+    this->fingerprint = fingerprint;
+}
+
+std::vector<VlLayerSettingInfo> LayerSettings::EnumerateSettings(std::string_view prefix, bool namespace_env_settings) {
+    std::vector<VlLayerSettingInfo> settings;
+
+    const FrozenLayerSettings *frozen_settings = this->GetFrozenSettings();
+    if (frozen_settings != nullptr) {
+        const auto &sorted_settings = frozen_settings->sorted_settings;
+        auto it = std::lower_bound(sorted_settings.begin(), sorted_settings.end(), prefix,
+                                   [](const ResolvedSetting *setting, std::string_view name) { return std::string_view(setting->name) < name; });
+        for (; it != sorted_settings.end() && (*it)->name.compare(0, prefix.size(), prefix) == 0; ++it) {
+            if (!namespace_env_settings && !(*it)->enumerated) {
+                continue;
             }
+            // Interned, the frozen settings are released when frozen again
+            settings.push_back(VlLayerSettingInfo{this->string_pool.Intern((*it)->name).data(), (*it)->value.source});
+        }
+        return settings;
+    }
+
+    std::vector<std::string> setting_names = this->GetSettingNames(namespace_env_settings);
+    std::sort(setting_names.begin(), setting_names.end());
+    setting_names.erase(std::unique(setting_names.begin(), setting_names.end()), setting_names.end());
+
+    auto it = std::lower_bound(setting_names.begin(), setting_names.end(), prefix,
+                               [](const std::string &setting_name, std::string_view name) { return setting_name < name; });
+    for (; it != setting_names.end() && it->compare(0, prefix.size(), prefix) == 0; ++it) {
+        const LayerSettingValue &value =
+            this->resolved_snapshot ? this->GetResolvedSetting(it->c_str()).value : this->GetSettingValue(it->c_str());
+        if (value.found) {
+            settings.push_back(VlLayerSettingInfo{this->string_pool.Intern(*it).data(), value.source});
         }
     }
+
+    return settings;
+}
+
+const ResolvedSetting *FrozenLayerSettings::Find(const char *pSettingName) const {
+    return this->Find(pSettingName, vl::HashSettingName(pSettingName));
+}
+
+const ResolvedSetting *FrozenLayerSettings::Find(const char *pSettingName, uint64_t setting_name_hash) const {
+    const uint32_t position = this->index.Find(
+        setting_name_hash, [&](uint32_t position) { return this->settings[position]->name == pSettingName; });
+
+    return position == HashIndex::NOT_FOUND ? nullptr : this->settings[position].get();
+}
+
+void LayerSettings::SetSettingsChangedCallback(VlLayerSettingsChangedCallback pChangedCallback, void *pUserData) {
+    std::lock_guard<std::mutex> lock(this->watch_mutex);
+
+    this->pChangedCallback = pChangedCallback;
+    this->pChangedUserData = pUserData;
 }
 
 std::filesystem::path LayerSettings::FindSettingsFile() {
@@ -174,9 +813,9 @@ std::filesystem::path LayerSettings::FindSettingsFile() {
     }
 #else
     // Look for VkConfig-specific settings location specified in a specific spot in the linux settings store
-    std::string search_path = GetEnvironment("XDG_DATA_HOME");
+    std::string search_path = this->ReadEnvironment("XDG_DATA_HOME");
     if (search_path == "") {
-        search_path = GetEnvironment("HOME");
+        search_path = this->ReadEnvironment("HOME");
         if (search_path != "") {
             search_path += "/.local/share";
         }
@@ -193,10 +832,10 @@ std::filesystem::path LayerSettings::FindSettingsFile() {
 #endif
 
 #ifdef __ANDROID__
-    std::string env_path = GetEnvironment("debug.vulkan.khronos_profiles.settings_path");
+    std::string env_path = this->ReadEnvironment("debug.vulkan.khronos_profiles.settings_path");
 #else
     // Look for an environment variable override for the settings file location
-    std::string env_path = GetEnvironment("VK_LAYER_SETTINGS_PATH");
+    std::string env_path = this->ReadEnvironment("VK_LAYER_SETTINGS_PATH");
 #endif
 
     // If the path exists use it, else use vk_layer_settings
@@ -219,125 +858,404 @@ std::filesystem::path LayerSettings::FindSettingsFile() {
     return "vk_layer_settings.txt";
 }
 
-const VkLayerSettingEXT *LayerSettings::FindLayerSettingValue(const char *pSettingName) {
-    if (this->create_info == nullptr) {
-        return nullptr;
+void LayerSettings::ResolveSnapshot() {
+    this->resolved_snapshot = true;
+
+    // Merge every setting of the sources at creation: VK_EXT_layer_settings values, vk_layer_settings.txt keys of this
+    // layer and the indexed environment variables. Android system properties can't be enumerated, they are resolved on
+    // their first query.
+    for (const std::string &setting_name : this->GetSettingNames(true)) {
+        this->GetResolvedSetting(setting_name.c_str());
     }
+}
 
-    const std::string setting_name(pSettingName);
+ResolvedSetting &LayerSettings::GetResolvedSetting(const char *pSettingName) {
+    assert(pSettingName != nullptr);
 
-    for (std::size_t i = 0, n = this->create_info->settingCount; i < n; ++i) {
-        const VkLayerSettingEXT *setting = &this->create_info->pSettings[i];
-        if (setting->pLayerName != this->layer_name) {
-            continue;
+    const auto it = this->resolved_settings.find(pSettingName);
+    if (it != this->resolved_settings.end()) {
+        return *it->second;
+    }
+
+    // Names no source sets aren't added, so that querying unknown settings doesn't grow the snapshot
+    const uint64_t setting_name_hash = vl::HashSettingName(pSettingName);
+    if (!this->MayHaveSetting(setting_name_hash)) {
+        return this->unset_setting;
+    }
+
+    ArenaPtr<ResolvedSetting> resolved_setting = MakeArenaPtr<ResolvedSetting>(this->arena, &this->arena);
+    resolved_setting->name = pSettingName;
+    resolved_setting->value = this->GetSettingValue(pSettingName, setting_name_hash);
+    if (!resolved_setting->value.found) {
+        return this->unset_setting;
+    }
+
+    ResolvedSetting &result = *resolved_setting;
+    this->resolved_settings.emplace(result.name, std::move(resolved_setting));
+    return result;
+}
+
+LayerSettingValue LayerSettings::GetSettingValue(const char *pSettingName) {
+    assert(pSettingName != nullptr);
+
+    return this->GetSettingValue(pSettingName, vl::HashSettingName(pSettingName));
+}
+
+LayerSettingValue LayerSettings::GetSettingValue(const char *pSettingName, uint64_t setting_name_hash) {
+    assert(pSettingName != nullptr);
+
+    LayerSettingValue result(&this->arena);
+
+    if (!this->MayHaveSetting(setting_name_hash)) {
+        return result;
+    }
+
+    // First: search in the environment variables
+#if defined(__ANDROID__)
+    const std::string &env_setting_list = this->GetEnvSetting(pSettingName);
+    const bool has_env_setting = this->HasEnvSetting(pSettingName);
+#else
+    const EnvSetting *env_setting = this->FindEnvSetting(pSettingName, setting_name_hash);
+    const std::string_view env_setting_list = env_setting == nullptr ? std::string_view() : env_setting->value;
+    const bool has_env_setting = env_setting != nullptr;
+#endif
+
+    // Second: search in vk_layer_settings.txt
+    const SettingsFile::Entry *file_setting = this->FindFileSetting(pSettingName);
+
+    // Third: search from VK_EXT_layer_settings usage
+    result.api_setting = this->FindLayerSettingValue(pSettingName, setting_name_hash);
+
+    // The settings overlay is placed among the other sources by its priority
+    const SettingsFile::Entry *overlay_setting = this->FindOverlaySetting(pSettingName);
+    const VlLayerSettingsOverlayPriority overlay_priority =
+        overlay_setting == nullptr ? VL_LAYER_SETTINGS_OVERLAY_PRIORITY_MAX_ENUM : this->overlay_priority;
+
+    result.found = has_env_setting || file_setting != nullptr || result.api_setting != nullptr || overlay_setting != nullptr;
+
+    // Environment variables overrides the values set by vk_layer_settings
+    if (overlay_priority == VL_LAYER_SETTINGS_OVERLAY_PRIORITY_HIGHEST) {
+        result.list = overlay_setting->value;
+        result.source = VL_LAYER_SETTING_SOURCE_OVERLAY;
+    } else if (!env_setting_list.empty()) {
+        result.list = env_setting_list;
+        result.source = VL_LAYER_SETTING_SOURCE_ENV;
+    } else if (overlay_priority == VL_LAYER_SETTINGS_OVERLAY_PRIORITY_BELOW_ENV) {
+        result.list = overlay_setting->value;
+        result.source = VL_LAYER_SETTING_SOURCE_OVERLAY;
+    } else if (file_setting != nullptr) {
+        result.list = file_setting->value;
+        result.source = VL_LAYER_SETTING_SOURCE_FILE;
+    } else if (overlay_priority == VL_LAYER_SETTINGS_OVERLAY_PRIORITY_BELOW_FILE ||
+               (overlay_priority == VL_LAYER_SETTINGS_OVERLAY_PRIORITY_LOWEST && result.api_setting == nullptr)) {
+        result.list = overlay_setting->value;
+        result.source = VL_LAYER_SETTING_SOURCE_OVERLAY;
+    } else if (result.api_setting != nullptr) {
+        result.source = VL_LAYER_SETTING_SOURCE_API;
+    }
+    result.delimiter = vl::FindDelimiter(result.list);
+    result.count = vl::CountListValues(result.list, result.delimiter);
+
+    return result;
+}
+
+void LayerSettings::IndexAPISettings(const VkLayerSettingsCreateInfoEXT *pCreateInfo) {
+    std::size_t setting_count = 0;
+    for (const VkLayerSettingsCreateInfoEXT *create_info = pCreateInfo; create_info != nullptr;
+         create_info = vl::FindSettingsInChain(create_info->pNext)) {
+        setting_count += create_info->settingCount;
+    }
+
+    this->api_settings.reserve(setting_count);
+    this->api_setting_index.Reserve(setting_count);
+
+    for (const VkLayerSettingsCreateInfoEXT *create_info = pCreateInfo; create_info != nullptr;
+         create_info = vl::FindSettingsInChain(create_info->pNext)) {
+        for (std::size_t i = 0, n = create_info->settingCount; i < n; ++i) {
+            const VkLayerSettingEXT *setting = &create_info->pSettings[i];
+            if (setting->pLayerName == nullptr || setting->pSettingName == nullptr) {
+                continue;
+            }
+
+            const uint64_t hash =
+                vl::HashCombine(vl::HashSettingName(setting->pLayerName), vl::HashSettingName(setting->pSettingName));
+
+            // When a setting is provided multiple times, the first occurrence is used
+            const bool inserted = this->api_setting_index.Insert(
+                hash, static_cast<uint32_t>(this->api_settings.size()), [&](uint32_t position) {
+                    return std::strcmp(this->api_settings[position]->pSettingName, setting->pSettingName) == 0 &&
+                           std::strcmp(this->api_settings[position]->pLayerName, setting->pLayerName) == 0;
+                });
+            if (inserted) {
+                this->api_settings.push_back(setting);
+            }
         }
+    }
+}
 
-        if (setting->pSettingName != setting_name) {
-            continue;
+void LayerSettings::IndexEnvSettings() {
+#if !defined(__ANDROID__)
+    std::vector<std::string> layer_names;
+    layer_names.emplace_back(this->layer_name.data(), this->layer_name.size());
+    ::AddWorkaroundLayerNames(layer_names);
+
+    // Prefixes in lookup order: VK_LUNARG_TEST_, VK_TEST_ and VK_ for VK_LAYER_LUNARG_test
+    std::vector<std::string> prefixes;
+    for (std::size_t layer_index = 0, layer_count = layer_names.size(); layer_index < layer_count; ++layer_index) {
+        for (int i = TRIM_FIRST, n = TRIM_LAST; i <= n; ++i) {
+            prefixes.push_back(GetEnvSettingName(layer_names[layer_index].c_str(), "", static_cast<TrimMode>(i)));
+        }
+    }
+
+    // Views of the environment settings point in the strings, only create them once every variable is stored
+    this->Count(&LayerSettingStatistics::getenv_count);
+    GetEnvironmentVariables("VK_", this->env_variables);
+    this->env_setting_index.Reserve(this->env_variables.size());
+
+    for (const ArenaString &variable : this->env_variables) {
+        const std::size_t separator = variable.find('=');
+        if (separator == std::string::npos || separator + 1 == variable.size()) {
+            continue;  // Empty values are ignored
+        }
+
+        const std::string_view variable_name(variable.data(), separator);
+        const std::string_view variable_value(variable.data() + separator + 1, variable.size() - separator - 1);
+
+        // A variable is indexed under every matching prefix, but only its most specific prefix names a setting of the
+        // layer: VK_LUNARG_TEST_MY_SETTING is enumerated as my_setting, not lunarg_test_my_setting of the VK_ prefix
+        uint32_t most_specific = HashIndex::NOT_FOUND;
+        for (uint32_t priority = 0, priority_count = static_cast<uint32_t>(prefixes.size()); priority < priority_count; ++priority) {
+            if (IsEnvironmentPrefix(variable_name, prefixes[priority]) &&
+                (most_specific == HashIndex::NOT_FOUND || prefixes[priority].size() > prefixes[most_specific].size())) {
+                most_specific = priority;
+            }
         }
 
-        return setting;
+        for (uint32_t priority = 0, priority_count = static_cast<uint32_t>(prefixes.size()); priority < priority_count; ++priority) {
+            if (!IsEnvironmentPrefix(variable_name, prefixes[priority])) {
+                continue;
+            }
+
+            const bool layer_owned = priority == most_specific && priority % (TRIM_LAST + 1) != TRIM_NAMESPACE;
+            const EnvSetting env_setting{variable_name.substr(prefixes[priority].size()), variable_value, priority, layer_owned};
+            const uint64_t hash = vl::HashSettingName(env_setting.name);
+            const auto equal = [&](uint32_t position) { return this->env_settings[position].name == env_setting.name; };
+
+            const uint32_t position = this->env_setting_index.Find(hash, equal);
+            if (position == HashIndex::NOT_FOUND) {
+                this->env_setting_index.Insert(hash, static_cast<uint32_t>(this->env_settings.size()), equal);
+                this->env_settings.push_back(env_setting);
+                continue;
+            }
+
+            EnvSetting &indexed_setting = this->env_settings[position];
+            const bool indexed_layer_owned = indexed_setting.layer_owned;
+            if (priority < indexed_setting.priority) {
+                indexed_setting = env_setting;
+            }
+            indexed_setting.layer_owned = layer_owned || indexed_layer_owned;
+        }
     }
+#endif
+}
 
+const LayerSettings::EnvSetting *LayerSettings::FindEnvSetting(const char *pSettingName, uint64_t setting_name_hash) const {
+#if defined(__ANDROID__)
+    (void)pSettingName;
+    (void)setting_name_hash;
     return nullptr;
+#else
+    this->Count(&LayerSettingStatistics::env_lookup_count);
+
+    const uint32_t position = this->env_setting_index.Find(setting_name_hash, [&](uint32_t position) {
+        return IsEnvironmentSettingName(this->env_settings[position].name, pSettingName);
+    });
+
+    return position == HashIndex::NOT_FOUND ? nullptr : &this->env_settings[position];
+#endif
 }
 
-void LayerSettings::Log(const char *pSettingName, const char * pMessage) {
-    this->last_log_setting = pSettingName;
-    this->last_log_message = pMessage;
+const SettingsFile::Entry *LayerSettings::FindFileSetting(const char *pSettingName) const {
+    this->Count(&LayerSettingStatistics::file_lookup_count);
 
-    if (this->pCallback == nullptr) {
-        fprintf(stderr, "LAYER SETTING (%s) error: %s\n", this->last_log_setting.c_str(), this->last_log_message.c_str());
+    const SettingsFile::Entry *entry =
+        this->GetSettingsFile().Find(this->file_setting_prefix, this->file_setting_prefix_hash, pSettingName);
+    if (entry != nullptr) {
+        return entry;
+    }
+
+    return this->setting_file_values.Find(this->file_setting_prefix, this->file_setting_prefix_hash, pSettingName);
+}
+
+const SettingsFile::Entry *LayerSettings::FindOverlaySetting(const char *pSettingName) const {
+    const SettingsFile *overlay_file = this->overlay_file.load(std::memory_order_seq_cst);
+    if (overlay_file == nullptr) {
+        return nullptr;
+    }
+
+    return overlay_file->Find(this->file_setting_prefix, this->file_setting_prefix_hash, pSettingName);
+}
+
+const VkLayerSettingEXT *LayerSettings::FindLayerSettingValue(const char *pSettingName, uint64_t setting_name_hash) {
+    this->Count(&LayerSettingStatistics::api_lookup_count);
+
+    const uint64_t hash = vl::HashCombine(this->layer_name_hash, setting_name_hash);
+
+    const uint32_t position = this->api_setting_index.Find(hash, [&](uint32_t position) {
+        return std::strcmp(this->api_settings[position]->pSettingName, pSettingName) == 0 &&
+               this->layer_name == this->api_settings[position]->pLayerName;
+    });
+
+    return position == HashIndex::NOT_FOUND ? nullptr : this->api_settings[position];
+}
+
+static thread_local ArenaVector<ArenaString> *log_capture = nullptr;
+
+void LayerSettings::CaptureLog(ArenaVector<ArenaString> *pMessages) { log_capture = pMessages; }
+
+void LayerSettings::Log(const char *pSettingName, const char * pMessage) {
+    if (log_capture != nullptr) {
+        log_capture->emplace_back(pMessage);
+    } else if (this->log_sink != nullptr) {
+        this->log_sink->Log(pSettingName, pMessage);
+    } else if (this->pCallback == nullptr) {
+        fprintf(stderr, "LAYER SETTING (%s) error: %s\n", pSettingName, pMessage);
     } else {
-        this->pCallback(this->last_log_setting.c_str(), this->last_log_message.c_str());
+        this->pCallback(pSettingName, pMessage);
     }
 }
 
-std::vector<std::string> &LayerSettings::GetSettingCache(const std::string &settingName) {
-    if (this->string_setting_cache.find(settingName) != this->string_setting_cache.end()) {
-        this->string_setting_cache.insert(
-            std::pair<std::string, std::vector<std::string>>(settingName, std::vector<std::string>()));
+LayerSettingStrings &LayerSettings::GetSettingStrings(std::string_view settingName) {
+    const auto it = this->setting_strings.find(settingName);
+    if (it != this->setting_strings.end()) {
+        return it->second;
     }
 
-    return this->string_setting_cache[settingName];
+    return this->setting_strings
+        .emplace(std::piecewise_construct, std::forward_as_tuple(settingName, ArenaAllocator<char>(&this->arena)),
+                 std::forward_as_tuple(&this->arena))
+        .first->second;
 }
 
 bool LayerSettings::HasEnvSetting(const char *pSettingName) {
     assert(pSettingName != nullptr);
 
+#if defined(__ANDROID__)
+    // Android system properties are looked up directly, __system_property_find is already a hash lookup
+    this->Count(&LayerSettingStatistics::env_lookup_count);
+
     std::vector<std::string> layer_names;
-    layer_names.push_back(this->layer_name);
+    layer_names.emplace_back(this->layer_name.data(), this->layer_name.size());
     ::AddWorkaroundLayerNames(layer_names);
 
     for (std::size_t layer_index = 0, layer_count = layer_names.size(); layer_index < layer_count; ++layer_index) {
         const char *cur_layer_name = layer_names[layer_index].c_str();
         for (int i = TRIM_FIRST, n = TRIM_LAST; i <= n; ++i) {
             const std::string &env_name = GetEnvSettingName(cur_layer_name, pSettingName, static_cast<TrimMode>(i));
-            if (IsEnvironment(env_name.c_str())) {
+            if (!this->ReadEnvironment(env_name.c_str()).empty()) {
                 return true;
             }
         }
     }
 
     return false;
+#else
+    return this->FindEnvSetting(pSettingName, vl::HashSettingName(pSettingName)) != nullptr;
+#endif
+}
+
+bool LayerSettings::MayHaveSetting(uint64_t setting_name_hash) const {
+#if defined(__ANDROID__)
+    // Android system properties can't be enumerated to fill the filter
+    (void)setting_name_hash;
+    return true;
+#else
+    this->GetSettingsFile();  // The filter is filled once the settings file is parsed
+    return this->setting_name_filter.MayContain(setting_name_hash);
+#endif
 }
 
-bool LayerSettings::HasFileSetting(const char *pSettingName) { 
+bool LayerSettings::HasSetting(const char *pSettingName) {
     assert(pSettingName != nullptr);
 
-    std::string file_setting_name = vl::GetFileSettingName(this->layer_name.c_str(), pSettingName);
+    if (!this->MayHaveSetting(vl::HashSettingName(pSettingName))) {
+        return false;
+    }
+
+    return this->HasEnvSetting(pSettingName) || this->HasFileSetting(pSettingName) || this->HasAPISetting(pSettingName) ||
+           this->HasOverlaySetting(pSettingName);
+}
+
+bool LayerSettings::HasFileSetting(const char *pSettingName) {
+    assert(pSettingName != nullptr);
 
-    return setting_file_values.find(file_setting_name) != setting_file_values.end();
+    return this->FindFileSetting(pSettingName) != nullptr;
 }
 
 bool LayerSettings::HasAPISetting(const char *pSettingName) {
     assert(pSettingName != nullptr);
 
-    return this->FindLayerSettingValue(pSettingName) != nullptr;
+    return this->FindLayerSettingValue(pSettingName, vl::HashSettingName(pSettingName)) != nullptr;
+}
+
+bool LayerSettings::HasOverlaySetting(const char *pSettingName) {
+    assert(pSettingName != nullptr);
+
+    return this->FindOverlaySetting(pSettingName) != nullptr;
 }
 
 std::string LayerSettings::GetEnvSetting(const char *pSettingName) {
-    std::string result;
+    assert(pSettingName != nullptr);
+
+#if defined(__ANDROID__)
+    this->Count(&LayerSettingStatistics::env_lookup_count);
 
     std::vector<std::string> layer_names;
-    layer_names.push_back(this->layer_name);
+    layer_names.emplace_back(this->layer_name.data(), this->layer_name.size());
     ::AddWorkaroundLayerNames(layer_names);
 
     for (std::size_t layer_index = 0, layer_count = layer_names.size(); layer_index < layer_count; ++layer_index) {
         const char* cur_layer_name = layer_names[layer_index].c_str();
         for (int i = TRIM_FIRST, n = TRIM_LAST; i <= n; ++i) {
             const std::string &env_name = GetEnvSettingName(cur_layer_name, pSettingName, static_cast<TrimMode>(i));
-            result = GetEnvironment(env_name.c_str());
+            const std::string &result = this->ReadEnvironment(env_name.c_str());
             if (!result.empty()) {
-                break;
+                return result;
             }
         }
     }
 
-    return result;
+    return "";
+#else
+    const EnvSetting *env_setting = this->FindEnvSetting(pSettingName, vl::HashSettingName(pSettingName));
+    return env_setting == nullptr ? "" : std::string(env_setting->value);
+#endif
 }
 
 std::string LayerSettings::GetFileSetting(const char *pSettingName) {
-    const std::string file_setting_name = vl::GetFileSettingName(this->layer_name.c_str(), pSettingName);
+    const SettingsFile::Entry *entry = this->FindFileSetting(pSettingName);
 
-    std::map<std::string, std::string>::const_iterator it;
-    if ((it = this->setting_file_values.find(file_setting_name)) == this->setting_file_values.end()) {
-        return "";
-    } else {
-        return it->second;
-    }
+    return entry == nullptr ? "" : std::string(entry->value);
 }
 
 void LayerSettings::SetFileSetting(const char *pSettingName, const std::string &pValues) {
     assert(pSettingName != nullptr);
 
-    this->setting_file_values.insert({pSettingName, pValues});
+    if (this->GetSettingsFile().Find(pSettingName) == nullptr) {
+        this->setting_file_values.Insert(pSettingName, pValues);
+        this->source_generation.fetch_add(1, std::memory_order_release);
+
+        const std::string_view setting_name(pSettingName);
+        if (setting_name.compare(0, this->file_setting_prefix.size(), this->file_setting_prefix) == 0) {
+            this->setting_name_filter.Insert(vl::HashSettingName(setting_name.substr(this->file_setting_prefix.size())));
+        }
+    }
 }
 
 const VkLayerSettingEXT *LayerSettings::GetAPISetting(const char *pSettingName) { 
     assert(pSettingName != nullptr);
 
-    return reinterpret_cast<const VkLayerSettingEXT *>(this->FindLayerSettingValue(pSettingName));
+    return reinterpret_cast<const VkLayerSettingEXT *>(this->FindLayerSettingValue(pSettingName, vl::HashSettingName(pSettingName)));
 }
 
 }  // namespace vl
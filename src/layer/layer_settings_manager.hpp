@@ -9,17 +9,168 @@
 #pragma once
 
 #include "vulkan/layer/vk_layer_settings.h"
+#include "layer_settings_arena.hpp"
+#include "layer_settings_epoch.hpp"
+#include "layer_settings_file.hpp"
+#include "layer_settings_index.hpp"
+#include "layer_settings_log.hpp"
+#include "layer_settings_overlay.hpp"
+#include "layer_settings_strings.hpp"
+#include "layer_settings_watcher.hpp"
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <filesystem>
+#include <thread>
 
 namespace vl {
+    const std::size_t LAYER_SETTING_TYPE_COUNT = VL_LAYER_SETTING_TYPE_FRAMESET_STRING + 1;
+
+    // Values of a setting once every source is merged.
+    // Environment variables override vk_layer_settings.txt which overrides VK_EXT_layer_settings. The settings overlay
+    // takes the priority it was attached with.
+    struct LayerSettingValue {
+        LayerSettingValue() = default;
+        explicit LayerSettingValue(Arena *arena) : list(ArenaAllocator<char>(arena)) {}
+
+        bool found{false};
+        ArenaString list;  // Values from env variable or setting file, 'count' values separated by 'delimiter'
+        char delimiter{','};
+        uint32_t count{0};
+        const VkLayerSettingEXT *api_setting{nullptr};
+        VlLayerSettingSource source{VL_LAYER_SETTING_SOURCE_MAX_ENUM};  // Source of the values, once found
+    };
+
+    // vlGetLayerSettingValues result recorded by the resolved snapshot for one setting type
+    struct LayerSettingTypedValues {
+        explicit LayerSettingTypedValues(Arena *arena)
+            : data(ArenaAllocator<uint8_t>(arena)),
+              log_messages(ArenaAllocator<ArenaString>(arena)) {}
+
+        VkResult count_result{VK_SUCCESS};
+        VkResult result{VK_SUCCESS};
+        uint32_t count{0};
+        ArenaVector<uint8_t> data;
+        ArenaVector<ArenaString> log_messages;  // Logged by the conversion, logged again by each query
+    };
+
+    // Interned values of the last VL_LAYER_SETTING_TYPE_STRING or FRAMESET_STRING query of a setting, returned again
+    // while the values of the setting don't change
+    struct LayerSettingStrings {
+        explicit LayerSettingStrings(Arena *arena) : list(ArenaAllocator<char>(arena)), values(ArenaAllocator<const char *>(arena)) {}
+
+        bool IsInternedFrom(const LayerSettingValue &value, VlLayerSettingType value_type) const {
+            return this->type == value_type && this->api_setting == value.api_setting && this->list == value.list;
+        }
+
+        VlLayerSettingType type{VL_LAYER_SETTING_TYPE_STRING};
+        const VkLayerSettingEXT *api_setting{nullptr};
+        ArenaString list;
+        ArenaVector<const char *> values;
+    };
+
+    struct ResolvedSetting {
+        explicit ResolvedSetting(Arena *arena) : name(ArenaAllocator<char>(arena)), value(arena) {}
+
+        ArenaString name;
+        LayerSettingValue value;
+        std::array<ArenaPtr<LayerSettingTypedValues>, LAYER_SETTING_TYPE_COUNT> typed_values;
+        bool enumerated{true};  // False for the settings only set by VK_ names of environment variables, see Freeze
+    };
+
+    // Settings of a frozen layer setting set with their values resolved for every type. Immutable once published.
+    struct FrozenLayerSettings {
+        explicit FrozenLayerSettings(Arena *arena)
+            : settings(ArenaAllocator<ArenaPtr<ResolvedSetting>>(arena)),
+              index(arena),
+              sorted_settings(ArenaAllocator<const ResolvedSetting *>(arena)),
+              late_settings(ArenaAllocator<char>(arena)) {}
+
+        ArenaVector<ArenaPtr<ResolvedSetting>> settings;
+        HashIndex index;
+        ArenaVector<const ResolvedSetting *> sorted_settings;  // Settings set by a source, sorted by name
+        uint64_t fingerprint{0};                               // See vlGetLayerSettingsFingerprint
+
+        // Settings found after freezing, such as names with a different case. Guarded by the frozen mutex.
+        mutable std::map<ArenaString, ArenaPtr<ResolvedSetting>, ArenaStringLess,
+                         ArenaAllocator<std::pair<const ArenaString, ArenaPtr<ResolvedSetting>>>>
+            late_settings;
+
+        const ResolvedSetting *Find(const char *pSettingName) const;
+        const ResolvedSetting *Find(const char *pSettingName, uint64_t setting_name_hash) const;
+    };
+
+    // Counters of VL_LAYER_SETTING_SET_CREATE_STATISTICS_BIT, updated concurrently by the queries of a frozen set
+    struct LayerSettingStatistics {
+        std::atomic<uint64_t> env_lookup_count{0};
+        std::atomic<uint64_t> file_lookup_count{0};
+        std::atomic<uint64_t> api_lookup_count{0};
+        std::atomic<uint64_t> cache_hit_count{0};
+        std::atomic<uint64_t> cache_miss_count{0};
+        std::atomic<uint64_t> getenv_count{0};
+        std::atomic<uint64_t> parse_failure_count{0};
+        std::atomic<uint64_t> find_settings_file_ns{0};
+        std::atomic<uint64_t> parse_settings_file_ns{0};
+        std::atomic<uint64_t> get_values_count{0};
+        std::atomic<uint64_t> get_values_ns{0};
+    };
+
+    using LayerSettingCounter = std::atomic<uint64_t> LayerSettingStatistics::*;
+
+    // Add the nanoseconds elapsed until its destruction to a counter, the clock isn't read without statistics
+    class StatisticsTimer {
+      public:
+        StatisticsTimer(LayerSettingStatistics *statistics, LayerSettingCounter counter)
+            : statistics(statistics), counter(counter) {
+            if (statistics != nullptr) {
+                this->begin = std::chrono::steady_clock::now();
+            }
+        }
+
+        ~StatisticsTimer() {
+            if (this->statistics != nullptr) {
+                const auto elapsed = std::chrono::steady_clock::now() - this->begin;
+                (this->statistics->*this->counter)
+                    .fetch_add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+                               std::memory_order_relaxed);
+            }
+        }
+
+        StatisticsTimer(const StatisticsTimer &) = delete;
+        StatisticsTimer &operator=(const StatisticsTimer &) = delete;
+
+      private:
+        LayerSettingStatistics *statistics;
+        LayerSettingCounter counter;
+        std::chrono::steady_clock::time_point begin;
+    };
+
+    class LayerSettings;
+
+    // Fold a setting and its values, as returned by a VL_LAYER_SETTING_TYPE_STRING query, in a fingerprint of the
+    // settings. Settings are folded in name order, starting from a fingerprint of 0. Values of the other types set by
+    // VK_EXT_layer_settings, 'api_setting', are folded from their value as spelled in vk_layer_settings.txt: "true",
+    // "76" or "1.0", rather than as queried, "1.000000" for 1.0f.
+    uint64_t FingerprintLayerSetting(uint64_t fingerprint, std::string_view setting_name, const VkLayerSettingEXT *api_setting,
+                                     uint32_t value_count, const char *const *pValues);
+
+    // Resolve the values of every type of a setting, defined with the type conversions in vk_layer_settings.cpp
+    ArenaPtr<ResolvedSetting> ResolveLayerSetting(LayerSettings &layer_settings, const char *pSettingName);
+
     class LayerSettings {
       public:
         LayerSettings(const char *pLayerName, const VkLayerSettingsCreateInfoEXT *pCreateInfo,
-                      const VkAllocationCallbacks *pAllocator, VlLayerSettingLogCallback pCallback);
+                      const VkAllocationCallbacks *pAllocator, VlLayerSettingLogCallback pCallback,
+                      VlLayerSettingSetCreateFlags flags);
         ~LayerSettings();
 
 	    bool HasEnvSetting(const char *pSettingName);
@@ -28,6 +179,15 @@ namespace vl {
 
         bool HasAPISetting(const char *pSettingName);
 
+        bool HasOverlaySetting(const char *pSettingName);
+
+        // Whether any source sets the setting
+        bool HasSetting(const char *pSettingName);
+
+        // False when no source sets the setting, answered by the presence filter without looking up the sources.
+        // 'setting_name_hash' is HashSettingName(pSettingName).
+        bool MayHaveSetting(uint64_t setting_name_hash) const;
+
         std::string GetEnvSetting(const char *pSettingName);
 
         std::string GetFileSetting(const char *pSettingName);
@@ -36,25 +196,229 @@ namespace vl {
 
         const VkLayerSettingEXT *GetAPISetting(const char *pSettingName);
 
+        LayerSettingValue GetSettingValue(const char *pSettingName);
+
+        // 'setting_name_hash' is HashSettingName(pSettingName), precomputed by the settings schema of vk_layer_settings.hpp
+        LayerSettingValue GetSettingValue(const char *pSettingName, uint64_t setting_name_hash);
+
+        bool IsResolvedSnapshot() const { return this->resolved_snapshot; }
+
+        // Return the snapshot entry of a setting. Settings of the sources are resolved at creation, other case spellings
+        // of their names the first time they're queried.
+        ResolvedSetting &GetResolvedSetting(const char *pSettingName);
+
+        bool IsWatchingSettingsFile() const { return this->watching_setting_file; }
+
+        // Map the shared memory segment read by queries, see vlAttachLayerSettingsOverlay
+        VkResult AttachOverlay(const char *pSegmentName, VlLayerSettingsOverlayPriority priority);
+
+        // Load the overlay values written since the previous call, a single atomic load when the overlay is unchanged.
+        // Called as queries begin, before they lock the layer setting set. A frozen set is frozen again by the overlay
+        // thread instead, its queries read the previous frozen settings until the new ones are published.
+        void UpdateOverlay();
+
+        // Update the overlay and count the calling query as a reader of the published settings file parses and frozen
+        // settings until the returned guard is destroyed, so that they are not released while it reads them
+        SnapshotReadGuard BeginQuery() {
+            this->UpdateOverlay();
+            return SnapshotReadGuard(this->snapshot_epoch);
+        }
+
+        // Parse the settings file and write the settings of the layer to the cache loaded instead of the settings file
+        bool CompileSettingsCache() const;
+
+        // Resolve every setting so that queries no longer modify the layer setting set and can run concurrently. The
+        // frozen settings it replaces are retired, see ReleaseRetiredSnapshots.
+        void Freeze();
+
+        // Sequentially consistent with the reader count of the query, see SnapshotEpoch
+        const FrozenLayerSettings *GetFrozenSettings() const { return this->frozen_settings.load(std::memory_order_seq_cst); }
+
+        // Incremented each time the values of the settings file, the overlay or test_helper_SetLayerSetting change
+        uint64_t GetSourceGeneration() const { return this->source_generation.load(std::memory_order_acquire); }
+
+        // Fingerprint of a layer setting set which isn't frozen, cached until a source changes. Return false and leave
+        // 'fingerprint' unspecified when the cached one was computed at another 'source_generation'.
+        bool FindFingerprint(uint64_t source_generation, uint64_t &fingerprint);
+        void CacheFingerprint(uint64_t source_generation, uint64_t fingerprint);
+
+        // Setting names of the layer from every source, used to resolve the settings when freezing. The environment
+        // names which aren't the most specific name of a variable with the layer name, such as my_setting for
+        // VK_MY_SETTING or lunarg_test_my_setting for VK_LUNARG_TEST_MY_SETTING, are included only with
+        // 'namespace_env_settings': they are read when queried, but can't be told apart from the loader variables.
+        std::vector<std::string> GetSettingNames(bool namespace_env_settings) const;
+
+        // Settings set by a source which names start with 'prefix', sorted by name. Frozen sets answer from the sorted
+        // settings resolved when freezing, other sets sort the setting names of the sources and resolve the ones matching.
+        // The names only set by VK_ environment variables are included with 'namespace_env_settings', see GetSettingNames.
+        std::vector<VlLayerSettingInfo> EnumerateSettings(std::string_view prefix, bool namespace_env_settings);
+
+        // Messages logged by the calling thread go to 'pMessages' until called with nullptr
+        static void CaptureLog(ArenaVector<ArenaString> *pMessages);
+
+        // Guards the resolution of typed values once frozen
+        std::mutex &GetFrozenMutex() { return this->frozen_mutex; }
+
+        void SetSettingsChangedCallback(VlLayerSettingsChangedCallback pChangedCallback, void *pUserData);
+
         void Log(const char *pSettingName, const char *pMessage);
 
-        std::vector<std::string> &GetSettingCache(const std::string &pSettingName);
+        // nullptr unless the layer setting set was created with VL_LAYER_SETTING_SET_CREATE_ASYNC_LOG_BIT
+        LogSink *GetLogSink() const { return this->log_sink.get(); }
+
+        LayerSettingStrings &GetSettingStrings(std::string_view settingName);
+
+        StringPool &GetStringPool() { return this->string_pool; }
+
+        // Memory of the layer setting set, allocated with the VkAllocationCallbacks of the layer setting set
+        Arena &GetArena() { return this->arena; }
+
+        // nullptr unless the layer setting set was created with statistics
+        LayerSettingStatistics *GetStatistics() const { return this->statistics.get(); }
+
+        // Add to a counter of the statistics, a single test when statistics are disabled
+        void Count(LayerSettingCounter counter, uint64_t value = 1) const {
+            if (this->statistics != nullptr) {
+                (this->statistics.get()->*counter).fetch_add(value, std::memory_order_relaxed);
+            }
+        }
 
       private:
-        const VkLayerSettingEXT *FindLayerSettingValue(const char *pSettingName);
+        const VkLayerSettingEXT *FindLayerSettingValue(const char *pSettingName, uint64_t setting_name_hash);
+
+        // Index the settings of every VkLayerSettingsCreateInfoEXT of the pNext chain
+        void IndexAPISettings(const VkLayerSettingsCreateInfoEXT *pCreateInfo);
+
+        // Environment variable of a setting, without the layer prefix: MY_SETTING for VK_LUNARG_TEST_MY_SETTING.
+        // 'priority' is the position of the prefix in the lookup order of the layer names and TrimMode values.
+        struct EnvSetting {
+            std::string_view name;
+            std::string_view value;
+            uint32_t priority;
+            // The most specific name of a variable with the layer name, VK_LUNARG_TEST_ or VK_TEST_, rather than a
+            // name of the VK_ prefix, which also prefixes the variables of the loader. Every name is indexed for the
+            // queries, only the layer owned ones are enumerated.
+            bool layer_owned;
+        };
 
-        std::map<std::string, std::string> setting_file_values;
-        std::map<std::string, std::vector<std::string>> string_setting_cache;
+        const EnvSetting *FindEnvSetting(const char *pSettingName, uint64_t setting_name_hash) const;
 
-        std::string last_log_setting;
-        std::string last_log_message;
+        const SettingsFile::Entry *FindFileSetting(const char *pSettingName) const;
+
+        const SettingsFile::Entry *FindOverlaySetting(const char *pSettingName) const;
+
+        // The settings file is found and parsed once, by the first lookup reaching the file source, so that creating a
+        // layer setting set doesn't touch the file system
+        const SettingsFile &GetSettingsFile() const;
+        void LoadSettingsFile();
+
+        // Insert the setting names of the layer from every source in the presence filter, once the settings file is parsed
+        void FilterSettingNames();
+        void FilterFileSettingNames(const SettingsFile &settings_file);
+
+        // Read an environment variable, or an Android system property, counted by the statistics
+        std::string ReadEnvironment(const char *variable) const;
+
+        void LogStatistics() const;
+
+        // Scan the environment once and index the VK_ variables by setting name
+        void IndexEnvSettings();
+
+        // Declared first so that it's destroyed after every member storing memory in it
+        Arena arena;
+
+        ArenaPtr<LayerSettingStatistics> statistics;
+        bool log_statistics{false};
+        ArenaPtr<LogSink> log_sink;
+
+        mutable std::once_flag setting_file_once;
+        // Parse of the settings file read by queries without locking. A reload publishes a new parse with an atomic
+        // store and retires the previous one, released once the queries which began before the store are done. String
+        // values handed out are interned in 'string_pool', so they outlive the parses.
+        std::atomic<const SettingsFile *> setting_file{nullptr};
+        // Shared by the layer setting sets using the same file, unless the layer setting set has VkAllocationCallbacks
+        std::shared_ptr<const SettingsFile> setting_file_owner;
+        // Settings file and overlay parses replaced since the last ReleaseRetiredSnapshots. Guarded by 'watch_mutex'.
+        ArenaVector<std::shared_ptr<const SettingsFile>> retired_setting_files;
+        SettingsFile setting_file_values;                   // Values set by test_helper_SetLayerSetting
+        ArenaString file_setting_prefix;  // "lunarg_test." for VK_LAYER_LUNARG_test
+        uint64_t file_setting_prefix_hash{0};
+        // Hashes of the setting names of the layer from every source: most queries are for unset settings, which take
+        // their default value
+        PresenceFilter setting_name_filter;
+        StringPool string_pool;
+        std::map<ArenaString, LayerSettingStrings, ArenaStringLess,
+                 ArenaAllocator<std::pair<const ArenaString, LayerSettingStrings>>>
+            setting_strings;
 
         std::filesystem::path FindSettingsFile();
         void ParseSettingsFile(const std::filesystem::path &filename);
+        void ReloadSettingsFile();
+        void ResolveSnapshot();
+
+        // Release the settings file and overlay parses and frozen settings replaced since the previous call, once the
+        // queries which could read them are done. Called by writers holding 'watch_mutex' only, outside of queries.
+        void ReleaseRetiredSnapshots();
 
-        std::string layer_name;
-        const VkLayerSettingsCreateInfoEXT *create_info{nullptr};
+        // Read the overlay segment and publish its values if they changed, freezing again a frozen set
+        void LoadOverlay();
+        // Run by 'overlay_thread', loading the overlay each time a query of a frozen set requests it
+        void WatchOverlay();
+        void StopOverlay();
+
+        bool resolved_snapshot{false};
+        std::unordered_map<std::string_view, ArenaPtr<ResolvedSetting>, std::hash<std::string_view>,
+                           std::equal_to<std::string_view>,
+                           ArenaAllocator<std::pair<const std::string_view, ArenaPtr<ResolvedSetting>>>>
+            resolved_settings;
+        ResolvedSetting unset_setting;  // Returned for the names no source sets, never modified
+
+        ArenaString layer_name;
+        uint64_t layer_name_hash{0};
+        ArenaVector<const VkLayerSettingEXT *> api_settings;
+        HashIndex api_setting_index;
+        ArenaVector<ArenaString> env_variables;
+        ArenaVector<EnvSetting> env_settings;
+        HashIndex env_setting_index;
         VlLayerSettingLogCallback pCallback{nullptr};
+        bool has_allocator{false};
+
+        std::filesystem::path setting_file_path;
+        bool watching_setting_file{false};
+        std::mutex watch_mutex;  // Guards the settings file parses, the changed callback and the overlay updates
+        VlLayerSettingsChangedCallback pChangedCallback{nullptr};
+        void *pChangedUserData{nullptr};
+
+        // Frozen settings are published and retired like the settings file parse
+        std::atomic<const FrozenLayerSettings *> frozen_settings{nullptr};
+        ArenaPtr<FrozenLayerSettings> frozen_settings_owner;
+        ArenaVector<ArenaPtr<FrozenLayerSettings>> retired_frozen_settings;  // Guarded by 'frozen_mutex'
+        std::mutex frozen_mutex;
+
+        SnapshotEpoch snapshot_epoch;
+
+        FileWatcher setting_file_watcher;
+
+        ArenaPtr<SettingsOverlay> overlay;
+        VlLayerSettingsOverlayPriority overlay_priority{VL_LAYER_SETTINGS_OVERLAY_PRIORITY_HIGHEST};
+        // Values of the overlay published and retired like the settings file parse. 'overlay_sequence' is the sequence
+        // of the segment they were read at, odd until the first read since writers never leave it odd.
+        std::atomic<const SettingsFile *> overlay_file{nullptr};
+        std::shared_ptr<const SettingsFile> overlay_file_owner;
+        std::atomic<uint64_t> overlay_sequence{1};
+
+        // Loads the overlay of frozen sets off the query path, started by AttachOverlay
+        std::thread overlay_thread;
+        std::mutex overlay_mutex;  // Guards 'overlay_load_requested' and 'overlay_stopping'
+        std::condition_variable overlay_wake;
+        bool overlay_load_requested{false};
+        bool overlay_stopping{false};
+        std::atomic<bool> overlay_load_pending{false};  // Set by queries until the overlay thread takes the request
+
+        std::atomic<uint64_t> source_generation{0};
+        std::mutex fingerprint_mutex;  // Guards 'fingerprint_generation' and 'fingerprint'
+        uint64_t fingerprint_generation{UINT64_MAX};
+        uint64_t fingerprint{0};
     };
 }// namespace vl
 
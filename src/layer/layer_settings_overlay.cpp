@@ -0,0 +1,272 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "layer_settings_overlay.hpp"
+#include "layer_settings_util.hpp"
+
+#if (defined(__linux__) && !defined(__ANDROID__)) || defined(__APPLE__)
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+namespace vl {
+
+// Copies of the table overlapping a write are retried, then the previous values are kept until the next query
+static const int OVERLAY_READ_ATTEMPTS = 64;
+
+static std::string_view GetOverlayString(const char *buffer, std::size_t buffer_size) {
+    return std::string_view(buffer, strnlen(buffer, buffer_size));
+}
+
+#if (defined(__linux__) && !defined(__ANDROID__)) || defined(__APPLE__)
+
+// POSIX shared memory object names start with a slash
+static std::string GetSegmentName(const char *pSegmentName) {
+    return pSegmentName[0] == '/' ? std::string(pSegmentName) : "/" + std::string(pSegmentName);
+}
+
+// Open the segment, created and sized if needed, and map it
+static SettingsOverlaySegment *MapSegment(const char *pSegmentName, int protection) {
+    const int fd = shm_open(GetSegmentName(pSegmentName).c_str(), O_RDWR | O_CREAT, 0600);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 ||
+        (static_cast<std::size_t>(info.st_size) < sizeof(SettingsOverlaySegment) &&
+         ftruncate(fd, static_cast<off_t>(sizeof(SettingsOverlaySegment))) != 0)) {
+        close(fd);
+        return nullptr;
+    }
+
+    void *memory = mmap(nullptr, sizeof(SettingsOverlaySegment), protection, MAP_SHARED, fd, 0);
+    close(fd);
+
+    return memory == MAP_FAILED ? nullptr : static_cast<SettingsOverlaySegment *>(memory);
+}
+
+static void UnmapSegment(SettingsOverlaySegment *segment) { munmap(segment, sizeof(SettingsOverlaySegment)); }
+
+// Whether the writer recorded in the segment exited without completing its write
+static bool IsWriterDead(uint32_t writer_pid) {
+    return writer_pid != 0 && kill(static_cast<pid_t>(writer_pid), 0) != 0 && errno == ESRCH;
+}
+
+bool IsSettingsOverlaySupported() { return true; }
+
+SettingsOverlay::~SettingsOverlay() {
+    if (this->segment != nullptr) {
+        UnmapSegment(this->segment);
+    }
+}
+
+bool SettingsOverlay::Open(const char *pSegmentName) {
+    this->segment = MapSegment(pSegmentName, PROT_READ);
+    return this->segment != nullptr;
+}
+
+bool WriteSettingsOverlay(const char *pSegmentName, std::string_view key, std::string_view value) {
+    if (key.empty() || key.size() >= SETTINGS_OVERLAY_KEY_SIZE || value.size() >= SETTINGS_OVERLAY_VALUE_SIZE) {
+        return false;
+    }
+
+    SettingsOverlaySegment *segment = MapSegment(pSegmentName, PROT_READ | PROT_WRITE);
+    if (segment == nullptr) {
+        return false;
+    }
+
+    // Writers take the table by making the sequence odd, 'sequence' is then the odd value owned, and record their
+    // process ID once they own it. A writer which died while writing leaves the sequence odd: once the same odd value
+    // was seen for the whole deadline and the recorded writer is no longer running, the table is taken over by first
+    // claiming 'writer_pid', so that a single waiting writer moves the sequence to the next odd value. 0 is recorded
+    // between taking the table and recording the process ID, such a writer is considered running.
+    const uint32_t writer_pid = static_cast<uint32_t>(getpid());
+    uint64_t sequence = segment->sequence.load(std::memory_order_relaxed);
+    uint64_t observed_sequence = sequence;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    for (;;) {
+        if ((sequence & 1) == 0) {
+            if (segment->sequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire,
+                                                        std::memory_order_relaxed)) {
+                sequence += 1;
+                segment->writer_pid.store(writer_pid, std::memory_order_relaxed);
+                break;
+            }
+            continue;
+        }
+
+        if (sequence != observed_sequence) {
+            observed_sequence = sequence;
+            deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        } else if (std::chrono::steady_clock::now() > deadline) {
+            uint32_t dead_pid = segment->writer_pid.load(std::memory_order_relaxed);
+            if (!IsWriterDead(dead_pid)) {
+                UnmapSegment(segment);
+                return false;
+            }
+
+            if (segment->writer_pid.compare_exchange_strong(dead_pid, writer_pid, std::memory_order_relaxed)) {
+                if (segment->sequence.compare_exchange_strong(sequence, sequence + 2, std::memory_order_acquire,
+                                                              std::memory_order_relaxed)) {
+                    sequence += 2;
+                    break;
+                }
+                // The writer was running after all and released the table, which records no writer again
+                uint32_t claimed_pid = writer_pid;
+                segment->writer_pid.compare_exchange_strong(claimed_pid, 0, std::memory_order_relaxed);
+            }
+            sequence = segment->sequence.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        std::this_thread::yield();
+        sequence = segment->sequence.load(std::memory_order_relaxed);
+    }
+    // The odd sequence is visible before any change of the table
+    std::atomic_thread_fence(std::memory_order_release);
+
+    bool result = true;
+    if (segment->magic == 0) {
+        segment->magic = SETTINGS_OVERLAY_MAGIC;
+        segment->version = SETTINGS_OVERLAY_VERSION;
+    }
+
+    if (segment->magic != SETTINGS_OVERLAY_MAGIC || segment->version != SETTINGS_OVERLAY_VERSION) {
+        result = false;  // Written by an incompatible version of the library
+    } else {
+        const uint32_t entry_count = std::min(segment->entry_count, static_cast<uint32_t>(SETTINGS_OVERLAY_ENTRY_COUNT));
+
+        uint32_t position = 0;
+        while (position < entry_count && GetOverlayString(segment->entries[position].key, SETTINGS_OVERLAY_KEY_SIZE) != key) {
+            ++position;
+        }
+
+        if (value.empty()) {
+            if (position < entry_count) {
+                segment->entries[position] = segment->entries[entry_count - 1];
+                segment->entry_count = entry_count - 1;
+            }
+        } else if (position < SETTINGS_OVERLAY_ENTRY_COUNT) {
+            SettingsOverlayEntry &entry = segment->entries[position];
+            if (position == entry_count) {
+                std::memcpy(entry.key, key.data(), key.size());
+                entry.key[key.size()] = '\0';
+                segment->entry_count = entry_count + 1;
+            }
+            std::memcpy(entry.value, value.data(), value.size());
+            entry.value[value.size()] = '\0';
+        } else {
+            result = false;  // Full
+        }
+    }
+
+    // 'writer_pid' is 0 whenever the sequence is even. A writer taken over, only when its process ID was seen to be
+    // running no more, no longer owns the sequence and doesn't publish its write.
+    uint32_t owner_pid = writer_pid;
+    segment->writer_pid.compare_exchange_strong(owner_pid, 0, std::memory_order_relaxed);
+    if (!segment->sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_release, std::memory_order_relaxed)) {
+        result = false;
+    }
+    UnmapSegment(segment);
+
+    return result;
+}
+
+bool RemoveSettingsOverlay(const char *pSegmentName) { return shm_unlink(GetSegmentName(pSegmentName).c_str()) == 0; }
+
+#else
+
+bool IsSettingsOverlaySupported() { return false; }
+
+SettingsOverlay::~SettingsOverlay() {}
+
+bool SettingsOverlay::Open(const char *pSegmentName) {
+    (void)pSegmentName;
+    return false;
+}
+
+bool WriteSettingsOverlay(const char *pSegmentName, std::string_view key, std::string_view value) {
+    (void)pSegmentName;
+    (void)key;
+    (void)value;
+    return false;
+}
+
+bool RemoveSettingsOverlay(const char *pSegmentName) {
+    (void)pSegmentName;
+    return false;
+}
+
+#endif
+
+std::shared_ptr<const SettingsFile> SettingsOverlay::Read(Arena *arena, uint64_t &sequence) const {
+    struct EntryPosition {
+        std::size_t key_offset;
+        std::size_t key_size;
+        std::size_t value_offset;
+        std::size_t value_size;
+    };
+
+    ArenaString content{ArenaAllocator<char>(arena)};
+    ArenaVector<EntryPosition> positions{ArenaAllocator<EntryPosition>(arena)};
+
+    for (int attempt = 0; attempt < OVERLAY_READ_ATTEMPTS; ++attempt) {
+        const uint64_t begin = this->segment->sequence.load(std::memory_order_acquire);
+        if ((begin & 1) != 0) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // The table may be modified while it's copied, such copies are detected by the sequence and discarded. Strings
+        // are read within their buffer, so a copy overlapping a write never reads outside of the segment.
+        content.clear();
+        positions.clear();
+
+        const bool compatible = this->segment->magic == SETTINGS_OVERLAY_MAGIC && this->segment->version == SETTINGS_OVERLAY_VERSION;
+        const uint32_t entry_count =
+            compatible ? std::min(this->segment->entry_count, static_cast<uint32_t>(SETTINGS_OVERLAY_ENTRY_COUNT)) : 0;
+
+        for (uint32_t i = 0; i < entry_count; ++i) {
+            const SettingsOverlayEntry &entry = this->segment->entries[i];
+            const std::string_view key = GetOverlayString(entry.key, SETTINGS_OVERLAY_KEY_SIZE);
+            const std::string_view value = GetOverlayString(entry.value, SETTINGS_OVERLAY_VALUE_SIZE);
+
+            positions.push_back(EntryPosition{content.size(), key.size(), content.size() + key.size(), value.size()});
+            content.append(key);
+            content.append(value);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (this->segment->sequence.load(std::memory_order_relaxed) != begin) {
+            continue;
+        }
+
+        // A table written with another layout is read as empty
+        std::shared_ptr<SettingsFile> settings_file = std::allocate_shared<SettingsFile>(ArenaAllocator<SettingsFile>(arena), arena);
+        const std::string_view strings = settings_file->SetContent(content, positions.size());
+        for (const EntryPosition &position : positions) {
+            const std::string_view key = strings.substr(position.key_offset, position.key_size);
+            settings_file->AddEntry(HashSettingName(key), key, strings.substr(position.value_offset, position.value_size));
+        }
+
+        sequence = begin;
+        return settings_file;
+    }
+
+    return nullptr;
+}
+
+}  // namespace vl
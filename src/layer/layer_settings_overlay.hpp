@@ -0,0 +1,85 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "layer_settings_arena.hpp"
+#include "layer_settings_file.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace vl {
+    // Settings written by other processes in a POSIX shared memory segment, see vlAttachLayerSettingsOverlay.
+    // Keys are vk_layer_settings.txt keys, such as "lunarg_test.my_setting", and the entries in use are the first
+    // 'entry_count' ones. Writers increment 'sequence' to an odd value before modifying the table and to the next even
+    // value once done, so that readers check with a single load whether the table changed and retry copies that
+    // overlap a write. The layout uses the byte order and the atomics of the machine, it's only shared between the
+    // processes of a machine, which are expected to share a PID namespace.
+    // A writer records its process ID in 'writer_pid' while the sequence is odd, it's 0 while the sequence is even. A
+    // writer which finds the same odd sequence for the whole write deadline and 'writer_pid' no longer running claims
+    // 'writer_pid' and takes the table over: the entry the dead writer was modifying may be left partially written,
+    // the other entries are kept.
+    constexpr uint32_t SETTINGS_OVERLAY_MAGIC = 0x4f534c56;  // "VLSO"
+    constexpr uint32_t SETTINGS_OVERLAY_VERSION = 2;
+    constexpr std::size_t SETTINGS_OVERLAY_ENTRY_COUNT = 256;
+    constexpr std::size_t SETTINGS_OVERLAY_KEY_SIZE = 128;
+    constexpr std::size_t SETTINGS_OVERLAY_VALUE_SIZE = 384;
+
+    struct SettingsOverlayEntry {
+        char key[SETTINGS_OVERLAY_KEY_SIZE];  // Null terminated
+        char value[SETTINGS_OVERLAY_VALUE_SIZE];
+    };
+
+    // A new segment is zero filled: the magic and the version are written by the first write
+    struct SettingsOverlaySegment {
+        std::atomic<uint64_t> sequence;
+        uint32_t magic;
+        uint32_t version;
+        uint32_t entry_count;
+        std::atomic<uint32_t> writer_pid;  // 0 while no writer modifies the table
+        SettingsOverlayEntry entries[SETTINGS_OVERLAY_ENTRY_COUNT];
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "The sequence of the overlay is shared between processes");
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "The writer of the overlay is shared between processes");
+
+    // Read side of a settings overlay segment, mapped until destroyed
+    class SettingsOverlay {
+      public:
+        SettingsOverlay() = default;
+        ~SettingsOverlay();
+
+        SettingsOverlay(const SettingsOverlay &) = delete;
+        SettingsOverlay &operator=(const SettingsOverlay &) = delete;
+
+        // Map the segment, created empty if no process wrote it yet.
+        // Return false if shared memory isn't supported on this platform or the segment can't be mapped.
+        bool Open(const char *pSegmentName);
+
+        // Changes with each write of the table, a single atomic load
+        uint64_t GetSequence() const { return this->segment->sequence.load(std::memory_order_acquire); }
+
+        // Copy the table in a SettingsFile allocated in 'arena' and set 'sequence' to the version copied.
+        // Return nullptr while a writer keeps modifying the table. A table written with another layout is read as empty.
+        std::shared_ptr<const SettingsFile> Read(Arena *arena, uint64_t &sequence) const;
+
+      private:
+        SettingsOverlaySegment *segment{nullptr};
+    };
+
+    // Whether POSIX shared memory is supported on this platform
+    bool IsSettingsOverlaySupported();
+
+    // Set the value of 'key' in the segment, created if needed. An empty value removes the key.
+    // Return false if the segment can't be mapped, the key or the value is too long, or the table is full.
+    bool WriteSettingsOverlay(const char *pSegmentName, std::string_view key, std::string_view value);
+
+    // Remove the name of the segment, processes which mapped it keep reading the last values written
+    bool RemoveSettingsOverlay(const char *pSegmentName);
+}  // namespace vl
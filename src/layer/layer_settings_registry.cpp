@@ -0,0 +1,52 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "layer_settings_registry.hpp"
+#include "layer_settings_util.hpp"
+
+namespace vl {
+
+void KnownSettingRegistry::Reserve(std::size_t count) {
+    this->names.reserve(count);
+    this->index.Reserve(count);
+}
+
+bool KnownSettingRegistry::Add(std::string_view name) {
+    const bool added = this->index.Insert(HashString(name), static_cast<uint32_t>(this->names.size()),
+                                          [&](uint32_t position) { return this->names[position] == name; });
+    if (added) {
+        this->names.emplace_back(name);
+    }
+    return added;
+}
+
+bool KnownSettingRegistry::Contains(std::string_view name) const {
+    return this->index.Find(HashString(name), [&](uint32_t position) { return this->names[position] == name; }) !=
+           HashIndex::NOT_FOUND;
+}
+
+uint32_t KnownSettingRegistry::FindUnknownSettings(const VkLayerSettingsCreateInfoEXT *pCreateInfo, uint32_t capacity,
+                                                   const char **pUnknownSettings) const {
+    uint32_t unknown_setting_count = 0;
+    if (pCreateInfo == nullptr) {
+        return unknown_setting_count;
+    }
+
+    for (uint32_t i = 0, n = pCreateInfo->settingCount; i < n; ++i) {
+        const char *setting_name = pCreateInfo->pSettings[i].pSettingName;
+        if (this->Contains(setting_name)) {
+            continue;
+        }
+
+        if (pUnknownSettings != nullptr && unknown_setting_count < capacity) {
+            pUnknownSettings[unknown_setting_count] = setting_name;
+        }
+        ++unknown_setting_count;
+    }
+
+    return unknown_setting_count;
+}
+
+}  // namespace vl
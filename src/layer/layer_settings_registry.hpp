@@ -0,0 +1,44 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "vulkan/layer/vk_layer_settings.h"
+#include "layer_settings_arena.hpp"
+#include "layer_settings_index.hpp"
+
+#include <cstdint>
+#include <string_view>
+
+namespace vl {
+    // Names of the settings known by a layer, indexed by their case sensitive hash so that checking the settings of a
+    // VkLayerSettingsCreateInfoEXT is one lookup per setting. Immutable once built, lookups may run concurrently.
+    class KnownSettingRegistry {
+      public:
+        explicit KnownSettingRegistry(const VkAllocationCallbacks *pAllocator)
+            : arena(pAllocator), names(ArenaAllocator<ArenaString>(&arena)), index(&arena) {}
+
+        void Reserve(std::size_t count);
+
+        // Return false if 'name' is already registered
+        bool Add(std::string_view name);
+
+        bool Contains(std::string_view name) const;
+
+        // Return the number of settings of 'pCreateInfo' which aren't registered, the first 'capacity' of them are
+        // written to 'pUnknownSettings' when it's not nullptr
+        uint32_t FindUnknownSettings(const VkLayerSettingsCreateInfoEXT *pCreateInfo, uint32_t capacity,
+                                     const char **pUnknownSettings) const;
+
+        Arena &GetArena() { return this->arena; }
+
+      private:
+        // Declared first so that it's destroyed after every member storing memory in it
+        Arena arena;
+
+        ArenaVector<ArenaString> names;
+        HashIndex index;
+    };
+}  // namespace vl
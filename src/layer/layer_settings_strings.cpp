@@ -0,0 +1,37 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "layer_settings_strings.hpp"
+#include "layer_settings_util.hpp"
+
+#include <cstring>
+
+namespace vl {
+
+std::string_view StringPool::Intern(std::string_view s) {
+    const uint64_t hash = HashString(s);
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    const uint32_t position = this->index.Find(hash, [&](uint32_t i) { return this->strings[i] == s; });
+    if (position != HashIndex::NOT_FOUND) {
+        return this->strings[position];
+    }
+
+    char *copy = static_cast<char *>(this->arena->Allocate(s.size() + 1));
+    std::memcpy(copy, s.data(), s.size());
+    copy[s.size()] = '\0';
+
+    this->strings.emplace_back(copy, s.size());
+    this->index.Insert(hash, static_cast<uint32_t>(this->strings.size() - 1), [](uint32_t) { return false; });
+    return this->strings.back();
+}
+
+std::size_t StringPool::Size() const {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->strings.size();
+}
+
+}  // namespace vl
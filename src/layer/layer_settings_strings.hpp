@@ -0,0 +1,37 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "layer_settings_arena.hpp"
+#include "layer_settings_index.hpp"
+
+#include <mutex>
+#include <string_view>
+
+namespace vl {
+    // Interned strings of a layer setting set. Each distinct string is copied once in the arena, NUL terminated, and
+    // stays at the same address until the arena is destroyed, so that the string values returned by queries are never
+    // overwritten by later queries. Thread-safe.
+    class StringPool {
+      public:
+        explicit StringPool(Arena *arena) : arena(arena), strings(ArenaAllocator<std::string_view>(arena)), index(arena) {}
+
+        StringPool(const StringPool &) = delete;
+        StringPool &operator=(const StringPool &) = delete;
+
+        // Return the interned copy of 's', 'data()' is NUL terminated
+        std::string_view Intern(std::string_view s);
+
+        std::size_t Size() const;
+
+      private:
+        Arena *arena;
+
+        mutable std::mutex mutex;
+        ArenaVector<std::string_view> strings;
+        HashIndex index;
+    };
+}  // namespace vl
@@ -9,13 +9,28 @@
 #include "layer_settings_util.hpp"
 
 #include <sstream>
-#include <regex>
+#include <charconv>
+#include <cctype>
+#include <limits>
+#include <locale>
+#include <type_traits>
 #include <cstdlib>
 #include <cassert>
 #include <cstdint>
 
 namespace vl {
 
+const VkLayerSettingsCreateInfoEXT *FindSettingsInChain(const void *next) {
+    const VkBaseInStructure *current = reinterpret_cast<const VkBaseInStructure *>(next);
+    while (current != nullptr) {
+        if (current->sType == VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT) {
+            return reinterpret_cast<const VkLayerSettingsCreateInfoEXT *>(current);
+        }
+        current = current->pNext;
+    }
+    return nullptr;
+}
+
 std::vector<std::string> Split(const std::string &pValues, char delimiter) {
     std::vector<std::string> result;
 
@@ -37,6 +52,36 @@ std::vector<std::string> Split(const std::string &pValues, char delimiter) {
     return result;
 }
 
+bool NextListValue(std::string_view list, char delimiter, std::size_t &position, std::string_view &value) {
+    if (position > list.size()) {
+        return false;
+    }
+
+    const std::size_t end = list.find(delimiter, position);
+    if (end == std::string_view::npos) {
+        // Like Split, a trailing empty value is ignored
+        value = list.substr(position);
+        position = list.size() + 1;
+        return !value.empty();
+    }
+
+    value = list.substr(position, end - position);
+    position = end + 1;
+    return true;
+}
+
+uint32_t CountListValues(std::string_view list, char delimiter) {
+    uint32_t count = 0;
+
+    std::size_t position = 0;
+    std::string_view value;
+    while (NextListValue(list, delimiter, position, value)) {
+        ++count;
+    }
+
+    return count;
+}
+
 std::string GetFileSettingName(const char *pLayerName, const char *pSettingName) {
     assert(pLayerName != nullptr);
     assert(pSettingName != nullptr);
@@ -95,10 +140,10 @@ char GetEnvDelimiter() {
 #endif
 }
 
-char FindDelimiter(const std::string& s) {
-    if (s.find(',') != std::string::npos) {
+char FindDelimiter(std::string_view s) {
+    if (s.find(',') != std::string_view::npos) {
         return ',';
-    } else if (s.find(GetEnvDelimiter()) != std::string::npos) {
+    } else if (s.find(GetEnvDelimiter()) != std::string_view::npos) {
         return GetEnvDelimiter();
     } else {
         return ',';
@@ -229,22 +274,288 @@ std::vector<VlFrameset> ToFrameSets(const std::string &s) {
     return results;
 }
 
+static bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+static bool IsAlphaNumeric(char c) { return IsDigit(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'); }
+
+// Skip the digits starting at 'i' and return the position of the first non-digit character
+static std::size_t SkipDigits(const std::string &s, std::size_t i) {
+    while (i < s.size() && IsDigit(s[i])) {
+        ++i;
+    }
+    return i;
+}
+
+// Accepts comma separated frame sets of the form "first", "first-last" or "first-last-step"
 bool IsFrameSets(const std::string &s) {
-    static const std::regex FRAME_REGEX("^([0-9]+([-][0-9]+){0,2})(,([0-9]+([-][0-9]+){0,2}))*$");
+    std::size_t i = 0;
+    const std::size_t n = s.size();
+
+    while (true) {
+        for (int number = 0; number < 3; ++number) {
+            const std::size_t number_end = SkipDigits(s, i);
+            if (number_end == i) {
+                return false;
+            }
+            i = number_end;
+
+            if (i == n) {
+                return true;
+            }
+            if (s[i] != '-') {
+                break;
+            }
+            if (number == 2) {
+                return false;  // A frame set has at most three numbers
+            }
+            ++i;
+        }
 
-    return std::regex_search(s, FRAME_REGEX);
+        if (s[i] != ',') {
+            return false;
+        }
+        ++i;
+    }
 }
 
+// Accepts decimal numbers and hexadecimal numbers prefixed by "0x", optionally negative.
+// To remain compatible with existing settings, the hexadecimal digits accept any letter and '|'.
 bool IsInteger(const std::string &s) {
-    static const std::regex FRAME_REGEX("^-?([0-9]*|0x[0-9|a-z|A-Z]*)$");
+    std::size_t i = (!s.empty() && s[0] == '-') ? 1 : 0;
+
+    if (s.compare(i, 2, "0x") == 0) {
+        for (i += 2; i < s.size(); ++i) {
+            if (!IsAlphaNumeric(s[i]) && s[i] != '|') {
+                return false;
+            }
+        }
+        return true;
+    }
 
-    return std::regex_search(s, FRAME_REGEX);
+    return SkipDigits(s, i) == s.size();
 }
 
+// Accepts numbers of the form "-1.0f" where the sign, the integer part, the fractional part and the suffix are optional
 bool IsFloat(const std::string &s) {
-    static const std::regex FRAME_REGEX("^-?[0-9]*([.][0-9]*f?)?$");
+    std::size_t i = (!s.empty() && s[0] == '-') ? 1 : 0;
+
+    i = SkipDigits(s, i);
+    if (i == s.size()) {
+        return true;
+    }
+    if (s[i] != '.') {
+        return false;
+    }
+
+    i = SkipDigits(s, i + 1);
+    if (i < s.size() && s[i] == 'f') {
+        ++i;
+    }
+
+    return i == s.size();
+}
+
+static bool EqualsLowerCase(std::string_view s, std::string_view lower_case) {
+    if (s.size() != lower_case.size()) {
+        return false;
+    }
+
+    for (std::size_t i = 0, n = s.size(); i < n; ++i) {
+        if (std::tolower(static_cast<unsigned char>(s[i])) != lower_case[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Parse the absolute value of an integer, 's' is "0x" hexadecimal or decimal
+static ParseResult ParseMagnitude(std::string_view s, uint64_t &magnitude) {
+    int base = 10;
+    if (s.size() >= 2 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X')) {
+        base = 16;
+        s.remove_prefix(2);
+    }
+
+    magnitude = 0;
+    if (s.empty()) {
+        return PARSE_SUCCESS;  // "", "-" and "0x" have always been read as 0
+    }
+
+    const std::from_chars_result result = std::from_chars(s.data(), s.data() + s.size(), magnitude, base);
+    if (result.ptr != s.data() + s.size()) {
+        return PARSE_INVALID;
+    }
+    if (result.ec == std::errc::result_out_of_range) {
+        magnitude = std::numeric_limits<uint64_t>::max();
+        return PARSE_OUT_OF_RANGE;
+    }
+    if (result.ec != std::errc()) {
+        return PARSE_INVALID;
+    }
+
+    return PARSE_SUCCESS;
+}
+
+template <typename T>
+ParseResult ParseInteger(std::string_view s, T &value) {
+    static_assert(std::is_integral<T>::value, "ParseInteger requires an integer type");
 
-    return std::regex_search(s, FRAME_REGEX);
+    value = 0;
+
+    const bool negative = !s.empty() && s[0] == '-';
+    if (negative) {
+        s.remove_prefix(1);
+    }
+
+    uint64_t magnitude = 0;
+    ParseResult result = ParseMagnitude(s, magnitude);
+    if (result == PARSE_INVALID) {
+        return result;
+    }
+
+    if (negative) {
+        // Negative values are read in the signed type of the same size, unsigned types wrap them as atoi did: "-1" is
+        // 0xFFFFFFFF for a UINT32 setting
+        using Signed = typename std::make_signed<T>::type;
+        const uint64_t max_magnitude = static_cast<uint64_t>(std::numeric_limits<Signed>::max()) + 1;
+        if (magnitude > max_magnitude) {
+            value = static_cast<T>(std::numeric_limits<Signed>::min());
+            return PARSE_OUT_OF_RANGE;
+        }
+        value = static_cast<T>(0 - magnitude);
+    } else {
+        if (magnitude > static_cast<uint64_t>(std::numeric_limits<T>::max())) {
+            value = std::numeric_limits<T>::max();
+            return PARSE_OUT_OF_RANGE;
+        }
+        value = static_cast<T>(magnitude);
+    }
+
+    return result;
+}
+
+template ParseResult ParseInteger<int32_t>(std::string_view s, int32_t &value);
+template ParseResult ParseInteger<int64_t>(std::string_view s, int64_t &value);
+template ParseResult ParseInteger<uint32_t>(std::string_view s, uint32_t &value);
+template ParseResult ParseInteger<uint64_t>(std::string_view s, uint64_t &value);
+
+ParseResult ParseBool(std::string_view s, VkBool32 &value) {
+    int64_t integer = 0;
+    const ParseResult result = ParseInteger(s, integer);
+    if (result != PARSE_INVALID) {
+        value = integer != 0 ? VK_TRUE : VK_FALSE;
+        return PARSE_SUCCESS;
+    }
+
+    if (EqualsLowerCase(s, "true") || EqualsLowerCase(s, "on")) {
+        value = VK_TRUE;
+    } else if (EqualsLowerCase(s, "false") || EqualsLowerCase(s, "off")) {
+        value = VK_FALSE;
+    } else {
+        value = VK_FALSE;
+        return PARSE_INVALID;
+    }
+
+    return PARSE_SUCCESS;
+}
+
+template <typename T>
+ParseResult ParseFloat(std::string_view s, T &value) {
+    static_assert(std::is_floating_point<T>::value, "ParseFloat requires a floating-point type");
+
+    value = 0;
+
+    // Validate the "-1.0f" form first, from_chars accepts exponents, infinity and NaN
+    std::size_t i = (!s.empty() && s[0] == '-') ? 1 : 0;
+    bool has_digits = false;
+    for (; i < s.size() && IsDigit(s[i]); ++i) {
+        has_digits = true;
+    }
+    if (i < s.size()) {
+        if (s[i] != '.') {
+            return PARSE_INVALID;
+        }
+        for (++i; i < s.size() && IsDigit(s[i]); ++i) {
+            has_digits = true;
+        }
+        if (i + 1 == s.size() && (s[i] == 'f' || s[i] == 'F')) {
+            s.remove_suffix(1);
+        } else if (i != s.size()) {
+            return PARSE_INVALID;
+        }
+    }
+
+    if (!has_digits) {
+        return PARSE_SUCCESS;  // "", "-" and "." have always been read as 0
+    }
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    const std::from_chars_result result = std::from_chars(s.data(), s.data() + s.size(), value, std::chars_format::fixed);
+    if (result.ec == std::errc::result_out_of_range) {
+        value = s[0] == '-' ? std::numeric_limits<T>::lowest() : std::numeric_limits<T>::max();
+        return PARSE_OUT_OF_RANGE;
+    }
+    if (result.ec != std::errc() || result.ptr != s.data() + s.size()) {
+        value = 0;
+        return PARSE_INVALID;
+    }
+#else
+    // Floating-point std::from_chars is not available with this standard library, use the classic locale to not
+    // depend on the decimal separator of the application locale
+    std::istringstream stream{std::string(s)};
+    stream.imbue(std::locale::classic());
+    stream >> value;
+    if (stream.fail()) {
+        value = s[0] == '-' ? std::numeric_limits<T>::lowest() : std::numeric_limits<T>::max();
+        return PARSE_OUT_OF_RANGE;
+    }
+#endif
+
+    return PARSE_SUCCESS;
+}
+
+template ParseResult ParseFloat<float>(std::string_view s, float &value);
+template ParseResult ParseFloat<double>(std::string_view s, double &value);
+
+ParseResult ParseFrameSet(std::string_view s, VlFrameset &value) {
+    // Omitted counts and steps are 1, invalid framesets select no frame with a step of 0
+    value = VlFrameset{0, 1, 1};
+
+    uint32_t *numbers[] = {&value.first, &value.count, &value.step};
+    ParseResult result = PARSE_SUCCESS;
+
+    std::size_t position = 0;
+    std::string_view number;
+    std::size_t number_count = 0;
+    while (NextListValue(s, '-', position, number)) {
+        if (number_count == std::size(numbers) || number.empty() || number[0] == '+') {
+            value = VlFrameset{0, 0, 0};
+            return PARSE_INVALID;
+        }
+
+        uint64_t magnitude = 0;
+        const char *number_end = number.data() + number.size();
+        const std::from_chars_result number_result = std::from_chars(number.data(), number_end, magnitude);
+        if (number_result.ptr != number_end) {
+            value = VlFrameset{0, 0, 0};
+            return PARSE_INVALID;
+        }
+        if (number_result.ec == std::errc::result_out_of_range || magnitude > std::numeric_limits<uint32_t>::max()) {
+            magnitude = std::numeric_limits<uint32_t>::max();
+            result = PARSE_OUT_OF_RANGE;
+        }
+
+        *numbers[number_count++] = static_cast<uint32_t>(magnitude);
+    }
+
+    // A trailing '-' is ignored by NextListValue
+    if (number_count == 0 || s.back() == '-') {
+        value = VlFrameset{0, 0, 0};
+        return PARSE_INVALID;
+    }
+
+    return result;
 }
 
 std::string FormatString(const char *message, ...) {
@@ -12,16 +12,50 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
 #include <cstring>
 #include <cstdarg>
+#include <cstdint>
 
 namespace vl {
     const VkLayerSettingsCreateInfoEXT *FindSettingsInChain(
         const void *next);
 
+    // FNV-1a hash of a setting name. ASCII letters are hashed case-insensitively so that the same hash
+    // can probe the indices of environment variables whose names are upper case.
+    // Passing the hash of a prefix as 'hash' returns the hash of the prefix followed by 'name'.
+    constexpr uint64_t HashSettingName(std::string_view name, uint64_t hash = 14695981039346656037ull) {
+        for (char c : name) {
+            const char lower_c = (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+            hash ^= static_cast<uint8_t>(lower_c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    // FNV-1a hash of a string, case sensitive unlike HashSettingName
+    constexpr uint64_t HashString(std::string_view s) {
+        uint64_t hash = 14695981039346656037ull;
+        for (char c : s) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    constexpr uint64_t HashCombine(uint64_t seed, uint64_t hash) {
+        return seed ^ (hash + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+    }
+
     std::vector<std::string> Split(
         const std::string &pValues, char delimiter);
 
+    // Iterate the values of a list without copying them: the same values as Split, views in 'list'.
+    // 'position' starts at 0 and is advanced past the returned value.
+    bool NextListValue(std::string_view list, char delimiter, std::size_t &position, std::string_view &value);
+
+    uint32_t CountListValues(std::string_view list, char delimiter);
+
     enum TrimMode {
         TRIM_NONE,
         TRIM_VENDOR,
@@ -36,7 +70,7 @@ namespace vl {
     std::string GetFileSettingName(const char *layer_key, const char *setting_key);
 
     // Find the delimiter (, ; :) in a string made of tokens. Return ',' by default
-    char FindDelimiter(const std::string &s);
+    char FindDelimiter(std::string_view s);
 
     // ';' on WIN32 and ':' on Unix
     char GetEnvDelimiter();
@@ -70,6 +104,24 @@ namespace vl {
 
     bool IsFloat(const std::string &s);
 
+    enum ParseResult {
+        PARSE_SUCCESS,
+        PARSE_INVALID,       // 'value' is set to zero
+        PARSE_OUT_OF_RANGE,  // 'value' is clamped to the range of the type
+    };
+
+    // Parse a value of a list setting. Accepts the same strings as IsInteger, IsFloat and IsFrameSets
+    // of the lower case value, "0x" hexadecimal integers are parsed as such. Negative values of unsigned types wrap.
+    ParseResult ParseBool(std::string_view s, VkBool32 &value);
+
+    template <typename T>
+    ParseResult ParseInteger(std::string_view s, T &value);
+
+    template <typename T>
+    ParseResult ParseFloat(std::string_view s, T &value);
+
+    ParseResult ParseFrameSet(std::string_view s, VlFrameset &value);
+
     std::string FormatString(const char *message, ...);
 } // namespace vl
 
@@ -0,0 +1,132 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "layer_settings_watcher.hpp"
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstdint>
+
+namespace vl {
+
+FileWatcher::~FileWatcher() { this->Stop(); }
+
+#if defined(__linux__)
+
+bool FileWatcher::Start(const std::filesystem::path &filename, std::function<void()> on_change) {
+    this->Stop();
+
+    this->notify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (this->notify_fd < 0) {
+        return false;
+    }
+
+    // Watch the directory: editors and tools often replace the file, which would remove a watch on the file itself.
+    // Creation is reported by IN_CLOSE_WRITE once the new file is written.
+    const std::filesystem::path directory = filename.has_parent_path() ? filename.parent_path() : std::filesystem::path(".");
+    const uint32_t mask = IN_CLOSE_WRITE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO;
+    if (inotify_add_watch(this->notify_fd, directory.c_str(), mask) < 0) {
+        this->Stop();
+        return false;
+    }
+
+    this->stop_fd = eventfd(0, EFD_CLOEXEC);
+    if (this->stop_fd < 0) {
+        this->Stop();
+        return false;
+    }
+
+    this->thread = std::thread(&FileWatcher::Watch, this, filename.filename(), std::move(on_change));
+    return true;
+}
+
+void FileWatcher::Stop() {
+    if (this->thread.joinable()) {
+        // The thread uses both file descriptors, so it is always joined before they are closed. If stop_fd can't be
+        // written, the thread still sees 'stopping' at its next poll timeout.
+        this->stopping.store(true);
+        const uint64_t stop = 1;
+        while (write(this->stop_fd, &stop, sizeof(stop)) < 0 && errno == EINTR) {
+        }
+        this->thread.join();
+    }
+    this->stopping.store(false);
+
+    if (this->notify_fd >= 0) {
+        close(this->notify_fd);
+        this->notify_fd = -1;
+    }
+    if (this->stop_fd >= 0) {
+        close(this->stop_fd);
+        this->stop_fd = -1;
+    }
+}
+
+void FileWatcher::Watch(std::filesystem::path filename, std::function<void()> on_change) {
+    alignas(struct inotify_event) char events[4096];
+
+    // Timeout of the poll after which 'stopping' is checked when stop_fd wasn't signaled
+    const int stop_timeout_ms = 100;
+
+    pollfd fds[2] = {{this->notify_fd, POLLIN, 0}, {this->stop_fd, POLLIN, 0}};
+    while (!this->stopping.load()) {
+        const int ready = poll(fds, 2, stop_timeout_ms);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        if (ready == 0) {
+            continue;
+        }
+        if (fds[1].revents != 0) {
+            return;
+        }
+        if ((fds[0].revents & POLLIN) == 0) {
+            continue;
+        }
+
+        bool changed = false;
+        for (ssize_t size; (size = read(this->notify_fd, events, sizeof(events))) > 0;) {
+            for (ssize_t offset = 0; offset < size;) {
+                const struct inotify_event *event = reinterpret_cast<const struct inotify_event *>(events + offset);
+                if (event->len > 0 && filename == event->name) {
+                    changed = true;
+                }
+                offset += static_cast<ssize_t>(sizeof(struct inotify_event) + event->len);
+            }
+        }
+
+        if (changed) {
+            on_change();
+        }
+    }
+}
+
+#else
+
+bool FileWatcher::Start(const std::filesystem::path &filename, std::function<void()> on_change) {
+    (void)filename;
+    (void)on_change;
+    return false;
+}
+
+void FileWatcher::Stop() {}
+
+void FileWatcher::Watch(std::filesystem::path filename, std::function<void()> on_change) {
+    (void)filename;
+    (void)on_change;
+}
+
+#endif
+
+}  // namespace vl
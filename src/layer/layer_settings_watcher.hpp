@@ -0,0 +1,37 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <thread>
+
+namespace vl {
+    // Call 'on_change' on a background thread each time a file is written, created, replaced or removed
+    class FileWatcher {
+      public:
+        FileWatcher() = default;
+        ~FileWatcher();
+
+        FileWatcher(const FileWatcher &) = delete;
+        FileWatcher &operator=(const FileWatcher &) = delete;
+
+        // Return false if the file can't be watched on this platform or its directory doesn't exist
+        bool Start(const std::filesystem::path &filename, std::function<void()> on_change);
+
+        // Wait for the background thread, 'on_change' is not called afterward
+        void Stop();
+
+      private:
+        void Watch(std::filesystem::path filename, std::function<void()> on_change);
+
+        int notify_fd{-1};
+        int stop_fd{-1};
+        std::atomic<bool> stopping{false};  // Checked between polls in case the stop_fd write fails
+        std::thread thread;
+    };
+}  // namespace vl
@@ -7,10 +7,14 @@
 // Author(s):
 // - Christophe Riccio <christophe@lunarg.com>
 #include "vulkan/layer/vk_layer_settings.h"
+#include "vulkan/layer/vk_layer_settings.hpp"
 #include "layer_settings_util.hpp"
 #include "layer_settings_manager.hpp"
+#include "layer_settings_registry.hpp"
 
 #include <memory>
+#include <charconv>
+#include <cstdio>
 #include <cstdlib>
 #include <cassert>
 #include <cstring>
@@ -18,6 +22,11 @@
 #include <cstring>
 #include <cstdint>
 #include <unordered_map>
+#include <algorithm>
+#include <string_view>
+#include <mutex>
+#include <new>
+#include <type_traits>
 
 // This is used only for unit tests in test_layer_setting_file
 void test_helper_SetLayerSetting(VlLayerSettingSet layerSettingSet, const char *pSettingName, const char *pValue) {
@@ -33,19 +42,191 @@ void test_helper_SetLayerSetting(VlLayerSettingSet layerSettingSet, const char *
 VkResult vlCreateLayerSettingSet(const char *pLayerName, const VkLayerSettingsCreateInfoEXT *pCreateInfo,
                                  const VkAllocationCallbacks *pAllocator, VlLayerSettingLogCallback pCallback,
     VlLayerSettingSet *pLayerSettingSet) {
-    (void)pAllocator;
+    return vlCreateLayerSettingSetWithFlags(pLayerName, pCreateInfo, pAllocator, pCallback, 0, pLayerSettingSet);
+}
 
-    vl::LayerSettings* layer_setting_set = new vl::LayerSettings(pLayerName, pCreateInfo, pAllocator, pCallback);
-    *pLayerSettingSet = (VlLayerSettingSet)layer_setting_set;
+VkResult vlCreateLayerSettingSetWithFlags(const char *pLayerName, const VkLayerSettingsCreateInfoEXT *pCreateInfo,
+                                          const VkAllocationCallbacks *pAllocator, VlLayerSettingLogCallback pCallback,
+                                          VlLayerSettingSetCreateFlags flags, VlLayerSettingSet *pLayerSettingSet) {
+    // A snapshot never changes, so it can't follow the settings file
+    const VlLayerSettingSetCreateFlags snapshot_watch_flags =
+        VL_LAYER_SETTING_SET_CREATE_RESOLVED_SNAPSHOT_BIT | VL_LAYER_SETTING_SET_CREATE_WATCH_SETTINGS_FILE_BIT;
+    if ((flags & snapshot_watch_flags) == snapshot_watch_flags) {
+        *pLayerSettingSet = VK_NULL_HANDLE;
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    void *memory = vl::Arena::AllocateSystem(pAllocator, sizeof(vl::LayerSettings));
+    if (memory == nullptr) {
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+
+    try {
+        vl::LayerSettings *layer_setting_set = new (memory) vl::LayerSettings(pLayerName, pCreateInfo, pAllocator, pCallback, flags);
+        *pLayerSettingSet = (VlLayerSettingSet)layer_setting_set;
+    } catch (const std::bad_alloc &) {
+        vl::Arena::FreeSystem(pAllocator, memory);
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
 
     return VK_SUCCESS;
 }
 
 void vlDestroyLayerSettingSet(VlLayerSettingSet layerSettingSet, const VkAllocationCallbacks *pAllocator) {
-    (void)pAllocator;
+    if (layerSettingSet == VK_NULL_HANDLE) {
+        return;
+    }
 
     vl::LayerSettings *layer_setting_set = (vl::LayerSettings*)layerSettingSet;
-    delete layer_setting_set;
+
+    // The allocation callbacks of the creation are used, the layer setting set keeps a copy of them
+    (void)pAllocator;
+    VkAllocationCallbacks allocator{};
+    const VkAllocationCallbacks *pCreateAllocator = layer_setting_set->GetArena().GetAllocationCallbacks(allocator);
+
+    layer_setting_set->~LayerSettings();
+    vl::Arena::FreeSystem(pCreateAllocator, layer_setting_set);
+}
+
+void vlGetLayerSettingSetMemoryUsage(VlLayerSettingSet layerSettingSet, VlLayerSettingSetMemoryUsage *pMemoryUsage) {
+    assert(layerSettingSet != VK_NULL_HANDLE);
+    assert(pMemoryUsage != nullptr);
+
+    vl::LayerSettings *layer_setting_set = (vl::LayerSettings *)layerSettingSet;
+
+    pMemoryUsage->allocatedBytes = sizeof(vl::LayerSettings) + layer_setting_set->GetArena().GetAllocatedBytes();
+    pMemoryUsage->peakAllocatedBytes = sizeof(vl::LayerSettings) + layer_setting_set->GetArena().GetPeakAllocatedBytes();
+}
+
+VkResult vlCompileLayerSettingsCache(const char *pLayerName) {
+    assert(pLayerName != nullptr);
+
+    try {
+        const vl::LayerSettings layer_settings(pLayerName, nullptr, nullptr, nullptr, 0);
+        return layer_settings.CompileSettingsCache() ? VK_SUCCESS : VK_ERROR_INITIALIZATION_FAILED;
+    } catch (const std::bad_alloc &) {
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+}
+
+VkResult vlGetLayerSettingStatistics(VlLayerSettingSet layerSettingSet, VlLayerSettingStatistics *pStatistics) {
+    assert(layerSettingSet != VK_NULL_HANDLE);
+    assert(pStatistics != nullptr);
+
+    vl::LayerSettings *layer_setting_set = (vl::LayerSettings *)layerSettingSet;
+
+    const vl::LayerSettingStatistics *statistics = layer_setting_set->GetStatistics();
+    if (statistics == nullptr) {
+        return VK_ERROR_FEATURE_NOT_PRESENT;
+    }
+
+    pStatistics->envLookupCount = statistics->env_lookup_count.load(std::memory_order_relaxed);
+    pStatistics->fileLookupCount = statistics->file_lookup_count.load(std::memory_order_relaxed);
+    pStatistics->apiLookupCount = statistics->api_lookup_count.load(std::memory_order_relaxed);
+    pStatistics->cacheHitCount = statistics->cache_hit_count.load(std::memory_order_relaxed);
+    pStatistics->cacheMissCount = statistics->cache_miss_count.load(std::memory_order_relaxed);
+    pStatistics->getenvCount = statistics->getenv_count.load(std::memory_order_relaxed);
+    pStatistics->parseFailureCount = statistics->parse_failure_count.load(std::memory_order_relaxed);
+    pStatistics->allocatedBytes = sizeof(vl::LayerSettings) + layer_setting_set->GetArena().GetAllocatedBytes();
+    pStatistics->peakAllocatedBytes = sizeof(vl::LayerSettings) + layer_setting_set->GetArena().GetPeakAllocatedBytes();
+    pStatistics->findSettingsFileNanoseconds = statistics->find_settings_file_ns.load(std::memory_order_relaxed);
+    pStatistics->parseSettingsFileNanoseconds = statistics->parse_settings_file_ns.load(std::memory_order_relaxed);
+    pStatistics->getLayerSettingValuesCount = statistics->get_values_count.load(std::memory_order_relaxed);
+    pStatistics->getLayerSettingValuesNanoseconds = statistics->get_values_ns.load(std::memory_order_relaxed);
+
+    return VK_SUCCESS;
+}
+
+VkResult vlSetLayerSettingsChangedCallback(VlLayerSettingSet layerSettingSet, VlLayerSettingsChangedCallback pCallback,
+                                           void *pUserData) {
+    assert(layerSettingSet != VK_NULL_HANDLE);
+
+    vl::LayerSettings *layer_setting_set = (vl::LayerSettings *)layerSettingSet;
+
+    if (!layer_setting_set->IsWatchingSettingsFile()) {
+        return VK_ERROR_FEATURE_NOT_PRESENT;
+    }
+
+    layer_setting_set->SetSettingsChangedCallback(pCallback, pUserData);
+    return VK_SUCCESS;
+}
+
+VkResult vlSetLayerSettingLogRateLimit(VlLayerSettingSet layerSettingSet, uint32_t messagesPerSecond) {
+    assert(layerSettingSet != VK_NULL_HANDLE);
+
+    vl::LayerSettings *layer_setting_set = (vl::LayerSettings *)layerSettingSet;
+
+    if (layer_setting_set->GetLogSink() == nullptr) {
+        return VK_ERROR_FEATURE_NOT_PRESENT;
+    }
+
+    layer_setting_set->GetLogSink()->SetRateLimit(messagesPerSecond);
+    return VK_SUCCESS;
+}
+
+VkResult vlFlushLayerSettingLog(VlLayerSettingSet layerSettingSet) {
+    assert(layerSettingSet != VK_NULL_HANDLE);
+
+    vl::LayerSettings *layer_setting_set = (vl::LayerSettings *)layerSettingSet;
+
+    if (layer_setting_set->GetLogSink() == nullptr) {
+        return VK_ERROR_FEATURE_NOT_PRESENT;
+    }
+
+    layer_setting_set->GetLogSink()->Flush();
+    return VK_SUCCESS;
+}
+
+VkResult vlAttachLayerSettingsOverlay(VlLayerSettingSet layerSettingSet, const char *pSegmentName,
+                                      VlLayerSettingsOverlayPriority priority) {
+    assert(layerSettingSet != VK_NULL_HANDLE);
+    assert(pSegmentName != nullptr);
+
+    vl::LayerSettings *layer_setting_set = (vl::LayerSettings *)layerSettingSet;
+
+    try {
+        return layer_setting_set->AttachOverlay(pSegmentName, priority);
+    } catch (const std::bad_alloc &) {
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+}
+
+VkResult vlSetLayerSettingsOverlayValue(const char *pSegmentName, const char *pLayerName, const char *pSettingName,
+                                        const char *pValue) {
+    assert(pSegmentName != nullptr);
+    assert(pLayerName != nullptr);
+    assert(pSettingName != nullptr);
+
+    if (!vl::IsSettingsOverlaySupported()) {
+        return VK_ERROR_FEATURE_NOT_PRESENT;
+    }
+
+    const std::string &key = vl::GetFileSettingName(pLayerName, pSettingName);
+    return vl::WriteSettingsOverlay(pSegmentName, key, pValue == nullptr ? "" : pValue) ? VK_SUCCESS
+                                                                                         : VK_ERROR_INITIALIZATION_FAILED;
+}
+
+VkResult vlRemoveLayerSettingsOverlay(const char *pSegmentName) {
+    assert(pSegmentName != nullptr);
+
+    if (!vl::IsSettingsOverlaySupported()) {
+        return VK_ERROR_FEATURE_NOT_PRESENT;
+    }
+
+    return vl::RemoveSettingsOverlay(pSegmentName) ? VK_SUCCESS : VK_ERROR_INITIALIZATION_FAILED;
+}
+
+VkResult vlFreezeLayerSettingSet(VlLayerSettingSet layerSettingSet) {
+    assert(layerSettingSet != VK_NULL_HANDLE);
+
+    vl::LayerSettings *layer_setting_set = (vl::LayerSettings *)layerSettingSet;
+
+    const vl::SnapshotReadGuard guard = layer_setting_set->BeginQuery();
+    if (layer_setting_set->GetFrozenSettings() == nullptr) {
+        layer_setting_set->Freeze();
+    }
+
+    return VK_SUCCESS;
 }
 
 VkBool32 vlHasLayerSetting(VlLayerSettingSet layerSettingSet, const char *pSettingName) {
@@ -55,50 +236,225 @@ VkBool32 vlHasLayerSetting(VlLayerSettingSet layerSettingSet, const char *pSetti
 
     vl::LayerSettings *layer_setting_set = (vl::LayerSettings *)layerSettingSet;
 
-    const bool has_env_setting = layer_setting_set->HasEnvSetting(pSettingName);
-    const bool has_file_setting = layer_setting_set->HasFileSetting(pSettingName);
-    const bool has_api_setting = layer_setting_set->HasAPISetting(pSettingName);
+    const vl::SnapshotReadGuard guard = layer_setting_set->BeginQuery();
+
+    const vl::FrozenLayerSettings *frozen_settings = layer_setting_set->GetFrozenSettings();
+    if (frozen_settings != nullptr) {
+        const vl::ResolvedSetting *resolved_setting = frozen_settings->Find(pSettingName);
+        if (resolved_setting != nullptr) {
+            return resolved_setting->value.found ? VK_TRUE : VK_FALSE;
+        }
+    } else if (layer_setting_set->IsResolvedSnapshot()) {
+        return layer_setting_set->GetResolvedSetting(pSettingName).value.found ? VK_TRUE : VK_FALSE;
+    }
 
-    return (has_env_setting || has_file_setting || has_api_setting) ? VK_TRUE : VK_FALSE;
+    return layer_setting_set->HasSetting(pSettingName) ? VK_TRUE : VK_FALSE;
 }
 
-VkResult vlGetLayerSettingValues(VlLayerSettingSet layerSettingSet, const char *pSettingName, VlLayerSettingType type,
-                                 uint32_t *pValueCount, void *pValues) {
-    assert(pValueCount != nullptr);
+static std::size_t GetLayerSettingTypeSize(VlLayerSettingType type) {
+    switch (type) {
+        case VL_LAYER_SETTING_TYPE_BOOL32:
+            return sizeof(VkBool32);
+        case VL_LAYER_SETTING_TYPE_INT32:
+            return sizeof(int32_t);
+        case VL_LAYER_SETTING_TYPE_INT64:
+            return sizeof(int64_t);
+        case VL_LAYER_SETTING_TYPE_UINT32:
+            return sizeof(uint32_t);
+        case VL_LAYER_SETTING_TYPE_UINT64:
+            return sizeof(uint64_t);
+        case VL_LAYER_SETTING_TYPE_FLOAT32:
+            return sizeof(float);
+        case VL_LAYER_SETTING_TYPE_FLOAT64:
+            return sizeof(double);
+        case VL_LAYER_SETTING_TYPE_FRAMESET:
+            return sizeof(VlFrameset);
+        case VL_LAYER_SETTING_TYPE_STRING:
+        case VL_LAYER_SETTING_TYPE_FRAMESET_STRING:
+            return sizeof(const char *);
+        default:
+            return 0;
+    }
+}
 
-    if (layerSettingSet == VK_NULL_HANDLE) {
-        return VK_ERROR_INITIALIZATION_FAILED;
+static void LogParseResult(vl::LayerSettings *layer_setting_set, const char *pSettingName, vl::ParseResult parse_result,
+                           std::string_view setting_value, const char *value_kind) {
+    if (parse_result != vl::PARSE_SUCCESS) {
+        layer_setting_set->Count(&vl::LayerSettingStatistics::parse_failure_count);
     }
 
-    if (!vlHasLayerSetting(layerSettingSet, pSettingName)) {
-        *pValueCount = 0;
+    switch (parse_result) {
+        case vl::PARSE_SUCCESS:
+            break;
+        case vl::PARSE_INVALID: {
+            const std::string &message = vl::FormatString("The data provided (%.*s) is not %s value.",
+                                                          static_cast<int>(setting_value.size()), setting_value.data(), value_kind);
+            layer_setting_set->Log(pSettingName, message.c_str());
+            break;
+        }
+        case vl::PARSE_OUT_OF_RANGE: {
+            const std::string &message =
+                vl::FormatString("The data provided (%.*s) is out of the range of %s value, the value is clamped.",
+                                 static_cast<int>(setting_value.size()), setting_value.data(), value_kind);
+            layer_setting_set->Log(pSettingName, message.c_str());
+            break;
+        }
+    }
+}
+
+// Parse the values from env variable or setting file straight into pValues
+template <typename T, typename Parse>
+static VkResult ParseLayerSettingValues(vl::LayerSettings *layer_setting_set, const char *pSettingName,
+                                        const vl::LayerSettingValue &setting_value, uint32_t *pValueCount, void *pValues,
+                                        const char *value_kind, Parse parse) {
+    if (pValues == nullptr) {
+        *pValueCount = setting_value.count;
         return VK_SUCCESS;
     }
 
-    if (*pValueCount == 0 && pValues != nullptr) {
-        return VK_ERROR_UNKNOWN;
+    T *values = static_cast<T *>(pValues);
+
+    std::size_t position = 0;
+    std::string_view value;
+    for (uint32_t i = 0, n = std::min(*pValueCount, setting_value.count); i < n; ++i) {
+        vl::NextListValue(setting_value.list, setting_value.delimiter, position, value);
+        LogParseResult(layer_setting_set, pSettingName, parse(value, values[i]), value, value_kind);
     }
 
-    vl::LayerSettings *layer_setting_set = (vl::LayerSettings *)layerSettingSet;
+    return *pValueCount < setting_value.count ? VK_INCOMPLETE : VK_SUCCESS;
+}
 
-    // First: search in the environment variables
-    const std::string &env_setting_list = layer_setting_set->GetEnvSetting(pSettingName);
+// Copy the values from Vulkan Layer Setting API, 'count' is the number of values of the requested type
+template <typename T>
+static VkResult CopyLayerSettingValues(const VkLayerSettingEXT *api_setting, uint32_t count, uint32_t *pValueCount,
+                                       void *pValues) {
+    if (pValues == nullptr) {
+        *pValueCount = count;
+        return VK_SUCCESS;
+    }
 
-    // Second: search in vk_layer_settings.txt
-    const std::string &file_setting_list = layer_setting_set->GetFileSetting(pSettingName);
+    std::copy_n(static_cast<const T *>(api_setting->pValues), std::min(*pValueCount, count), static_cast<T *>(pValues));
 
-    // Third: search from VK_EXT_layer_settings usage
-    const VkLayerSettingEXT *api_setting = layer_setting_set->GetAPISetting(pSettingName);
+    return *pValueCount < count ? VK_INCOMPLETE : VK_SUCCESS;
+}
 
-    // Environment variables overrides the values set by vk_layer_settings
-    const std::string setting_list = env_setting_list.empty() ? file_setting_list : env_setting_list;
+template <typename T, typename Parse>
+static VkResult ConvertNumericLayerSettingValues(vl::LayerSettings *layer_setting_set, const char *pSettingName,
+                                                 const vl::LayerSettingValue &setting_value, VlLayerSettingType type,
+                                                 uint32_t *pValueCount, void *pValues, const char *value_kind, Parse parse) {
+    if (setting_value.count > 0) {  // From env variable or setting file
+        return ParseLayerSettingValues<T>(layer_setting_set, pSettingName, setting_value, pValueCount, pValues, value_kind, parse);
+    }
 
-    if (setting_list.empty() && api_setting == nullptr) {
-        return VK_INCOMPLETE;
+    // From Vulkan Layer Setting API
+    const VkLayerSettingEXT *api_setting = setting_value.api_setting;
+    if (static_cast<VlLayerSettingType>(api_setting->type) != type) {
+        return VK_ERROR_FORMAT_NOT_SUPPORTED;
     }
 
-    const char deliminater = vl::FindDelimiter(setting_list);
-    const std::vector<std::string> &settings(vl::Split(setting_list, deliminater));
+    return CopyLayerSettingValues<T>(api_setting, api_setting->count, pValueCount, pValues);
+}
+
+// Large enough for a double formatted with "%f", which has up to 309 integer digits
+static const std::size_t FORMAT_BUFFER_SIZE = 512;
+
+// Numbers of VK_EXT_layer_settings values queried as strings, formatted as with printf "%d", "%u" and "%f"
+template <typename T>
+static std::string_view FormatLayerSettingNumber(char (&buffer)[FORMAT_BUFFER_SIZE], T value) {
+    if constexpr (std::is_floating_point<T>::value) {
+        const int size = std::snprintf(buffer, FORMAT_BUFFER_SIZE, "%f", static_cast<double>(value));
+        return std::string_view(buffer, static_cast<std::size_t>(std::max(size, 0)));
+    } else {
+        const std::to_chars_result result = std::to_chars(buffer, buffer + FORMAT_BUFFER_SIZE, value);
+        return std::string_view(buffer, static_cast<std::size_t>(result.ptr - buffer));
+    }
+}
+
+template <typename T>
+static void InternLayerSettingNumbers(vl::StringPool &string_pool, const VkLayerSettingEXT *api_setting, uint32_t value_count,
+                                      vl::ArenaVector<const char *> &values) {
+    char buffer[FORMAT_BUFFER_SIZE];
+    for (uint32_t i = 0; i < value_count; ++i) {
+        values.push_back(string_pool.Intern(FormatLayerSettingNumber(buffer, static_cast<const T *>(api_setting->pValues)[i])).data());
+    }
+}
+
+// Split or format the values of a STRING or FRAMESET_STRING query once, the interned strings are returned by every
+// following query of the same values
+static VkResult InternLayerSettingStrings(vl::LayerSettings *layer_setting_set, const vl::LayerSettingValue &setting_value,
+                                          VlLayerSettingType type, uint32_t value_count, vl::LayerSettingStrings &strings) {
+    vl::StringPool &string_pool = layer_setting_set->GetStringPool();
+    vl::ArenaVector<const char *> &values = strings.values;
+    values.clear();
+    values.reserve(value_count);
+
+    const VkLayerSettingEXT *api_setting = setting_value.api_setting;
+    if (setting_value.count > 0) {  // From env variable or setting file
+        std::size_t position = 0;
+        std::string_view value;
+        while (vl::NextListValue(setting_value.list, setting_value.delimiter, position, value)) {
+            values.push_back(string_pool.Intern(value).data());
+        }
+    } else if (api_setting->type == VK_LAYER_SETTING_TYPE_STRING_EXT) {
+        for (uint32_t i = 0; i < value_count; ++i) {
+            values.push_back(string_pool.Intern(static_cast<const char *const *>(api_setting->pValues)[i]).data());
+        }
+    } else if (type == VL_LAYER_SETTING_TYPE_FRAMESET_STRING) {
+        if (api_setting->type != VK_LAYER_SETTING_TYPE_UINT32_EXT) {
+            return VK_ERROR_FORMAT_NOT_SUPPORTED;
+        }
+
+        char buffer[FORMAT_BUFFER_SIZE];
+        for (uint32_t i = 0; i < value_count; ++i) {
+            const VlFrameset &frameset = static_cast<const VlFrameset *>(api_setting->pValues)[i];
+            const int size = std::snprintf(buffer, FORMAT_BUFFER_SIZE, "%d-%d-%d", frameset.first, frameset.count, frameset.step);
+            values.push_back(string_pool.Intern(std::string_view(buffer, static_cast<std::size_t>(size))).data());
+        }
+    } else {
+        switch (api_setting->type) {
+            case VK_LAYER_SETTING_TYPE_BOOL32_EXT:
+                for (uint32_t i = 0; i < value_count; ++i) {
+                    values.push_back(static_cast<const VkBool32 *>(api_setting->pValues)[i] == VK_TRUE ? "true" : "false");
+                }
+                break;
+            case VK_LAYER_SETTING_TYPE_INT32_EXT:
+                InternLayerSettingNumbers<int32_t>(string_pool, api_setting, value_count, values);
+                break;
+            case VK_LAYER_SETTING_TYPE_INT64_EXT:
+                InternLayerSettingNumbers<int64_t>(string_pool, api_setting, value_count, values);
+                break;
+            case VK_LAYER_SETTING_TYPE_UINT32_EXT:
+                InternLayerSettingNumbers<uint32_t>(string_pool, api_setting, value_count, values);
+                break;
+            case VK_LAYER_SETTING_TYPE_UINT64_EXT:
+                InternLayerSettingNumbers<uint64_t>(string_pool, api_setting, value_count, values);
+                break;
+            case VK_LAYER_SETTING_TYPE_FLOAT32_EXT:
+                InternLayerSettingNumbers<float>(string_pool, api_setting, value_count, values);
+                break;
+            case VK_LAYER_SETTING_TYPE_FLOAT64_EXT:
+                InternLayerSettingNumbers<double>(string_pool, api_setting, value_count, values);
+                break;
+            default:
+                return VK_ERROR_FORMAT_NOT_SUPPORTED;
+        }
+    }
+
+    strings.type = type;
+    strings.api_setting = api_setting;
+    strings.list.assign(setting_value.list);
+    return VK_SUCCESS;
+}
+
+// Convert the merged values of a setting to the requested type
+static VkResult ConvertLayerSettingValues(vl::LayerSettings *layer_setting_set, const char *pSettingName,
+                                          const vl::LayerSettingValue &setting_value, VlLayerSettingType type,
+                                          uint32_t *pValueCount, void *pValues) {
+    const VkLayerSettingEXT *api_setting = setting_value.api_setting;
+
+    if (setting_value.count == 0 && api_setting == nullptr) {
+        return VK_INCOMPLETE;
+    }
 
     const bool copy_values = *pValueCount > 0 && pValues != nullptr;
 
@@ -108,508 +464,480 @@ VkResult vlGetLayerSettingValues(VlLayerSettingSet layerSettingSet, const char *
             layer_setting_set->Log(pSettingName, message.c_str());
             return VK_ERROR_UNKNOWN;
         }
-        case VL_LAYER_SETTING_TYPE_BOOL32: {
-            std::vector<VkBool32> values;
-            VkResult result = VK_SUCCESS;
-
-            if (!settings.empty()) {  // From env variable or setting file
-                if (copy_values) {
-                    if (static_cast<std::size_t>(*pValueCount) < settings.size()) {
-                        result = VK_INCOMPLETE;
-                    }
-                    values.resize(std::min(static_cast<std::size_t>(*pValueCount), settings.size()));
-
-                    for (std::size_t i = 0, n = values.size(); i < n; ++i) {
-                        const std::string &setting_value = vl::ToLower(settings[i]);
-                        if (vl::IsInteger(setting_value)) {
-                            values[i] = (std::atoi(setting_value.c_str()) != 0) ? VK_TRUE : VK_FALSE;
-                        } else if (setting_value == "true" || setting_value == "false") {
-                            values[i] = (setting_value == "true") ? VK_TRUE : VK_FALSE;
-                        } else if (setting_value == "on" || setting_value == "off") {
-                            values[i] = (setting_value == "on") ? VK_TRUE : VK_FALSE;
-                        } else {
-                            const std::string &message =
-                                vl::FormatString("The data provided (%s) is not a boolean value.", setting_value.c_str());
-                            layer_setting_set->Log(pSettingName, message.c_str());
-                        }
-                    }
-                } else {
-                    *pValueCount = static_cast<std::uint32_t>(settings.size());
-                }
-            } else if (api_setting != nullptr) { // From Vulkan Layer Setting API
-                if (static_cast<VlLayerSettingType>(api_setting->type) != type) {
-                    result = VK_ERROR_FORMAT_NOT_SUPPORTED;
-                } else if (copy_values) {
-                    if (*pValueCount < api_setting->count) {
-                        result = VK_INCOMPLETE;
-                    }
-                    const std::uint32_t size = std::min(*pValueCount, api_setting->count);
-                    const VkBool32 *data = static_cast<const VkBool32 *>(api_setting->pValues);
-                    values.assign(data, data + size);
-                } else {
-                    *pValueCount = api_setting->count;
-                }
+        case VL_LAYER_SETTING_TYPE_BOOL32:
+            return ConvertNumericLayerSettingValues<VkBool32>(layer_setting_set, pSettingName, setting_value, type, pValueCount,
+                                                              pValues, "a boolean", vl::ParseBool);
+        case VL_LAYER_SETTING_TYPE_INT32:
+            return ConvertNumericLayerSettingValues<std::int32_t>(layer_setting_set, pSettingName, setting_value, type, pValueCount,
+                                                                  pValues, "an integer", vl::ParseInteger<std::int32_t>);
+        case VL_LAYER_SETTING_TYPE_INT64:
+            return ConvertNumericLayerSettingValues<std::int64_t>(layer_setting_set, pSettingName, setting_value, type, pValueCount,
+                                                                  pValues, "an integer", vl::ParseInteger<std::int64_t>);
+        case VL_LAYER_SETTING_TYPE_UINT32:
+            return ConvertNumericLayerSettingValues<std::uint32_t>(layer_setting_set, pSettingName, setting_value, type,
+                                                                   pValueCount, pValues, "an integer",
+                                                                   vl::ParseInteger<std::uint32_t>);
+        case VL_LAYER_SETTING_TYPE_UINT64:
+            return ConvertNumericLayerSettingValues<std::uint64_t>(layer_setting_set, pSettingName, setting_value, type,
+                                                                   pValueCount, pValues, "an integer",
+                                                                   vl::ParseInteger<std::uint64_t>);
+        case VL_LAYER_SETTING_TYPE_FLOAT32:
+            return ConvertNumericLayerSettingValues<float>(layer_setting_set, pSettingName, setting_value, type, pValueCount,
+                                                           pValues, "a floating-point", vl::ParseFloat<float>);
+        case VL_LAYER_SETTING_TYPE_FLOAT64:
+            return ConvertNumericLayerSettingValues<double>(layer_setting_set, pSettingName, setting_value, type, pValueCount,
+                                                            pValues, "a floating-point", vl::ParseFloat<double>);
+        case VL_LAYER_SETTING_TYPE_FRAMESET: {
+            if (setting_value.count > 0) {  // From env variable or setting file
+                return ParseLayerSettingValues<VlFrameset>(layer_setting_set, pSettingName, setting_value, pValueCount, pValues,
+                                                           "a FrameSet", vl::ParseFrameSet);
             }
 
-            if (copy_values) {
-                std::copy(values.begin(), values.end(), reinterpret_cast<VkBool32 *>(pValues));
+            // From Vulkan Layer Setting API
+            if (api_setting->type != VK_LAYER_SETTING_TYPE_UINT32_EXT) {
+                return VK_ERROR_FORMAT_NOT_SUPPORTED;
             }
 
-            return result;
+            const uint32_t frameset_count = static_cast<uint32_t>(api_setting->count / (sizeof(VlFrameset) / sizeof(VlFrameset::count)));
+            return CopyLayerSettingValues<VlFrameset>(api_setting, frameset_count, pValueCount, pValues);
         }
-        case VL_LAYER_SETTING_TYPE_INT32: {
-            std::vector<std::int32_t> values;
-            VkResult result = VK_SUCCESS;
-
-            if (!settings.empty()) {  // From env variable or setting file
-                if (copy_values) {
-                    if (static_cast<std::size_t>(*pValueCount) < settings.size()) {
-                        result = VK_INCOMPLETE;
-                    }
-                    values.resize(std::min(static_cast<std::size_t>(*pValueCount), settings.size()));
-
-                    for (std::size_t i = 0, n = values.size(); i < n; ++i) {
-                        const std::string &setting_value = vl::ToLower(settings[i]);
-                        if (vl::IsInteger(setting_value)) {
-                            values[i] = std::atoi(setting_value.c_str());
-                        } else {
-                            const std::string &message =
-                                vl::FormatString("The data provided (%s) is not an integer value.", setting_value.c_str());
-                            layer_setting_set->Log(pSettingName, message.c_str());
-                        }
-                    }
-                } else {
-                    *pValueCount = static_cast<std::uint32_t>(settings.size());
-                }
-            } else if (api_setting != nullptr) {  // From Vulkan Layer Setting API
-                if (static_cast<VlLayerSettingType>(api_setting->type) != type) {
-                    result = VK_ERROR_FORMAT_NOT_SUPPORTED;
-                } else if (copy_values) {
-                    if (*pValueCount < api_setting->count) {
-                        result = VK_INCOMPLETE;
-                    }
-                    const std::uint32_t size = std::min(*pValueCount, api_setting->count);
-                    const int32_t *data = static_cast<const int32_t *>(api_setting->pValues);
-                    values.assign(data, data + size);
-                } else {
-                    *pValueCount = api_setting->count;
-                }
+        case VL_LAYER_SETTING_TYPE_STRING:
+        case VL_LAYER_SETTING_TYPE_FRAMESET_STRING: {
+            // VK_EXT_layer_settings framesets are 3 uint32_t, or one string per frameset
+            uint32_t value_count = setting_value.count;
+            if (value_count == 0) {
+                value_count = type == VL_LAYER_SETTING_TYPE_STRING
+                                  ? api_setting->count
+                                  : static_cast<uint32_t>(api_setting->count / (sizeof(VlFrameset) / sizeof(VlFrameset::count)));
             }
 
-            if (copy_values) {
-                std::copy(values.begin(), values.end(), reinterpret_cast<std::int32_t *>(pValues));
+            if (!copy_values) {
+                *pValueCount = value_count;  // Counting doesn't need to split the list
+                return VK_SUCCESS;
             }
 
-            return result;
-        }
-        case VL_LAYER_SETTING_TYPE_INT64: {
-            std::vector<std::int64_t> values;
-            VkResult result = VK_SUCCESS;
-
-            if (!settings.empty()) {  // From env variable or setting file
-                if (copy_values) {
-                    if (static_cast<std::size_t>(*pValueCount) < settings.size()) {
-                        result = VK_INCOMPLETE;
-                    }
-                    values.resize(std::min(static_cast<std::size_t>(*pValueCount), settings.size()));
-
-                    for (std::size_t i = 0, n = values.size(); i < n; ++i) {
-                        const std::string &setting_value = vl::ToLower(settings[i]);
-                        if (vl::IsInteger(setting_value)) {
-                            values[i] = std::atoll(setting_value.c_str());
-                        } else {
-                            const std::string &message =
-                                vl::FormatString("The data provided (%s) is not an integer value.", setting_value.c_str());
-                            layer_setting_set->Log(pSettingName, message.c_str());
-                        }
-                    }
-                } else {
-                    *pValueCount = static_cast<std::uint32_t>(settings.size());
-                }
-            } else if (api_setting != nullptr) {  // From Vulkan Layer Setting API
-                if (static_cast<VlLayerSettingType>(api_setting->type) != type) {
-                    result = VK_ERROR_FORMAT_NOT_SUPPORTED;
-                } else if (copy_values) {
-                    if (*pValueCount < api_setting->count) {
-                        result = VK_INCOMPLETE;
-                    }
-                    const std::uint32_t size = std::min(*pValueCount, api_setting->count);
-                    const int64_t *data = static_cast<const int64_t *>(api_setting->pValues);
-                    values.assign(data, data + size);
-                } else {
-                    *pValueCount = api_setting->count;
+            vl::LayerSettingStrings &strings = layer_setting_set->GetSettingStrings(pSettingName);
+            if (!strings.IsInternedFrom(setting_value, type)) {
+                const VkResult result = InternLayerSettingStrings(layer_setting_set, setting_value, type, value_count, strings);
+                if (result != VK_SUCCESS) {
+                    return result;
                 }
             }
 
-            if (copy_values) {
-                std::copy(values.begin(), values.end(), reinterpret_cast<std::int64_t *>(pValues));
-            }
+            const std::size_t size = std::min(static_cast<std::size_t>(*pValueCount), strings.values.size());
+            std::copy_n(strings.values.data(), size, static_cast<const char **>(pValues));
 
-            return result;
+            return size < strings.values.size() ? VK_INCOMPLETE : VK_SUCCESS;
         }
-        case VL_LAYER_SETTING_TYPE_UINT32: {
-            std::vector<std::uint32_t> values;
-            VkResult result = VK_SUCCESS;
-
-            if (!settings.empty()) {  // From env variable or setting file
-                if (copy_values) {
-                    if (static_cast<std::size_t>(*pValueCount) < settings.size()) {
-                        result = VK_INCOMPLETE;
-                    }
-                    values.resize(std::min(static_cast<std::size_t>(*pValueCount), settings.size()));
-
-                    for (std::size_t i = 0, n = values.size(); i < n; ++i) {
-                        const std::string &setting_value = vl::ToLower(settings[i]);
-                        if (vl::IsInteger(setting_value)) {
-                            values[i] = std::atoi(setting_value.c_str());
-                        } else {
-                            const std::string &message =
-                                vl::FormatString("The data provided (%s) is not an integer value.", setting_value.c_str());
-                            layer_setting_set->Log(pSettingName, message.c_str());
-                        }
-                    }
-                } else {
-                    *pValueCount = static_cast<std::uint32_t>(settings.size());
-                }
-            } else if (api_setting != nullptr) {  // From Vulkan Layer Setting API
-                if (static_cast<VlLayerSettingType>(api_setting->type) != type) {
-                    result = VK_ERROR_FORMAT_NOT_SUPPORTED;
-                } else if (copy_values) {
-                    if (*pValueCount < api_setting->count) {
-                        result = VK_INCOMPLETE;
-                    }
-                    const uint32_t size = std::min(*pValueCount, api_setting->count);
-                    const uint32_t *data = static_cast<const uint32_t *>(api_setting->pValues);
-                    values.assign(data, data + size);
-                } else {
-                    *pValueCount = api_setting->count;
-                }
-            }
+    }
+}
 
-            if (copy_values) {
-                std::copy(values.begin(), values.end(), reinterpret_cast<std::uint32_t *>(pValues));
-            }
+// Record the complete result of a query so that the resolved snapshot only needs to copy it
+static vl::ArenaPtr<vl::LayerSettingTypedValues> ResolveLayerSettingTypedValues(vl::LayerSettings *layer_setting_set,
+                                                                                   const char *pSettingName,
+                                                                                   const vl::LayerSettingValue &setting_value,
+                                                                                   VlLayerSettingType type) {
+    vl::Arena &arena = layer_setting_set->GetArena();
+    vl::ArenaPtr<vl::LayerSettingTypedValues> typed_values = vl::MakeArenaPtr<vl::LayerSettingTypedValues>(arena, &arena);
+
+    // Messages are logged by each query instead of the first one only
+    vl::LayerSettings::CaptureLog(&typed_values->log_messages);
+
+    uint32_t count = 0;
+    typed_values->count_result = ConvertLayerSettingValues(layer_setting_set, pSettingName, setting_value, type, &count, nullptr);
+    if (typed_values->count_result == VK_SUCCESS && count > 0) {
+        typed_values->count = count;
+        typed_values->data.resize(count * GetLayerSettingTypeSize(type));
+        typed_values->result =
+            ConvertLayerSettingValues(layer_setting_set, pSettingName, setting_value, type, &count, typed_values->data.data());
 
-            return result;
-        }
-        case VL_LAYER_SETTING_TYPE_UINT64: {
-            std::vector<std::uint64_t> values;
-            VkResult result = VK_SUCCESS;
-
-            if (!settings.empty()) {  // From env variable or setting file
-                if (copy_values) {
-                    if (static_cast<std::size_t>(*pValueCount) < settings.size()) {
-                        result = VK_INCOMPLETE;
-                    }
-                    values.resize(std::min(static_cast<std::size_t>(*pValueCount), settings.size()));
-
-                    for (std::size_t i = 0, n = values.size(); i < n; ++i) {
-                        const std::string &setting_value = vl::ToLower(settings[i]);
-                        if (vl::IsInteger(setting_value)) {
-                            values[i] = std::atoll(setting_value.c_str());
-                        } else {
-                            const std::string &message =
-                                vl::FormatString("The data provided (%s) is not an integer value.", setting_value.c_str());
-                            layer_setting_set->Log(pSettingName, message.c_str());
-                        }
-                    }
-                } else {
-                    *pValueCount = static_cast<std::uint32_t>(settings.size());
-                }
-            } else if (api_setting != nullptr) {  // From Vulkan Layer Setting API
-                if (static_cast<VlLayerSettingType>(api_setting->type) != type) {
-                    result = VK_ERROR_FORMAT_NOT_SUPPORTED;
-                } else if (copy_values) {
-                    if (*pValueCount < api_setting->count) {
-                        result = VK_INCOMPLETE;
-                    }
-                    const std::uint32_t size = std::min(*pValueCount, api_setting->count);
-                    const uint64_t *data = static_cast<const uint64_t *>(api_setting->pValues);
-                    values.assign(data, data + size);
-                } else {
-                    *pValueCount = api_setting->count;
-                }
-            }
+    }
 
-            if (copy_values) {
-                std::copy(values.begin(), values.end(), reinterpret_cast<std::uint64_t *>(pValues));
-            }
+    vl::LayerSettings::CaptureLog(nullptr);
+
+    return typed_values;
+}
+
+vl::ArenaPtr<vl::ResolvedSetting> vl::ResolveLayerSetting(vl::LayerSettings &layer_settings, const char *pSettingName) {
+    vl::Arena &arena = layer_settings.GetArena();
+    vl::ArenaPtr<vl::ResolvedSetting> resolved_setting = vl::MakeArenaPtr<vl::ResolvedSetting>(arena, &arena);
+    resolved_setting->name = pSettingName;
+    resolved_setting->value = layer_settings.GetSettingValue(pSettingName);
 
-            return result;
+    if (resolved_setting->value.found) {
+        for (std::size_t type_index = 0; type_index < vl::LAYER_SETTING_TYPE_COUNT; ++type_index) {
+            resolved_setting->typed_values[type_index] = ResolveLayerSettingTypedValues(
+                &layer_settings, pSettingName, resolved_setting->value, static_cast<VlLayerSettingType>(type_index));
         }
-        case VL_LAYER_SETTING_TYPE_FLOAT32: {
-            std::vector<float> values;
-            VkResult result = VK_SUCCESS;
-
-            if (!settings.empty()) {  // From env variable or setting file
-                if (copy_values) {
-                    if (static_cast<std::size_t>(*pValueCount) < settings.size()) {
-                        result = VK_INCOMPLETE;
-                    }
-                    values.resize(std::min(static_cast<std::size_t>(*pValueCount), settings.size()));
-
-                    for (std::size_t i = 0, n = values.size(); i < n; ++i) {
-                        const std::string &setting_value = vl::ToLower(settings[i]);
-                        if (vl::IsFloat(setting_value)) {
-                            values[i] = static_cast<float>(std::atof(setting_value.c_str()));
-                        } else {
-                            const std::string &message =
-                                vl::FormatString("The data provided (%s) is not a floating-point value.", setting_value.c_str());
-                            layer_setting_set->Log(pSettingName, message.c_str());
-                        }
-                    }
-                } else {
-                    *pValueCount = static_cast<std::uint32_t>(settings.size());
-                }
-            } else if (api_setting != nullptr) {  // From Vulkan Layer Setting API
-                if (static_cast<VlLayerSettingType>(api_setting->type) != type) {
-                    result = VK_ERROR_FORMAT_NOT_SUPPORTED;
-                } else if (copy_values) {
-                    if (*pValueCount < api_setting->count) {
-                        result = VK_INCOMPLETE;
-                    }
-                    const std::uint32_t size = std::min(*pValueCount, api_setting->count);
-                    const float *data = static_cast<const float *>(api_setting->pValues);
-                    values.assign(data, data + size);
-                } else {
-                    *pValueCount = api_setting->count;
-                }
-            }
+    }
 
-            if (copy_values) {
-                std::copy(values.begin(), values.end(), reinterpret_cast<float *>(pValues));
-            }
+    return resolved_setting;
+}
+
+// Copy the values recorded by ResolveLayerSettingTypedValues, it only reads 'typed_values'
+static VkResult CopyLayerSettingTypedValues(vl::LayerSettings *layer_setting_set, const char *pSettingName,
+                                            const vl::LayerSettingTypedValues &typed_values, VlLayerSettingType type,
+                                            uint32_t *pValueCount, void *pValues) {
+    for (const vl::ArenaString &message : typed_values.log_messages) {
+        layer_setting_set->Log(pSettingName, message.c_str());
+    }
+
+    if (typed_values.count_result != VK_SUCCESS) {
+        return typed_values.count_result;
+    }
+
+    if (pValues == nullptr) {
+        *pValueCount = typed_values.count;
+        return VK_SUCCESS;
+    }
+
+    const uint32_t copy_count = std::min(*pValueCount, typed_values.count);
+    if (copy_count > 0) {
+        std::memcpy(pValues, typed_values.data.data(), copy_count * GetLayerSettingTypeSize(type));
+    }
+
+    if (typed_values.result != VK_SUCCESS) {
+        return typed_values.result;
+    }
+
+    return *pValueCount < typed_values.count ? VK_INCOMPLETE : VK_SUCCESS;
+}
+
+static VkResult GetResolvedLayerSettingValues(vl::LayerSettings *layer_setting_set, const char *pSettingName,
+                                              VlLayerSettingType type, uint32_t *pValueCount, void *pValues) {
+    vl::ResolvedSetting &resolved_setting = layer_setting_set->GetResolvedSetting(pSettingName);
+
+    if (!resolved_setting.value.found) {
+        *pValueCount = 0;
+        return VK_SUCCESS;
+    }
+
+    if (*pValueCount == 0 && pValues != nullptr) {
+        return VK_ERROR_UNKNOWN;
+    }
 
-            return result;
+    const std::size_t type_index = static_cast<std::size_t>(type);
+    if (type_index >= vl::LAYER_SETTING_TYPE_COUNT) {
+        return ConvertLayerSettingValues(layer_setting_set, pSettingName, resolved_setting.value, type, pValueCount, pValues);
+    }
+
+    vl::ArenaPtr<vl::LayerSettingTypedValues> &typed_values = resolved_setting.typed_values[type_index];
+    if (typed_values == nullptr) {
+        layer_setting_set->Count(&vl::LayerSettingStatistics::cache_miss_count);
+        typed_values = ResolveLayerSettingTypedValues(layer_setting_set, pSettingName, resolved_setting.value, type);
+    } else {
+        layer_setting_set->Count(&vl::LayerSettingStatistics::cache_hit_count);
+    }
+
+    return CopyLayerSettingTypedValues(layer_setting_set, pSettingName, *typed_values, type, pValueCount, pValues);
+}
+
+// Queries of a frozen layer setting set only read the frozen settings and the presence filter, without locking or
+// allocating. Only names with a different case than the sources are resolved after freezing, under the frozen mutex.
+static VkResult GetFrozenLayerSettingValues(vl::LayerSettings *layer_setting_set, const vl::FrozenLayerSettings &frozen_settings,
+                                            const char *pSettingName, uint64_t setting_name_hash, VlLayerSettingType type,
+                                            uint32_t *pValueCount, void *pValues) {
+    const vl::ResolvedSetting *resolved_setting = frozen_settings.Find(pSettingName, setting_name_hash);
+
+    std::unique_lock<std::mutex> lock(layer_setting_set->GetFrozenMutex(), std::defer_lock);
+    if (resolved_setting == nullptr) {
+        // Every setting set by a source is frozen, so most names missing from the frozen settings are set by no source
+        if (!layer_setting_set->MayHaveSetting(setting_name_hash)) {
+            layer_setting_set->Count(&vl::LayerSettingStatistics::cache_hit_count);
+            *pValueCount = 0;
+            return VK_SUCCESS;
         }
-        case VL_LAYER_SETTING_TYPE_FLOAT64: {
-            std::vector<double> values;
-            VkResult result = VK_SUCCESS;
-
-            if (!settings.empty()) {  // From env variable or setting file
-                if (copy_values) {
-                    if (static_cast<std::size_t>(*pValueCount) < settings.size()) {
-                        result = VK_INCOMPLETE;
-                    }
-                    values.resize(std::min(static_cast<std::size_t>(*pValueCount), settings.size()));
-
-                    for (std::size_t i = 0, n = values.size(); i < n; ++i) {
-                        const std::string &setting_value = vl::ToLower(settings[i]);
-                        if (vl::IsFloat(setting_value)) {
-                            values[i] = std::atof(setting_value.c_str());
-                        } else {
-                            const std::string &message =
-                                vl::FormatString("The data provided (%s) is not a floating-point value.", setting_value.c_str());
-                            layer_setting_set->Log(pSettingName, message.c_str());
-                        }
-                    }
-                } else {
-                    *pValueCount = static_cast<std::uint32_t>(settings.size());
-                }
-            } else if (api_setting != nullptr) {  // From Vulkan Layer Setting API
-                if (static_cast<VlLayerSettingType>(api_setting->type) != type) {
-                    result = VK_ERROR_FORMAT_NOT_SUPPORTED;
-                } else if (copy_values) {
-                    if (*pValueCount < api_setting->count) {
-                        result = VK_INCOMPLETE;
-                    }
-                    const std::uint32_t size = std::min(*pValueCount, api_setting->count);
-                    const double *data = static_cast<const double *>(api_setting->pValues);
-                    values.assign(data, data + size);
-                } else {
-                    *pValueCount = api_setting->count;
-                }
-            }
 
-            if (copy_values) {
-                std::copy(values.begin(), values.end(), reinterpret_cast<double *>(pValues));
-            }
+        lock.lock();
 
-            return result;
+        auto late_setting = frozen_settings.late_settings.find(std::string_view(pSettingName));
+        if (late_setting == frozen_settings.late_settings.end()) {
+            layer_setting_set->Count(&vl::LayerSettingStatistics::cache_miss_count);
+            late_setting =
+                frozen_settings.late_settings
+                    .emplace(vl::ArenaString(pSettingName, vl::ArenaAllocator<char>(&layer_setting_set->GetArena())),
+                             vl::ResolveLayerSetting(*layer_setting_set, pSettingName))
+                    .first;
         }
-        case VL_LAYER_SETTING_TYPE_FRAMESET: {
-            std::vector<VlFrameset> values;
-            VkResult result = VK_SUCCESS;
-
-            if (!settings.empty()) {  // From env variable or setting file
-                if (copy_values) {
-                    if (static_cast<std::size_t>(*pValueCount) < settings.size()) {
-                        result = VK_INCOMPLETE;
-                    }
-                    values.resize(std::min(static_cast<std::size_t>(*pValueCount), settings.size()));
-
-                    for (std::size_t i = 0, n = values.size(); i < n; ++i) {
-                        const std::string &setting_value = vl::ToLower(settings[i]);
-                        if (vl::IsFrameSets(setting_value)) {
-                            values[i] = vl::ToFrameSet(setting_value.c_str());
-                        } else {
-                            const std::string &message =
-                                vl::FormatString("The data provided (%s) is not a FrameSet value.", setting_value.c_str());
-                            layer_setting_set->Log(pSettingName, message.c_str());
-                        }
-                    }
-                } else {
-                    *pValueCount = static_cast<std::uint32_t>(settings.size());
-                }
-            } else if (api_setting != nullptr) {  // From Vulkan Layer Setting API
-                const uint32_t frameset_count = static_cast<uint32_t>(api_setting->count / (sizeof(VlFrameset) / sizeof(VlFrameset::count)));
-                if (api_setting->type != VK_LAYER_SETTING_TYPE_UINT32_EXT) {
-                    result = VK_ERROR_FORMAT_NOT_SUPPORTED;
-                } else if (copy_values) {
-                    if (*pValueCount < frameset_count) {
-                        result = VK_INCOMPLETE;
-                    }
-                    const std::uint32_t count = std::min(*pValueCount, frameset_count);
-                    const VlFrameset *data = static_cast<const VlFrameset *>(api_setting->pValues);
-                    values.assign(data, data + count);
-                } else {
-                    *pValueCount = frameset_count;
-                }
-            }
+        resolved_setting = late_setting->second.get();
+    } else {
+        layer_setting_set->Count(&vl::LayerSettingStatistics::cache_hit_count);
+    }
 
-            if (copy_values) {
-                std::copy(values.begin(), values.end(), reinterpret_cast<VlFrameset *>(pValues));
-            }
+    if (!resolved_setting->value.found) {
+        *pValueCount = 0;
+        return VK_SUCCESS;
+    }
+
+    if (*pValueCount == 0 && pValues != nullptr) {
+        return VK_ERROR_UNKNOWN;
+    }
 
-            return result;
+    const std::size_t type_index = static_cast<std::size_t>(type);
+    if (type_index >= vl::LAYER_SETTING_TYPE_COUNT) {
+        // Not a type, the conversion only logs it
+        return ConvertLayerSettingValues(layer_setting_set, pSettingName, resolved_setting->value, type, pValueCount, pValues);
+    }
+
+    return CopyLayerSettingTypedValues(layer_setting_set, pSettingName, *resolved_setting->typed_values[type_index], type,
+                                       pValueCount, pValues);
+}
+
+// 'setting_name_hash' is vl::HashSettingName(pSettingName)
+static VkResult GetLayerSettingValues(vl::LayerSettings *layer_setting_set, const char *pSettingName, uint64_t setting_name_hash,
+                                      VlLayerSettingType type, uint32_t *pValueCount, void *pValues) {
+    const vl::FrozenLayerSettings *frozen_settings = layer_setting_set->GetFrozenSettings();
+    if (frozen_settings != nullptr) {
+        return GetFrozenLayerSettingValues(layer_setting_set, *frozen_settings, pSettingName, setting_name_hash, type,
+                                           pValueCount, pValues);
+    }
+
+    if (layer_setting_set->IsResolvedSnapshot()) {
+        return GetResolvedLayerSettingValues(layer_setting_set, pSettingName, type, pValueCount, pValues);
+    }
+
+    const vl::LayerSettingValue &setting_value = layer_setting_set->GetSettingValue(pSettingName, setting_name_hash);
+
+    if (!setting_value.found) {
+        *pValueCount = 0;
+        return VK_SUCCESS;
+    }
+
+    if (*pValueCount == 0 && pValues != nullptr) {
+        return VK_ERROR_UNKNOWN;
+    }
+
+    return ConvertLayerSettingValues(layer_setting_set, pSettingName, setting_value, type, pValueCount, pValues);
+}
+
+VkResult vlGetLayerSettingValues(VlLayerSettingSet layerSettingSet, const char *pSettingName, VlLayerSettingType type,
+                                 uint32_t *pValueCount, void *pValues) {
+    assert(pValueCount != nullptr);
+
+    if (layerSettingSet == VK_NULL_HANDLE) {
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    vl::LayerSettings *layer_setting_set = (vl::LayerSettings *)layerSettingSet;
+
+    vl::StatisticsTimer timer(layer_setting_set->GetStatistics(), &vl::LayerSettingStatistics::get_values_ns);
+    layer_setting_set->Count(&vl::LayerSettingStatistics::get_values_count);
+
+    const vl::SnapshotReadGuard guard = layer_setting_set->BeginQuery();
+
+    return GetLayerSettingValues(layer_setting_set, pSettingName, vl::HashSettingName(pSettingName), type, pValueCount, pValues);
+}
+
+VkResult vlGetLayerSettingValuesBatch(VlLayerSettingSet layerSettingSet, uint32_t queryCount, VlLayerSettingQuery *pQueries) {
+    assert(queryCount == 0 || pQueries != nullptr);
+
+    if (layerSettingSet == VK_NULL_HANDLE) {
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    vl::LayerSettings *layer_setting_set = (vl::LayerSettings *)layerSettingSet;
+
+    vl::StatisticsTimer timer(layer_setting_set->GetStatistics(), &vl::LayerSettingStatistics::get_values_ns);
+    layer_setting_set->Count(&vl::LayerSettingStatistics::get_values_count, queryCount);
+
+    // The overlay is checked once for the whole batch
+    const vl::SnapshotReadGuard guard = layer_setting_set->BeginQuery();
+
+    VkResult result = VK_SUCCESS;
+    for (uint32_t query_index = 0; query_index < queryCount; ++query_index) {
+        VlLayerSettingQuery &query = pQueries[query_index];
+        assert(query.pSettingName != nullptr);
+
+        // The name is hashed once for the lookups in every source
+        query.result = GetLayerSettingValues(layer_setting_set, query.pSettingName, vl::HashSettingName(query.pSettingName),
+                                             query.type, &query.valueCount, query.pValues);
+        if (result == VK_SUCCESS) {
+            result = query.result;
         }
-        case VL_LAYER_SETTING_TYPE_STRING: {
-            VkResult result = VK_SUCCESS;
+    }
+
+    return result;
+}
+
+// The prefix of vlEnumerateLayerSettings, without the trailing '*'
+static std::string_view GetEnumeratePrefix(const char *pPrefix) {
+    std::string_view prefix = pPrefix == nullptr ? std::string_view() : std::string_view(pPrefix);
+    if (!prefix.empty() && prefix.back() == '*') {
+        prefix.remove_suffix(1);
+    }
+    return prefix;
+}
 
-            std::vector<std::string> &settings_cache = layer_setting_set->GetSettingCache(pSettingName);
+VkResult vlEnumerateLayerSettings(VlLayerSettingSet layerSettingSet, const char *pPrefix, uint32_t *pSettingCount,
+                                  VlLayerSettingInfo *pSettings) {
+    assert(layerSettingSet != VK_NULL_HANDLE);
+    assert(pSettingCount != nullptr);
 
-            if (!settings.empty()) {  // From env variable or setting file
-                settings_cache = settings;
+    vl::LayerSettings *layer_setting_set = (vl::LayerSettings *)layerSettingSet;
 
-                if (copy_values) {
-                    if (static_cast<std::size_t>(*pValueCount) < settings_cache.size()) {
-                        result = VK_INCOMPLETE;
-                    }
-                } else {
-                    *pValueCount = static_cast<std::uint32_t>(settings_cache.size());
-                }
-            } else if (api_setting != nullptr) {  // From Vulkan Layer Setting API
-                if (copy_values) {
-                    if (*pValueCount < api_setting->count) {
-                        result = VK_INCOMPLETE;
-                    }
-                    const std::uint32_t size = std::min(*pValueCount, api_setting->count);
-                    settings_cache.resize(size);
-
-                    switch (api_setting->type) {
-                        case VK_LAYER_SETTING_TYPE_STRING_EXT:
-                            for (std::size_t i = 0, n = settings_cache.size(); i < n; ++i) {
-                                settings_cache[i] = reinterpret_cast<const char * const *>(api_setting->pValues)[i];
-                            }
-                            break;
-                        case VK_LAYER_SETTING_TYPE_BOOL32_EXT:
-                            for (std::size_t i = 0, n = settings_cache.size(); i < n; ++i) {
-                                settings_cache[i] =
-                                    static_cast<const VkBool32 *>(api_setting->pValues)[i] == VK_TRUE ? "true" : "false";
-                            }
-                            break;
-                        case VK_LAYER_SETTING_TYPE_INT32_EXT:
-                            for (std::size_t i = 0, n = settings_cache.size(); i < n; ++i) {
-                                settings_cache[i] = vl::FormatString("%d", static_cast<const int32_t *>(api_setting->pValues)[i]);
-                            }
-                            break;
-                        case VK_LAYER_SETTING_TYPE_INT64_EXT:
-                            for (std::size_t i = 0, n = settings_cache.size(); i < n; ++i) {
-                                settings_cache[i] = vl::FormatString("%lld", static_cast<const int64_t *>(api_setting->pValues)[i]);
-                            }
-                            break;
-                        case VK_LAYER_SETTING_TYPE_UINT32_EXT:
-                            for (std::size_t i = 0, n = settings_cache.size(); i < n; ++i) {
-                                settings_cache[i] = vl::FormatString("%u", static_cast<const uint32_t *>(api_setting->pValues)[i]);
-                            }
-                            break;
-                        case VK_LAYER_SETTING_TYPE_UINT64_EXT:
-                            for (std::size_t i = 0, n = settings_cache.size(); i < n; ++i) {
-                                settings_cache[i] = vl::FormatString("%llu", static_cast<const uint64_t *>(api_setting->pValues)[i]);
-                            }
-                            break;
-                        case VK_LAYER_SETTING_TYPE_FLOAT32_EXT:
-                            for (std::size_t i = 0, n = settings_cache.size(); i < n; ++i) {
-                                settings_cache[i] = vl::FormatString("%f", static_cast<const float *>(api_setting->pValues)[i]);
-                            }
-                            break;
-                        case VK_LAYER_SETTING_TYPE_FLOAT64_EXT:
-                            for (std::size_t i = 0, n = settings_cache.size(); i < n; ++i) {
-                                settings_cache[i] = vl::FormatString("%f", static_cast<const double *>(api_setting->pValues)[i]);
-                            }
-                            break;
-                        default:
-                            result = VK_ERROR_FORMAT_NOT_SUPPORTED;
-                            break;
-                    }
-                } else {
-                    *pValueCount = api_setting->count;
-                }
-            }
+    const vl::SnapshotReadGuard guard = layer_setting_set->BeginQuery();
 
-            if (copy_values) {
-                for (std::size_t i = 0, n = std::min(static_cast<std::size_t>(*pValueCount), settings_cache.size()); i < n; ++i) {
-                    reinterpret_cast<const char **>(pValues)[i] = settings_cache[i].c_str();
-                }
+    const std::vector<VlLayerSettingInfo> &settings = layer_setting_set->EnumerateSettings(GetEnumeratePrefix(pPrefix), false);
+
+    if (pSettings == nullptr) {
+        *pSettingCount = static_cast<uint32_t>(settings.size());
+        return VK_SUCCESS;
+    }
+
+    const uint32_t copy_count = std::min(*pSettingCount, static_cast<uint32_t>(settings.size()));
+    std::copy(settings.begin(), settings.begin() + copy_count, pSettings);
+    *pSettingCount = copy_count;
+
+    return copy_count < settings.size() ? VK_INCOMPLETE : VK_SUCCESS;
+}
+
+VkResult vlEnumerateLayerSettings(VlLayerSettingSet layerSettingSet, const char *pPrefix, std::vector<VlLayerSettingInfo> &settings) {
+    assert(layerSettingSet != VK_NULL_HANDLE);
+
+    vl::LayerSettings *layer_setting_set = (vl::LayerSettings *)layerSettingSet;
+
+    const vl::SnapshotReadGuard guard = layer_setting_set->BeginQuery();
+
+    settings = layer_setting_set->EnumerateSettings(GetEnumeratePrefix(pPrefix), false);
+
+    return VK_SUCCESS;
+}
+
+uint64_t vlGetLayerSettingsFingerprint(VlLayerSettingSet layerSettingSet) {
+    assert(layerSettingSet != VK_NULL_HANDLE);
+
+    vl::LayerSettings *layer_setting_set = (vl::LayerSettings *)layerSettingSet;
+
+    const vl::SnapshotReadGuard guard = layer_setting_set->BeginQuery();
+
+    const vl::FrozenLayerSettings *frozen_settings = layer_setting_set->GetFrozenSettings();
+    if (frozen_settings != nullptr) {
+        return frozen_settings->fingerprint;
+    }
+
+    // Read first, so that a change of the sources while computing leaves a stale generation
+    const uint64_t source_generation = layer_setting_set->GetSourceGeneration();
+    uint64_t fingerprint = 0;
+    if (layer_setting_set->FindFingerprint(source_generation, fingerprint)) {
+        return fingerprint;
+    }
+
+    fingerprint = 0;
+    std::vector<const char *> values;
+    // Every setting changing the query results is folded, including the VK_ names of environment variables which aren't
+    // enumerated
+    for (const VlLayerSettingInfo &setting : layer_setting_set->EnumerateSettings(std::string_view(), true)) {
+        const uint64_t setting_name_hash = vl::HashSettingName(setting.pSettingName);
+
+        uint32_t value_count = 0;
+        if (GetLayerSettingValues(layer_setting_set, setting.pSettingName, setting_name_hash, VL_LAYER_SETTING_TYPE_STRING,
+                                  &value_count, nullptr) == VK_SUCCESS) {
+            values.resize(value_count);
+            if (GetLayerSettingValues(layer_setting_set, setting.pSettingName, setting_name_hash, VL_LAYER_SETTING_TYPE_STRING,
+                                      &value_count, values.data()) != VK_SUCCESS) {
+                value_count = 0;
             }
+        }
 
-            return result;
+        const VkLayerSettingEXT *api_setting =
+            setting.source == VL_LAYER_SETTING_SOURCE_API ? layer_setting_set->GetAPISetting(setting.pSettingName) : nullptr;
+        fingerprint = vl::FingerprintLayerSetting(fingerprint, setting.pSettingName, api_setting, value_count, values.data());
+    }
+
+    layer_setting_set->CacheFingerprint(source_generation, fingerprint);
+    return fingerprint;
+}
+
+static_assert(vlHashLayerSettingName("Layer_Setting_0") == vl::HashSettingName("Layer_Setting_0"),
+              "The settings schema must hash setting names like the layer setting set indices");
+
+// Values of a setting recorded by a frozen or resolved snapshot layer setting set, nullptr if they aren't resolved yet
+static const vl::LayerSettingTypedValues *FindResolvedTypedValues(vl::LayerSettings *layer_setting_set,
+                                                                  const VlLayerSettingField &field) {
+    const std::size_t type_index = static_cast<std::size_t>(field.type);
+
+    const vl::FrozenLayerSettings *frozen_settings = layer_setting_set->GetFrozenSettings();
+    if (frozen_settings != nullptr) {
+        const vl::ResolvedSetting *resolved_setting = frozen_settings->Find(field.pSettingName, field.settingNameHash);
+        if (resolved_setting != nullptr) {
+            layer_setting_set->Count(&vl::LayerSettingStatistics::cache_hit_count);
         }
-        case VL_LAYER_SETTING_TYPE_FRAMESET_STRING: {
-            VkResult result = VK_SUCCESS;
+        return resolved_setting == nullptr || !resolved_setting->value.found ? nullptr
+                                                                             : resolved_setting->typed_values[type_index].get();
+    }
+
+    vl::ResolvedSetting &resolved_setting = layer_setting_set->GetResolvedSetting(field.pSettingName);
+    if (!resolved_setting.value.found) {
+        return nullptr;
+    }
 
-            std::vector<std::string> &settings_cache = layer_setting_set->GetSettingCache(pSettingName);
+    vl::ArenaPtr<vl::LayerSettingTypedValues> &typed_values = resolved_setting.typed_values[type_index];
+    if (typed_values == nullptr) {
+        layer_setting_set->Count(&vl::LayerSettingStatistics::cache_miss_count);
+        typed_values = ResolveLayerSettingTypedValues(layer_setting_set, field.pSettingName, resolved_setting.value, field.type);
+    } else {
+        layer_setting_set->Count(&vl::LayerSettingStatistics::cache_hit_count);
+    }
+    return typed_values.get();
+}
 
-            if (!settings.empty()) {  // From env variable or setting file
-                settings_cache = settings;
+void vlGetLayerSettingFields(VlLayerSettingSet layerSettingSet, uint32_t fieldCount, const VlLayerSettingField *pFields) {
+    assert(layerSettingSet != VK_NULL_HANDLE);
+    assert(fieldCount == 0 || pFields != nullptr);
 
-                if (copy_values) {
-                    if (static_cast<std::size_t>(*pValueCount) < settings_cache.size()) {
-                        result = VK_INCOMPLETE;
-                    }
-                } else {
-                    *pValueCount = static_cast<std::uint32_t>(settings_cache.size());
+    vl::LayerSettings *layer_setting_set = (vl::LayerSettings *)layerSettingSet;
+
+    const vl::SnapshotReadGuard guard = layer_setting_set->BeginQuery();
+
+    const bool resolved = layer_setting_set->GetFrozenSettings() != nullptr || layer_setting_set->IsResolvedSnapshot();
+
+    std::vector<uint8_t> values;
+    for (uint32_t field_index = 0; field_index < fieldCount; ++field_index) {
+        const VlLayerSettingField &field = pFields[field_index];
+        assert(static_cast<std::size_t>(field.type) < vl::LAYER_SETTING_TYPE_COUNT);
+
+        if (resolved) {
+            const vl::LayerSettingTypedValues *typed_values = FindResolvedTypedValues(layer_setting_set, field);
+            if (typed_values != nullptr) {
+                for (const vl::ArenaString &message : typed_values->log_messages) {
+                    layer_setting_set->Log(field.pSettingName, message.c_str());
                 }
-            } else if (api_setting != nullptr) {  // From Vulkan Layer Setting API
-                const std::uint32_t frameset_count =
-                    static_cast<uint32_t>(api_setting->count / (sizeof(VlFrameset) / sizeof(VlFrameset::count)));
-
-                if (copy_values) {
-                    if (*pValueCount < frameset_count) {
-                        result = VK_INCOMPLETE;
-                    }
-                    const std::uint32_t size = std::min(*pValueCount, frameset_count);
-                    settings_cache.resize(size);
-
-                    switch (api_setting->type) {
-                        case VK_LAYER_SETTING_TYPE_STRING_EXT:
-                            for (std::size_t i = 0, n = settings_cache.size(); i < n; ++i) {
-                                settings_cache[i] = reinterpret_cast<const char *const *>(api_setting->pValues)[i];
-                            }
-                            break;
-                        case VK_LAYER_SETTING_TYPE_UINT32_EXT:
-                            for (std::size_t i = 0, n = settings_cache.size(); i < n; ++i) {
-                                const VlFrameset *asFramesets = static_cast<const VlFrameset *>(api_setting->pValues);
-                                settings_cache[i] = vl::FormatString("%d-%d-%d",
-                                    asFramesets[i].first, asFramesets[i].count, asFramesets[i].step);
-                            }
-                            break;
-                        default:
-                            result = VK_ERROR_FORMAT_NOT_SUPPORTED;
-                            break;
-                    }
-                } else {
-                    *pValueCount = frameset_count;
+                if (typed_values->count_result == VK_SUCCESS && typed_values->result == VK_SUCCESS && typed_values->count > 0) {
+                    field.pAssign(field.pStorage, typed_values->count, typed_values->data.data());
                 }
+                continue;
             }
 
-            if (copy_values) {
-                for (std::size_t i = 0, n = std::min(static_cast<std::size_t>(*pValueCount), settings_cache.size()); i < n; ++i) {
-                    reinterpret_cast<const char **>(pValues)[i] = settings_cache[i].c_str();
+            // Settings missing from the frozen settings, such as names with a different case, take the query path
+            uint32_t value_count = 0;
+            GetLayerSettingValues(layer_setting_set, field.pSettingName, field.settingNameHash, field.type, &value_count, nullptr);
+            if (value_count > 0) {
+                values.resize(value_count * GetLayerSettingTypeSize(field.type));
+                if (GetLayerSettingValues(layer_setting_set, field.pSettingName, field.settingNameHash, field.type, &value_count,
+                                          values.data()) == VK_SUCCESS) {
+                    field.pAssign(field.pStorage, value_count, values.data());
                 }
             }
+            continue;
+        }
+
+        // Each source is searched once, counting the values doesn't parse them
+        const vl::LayerSettingValue &setting_value = layer_setting_set->GetSettingValue(field.pSettingName, field.settingNameHash);
+        if (!setting_value.found) {
+            continue;
+        }
+
+        uint32_t value_count = 0;
+        if (ConvertLayerSettingValues(layer_setting_set, field.pSettingName, setting_value, field.type, &value_count, nullptr) !=
+                VK_SUCCESS ||
+            value_count == 0) {
+            continue;
+        }
 
-            return result;
+        values.resize(value_count * GetLayerSettingTypeSize(field.type));
+        if (ConvertLayerSettingValues(layer_setting_set, field.pSettingName, setting_value, field.type, &value_count,
+                                      values.data()) == VK_SUCCESS) {
+            field.pAssign(field.pStorage, value_count, values.data());
         }
     }
 }
@@ -638,46 +966,156 @@ static bool vlHasSetting(uint32_t settingsCount, const char **pSettings, const c
     return false;
 }
 
-VkResult vlGetUnknownSettings(const VkLayerSettingsCreateInfoEXT* pCreateInfo, uint32_t settingsCount, const char** pSettings,
-    uint32_t* pUnknownSettingCount, const char** pUnknownSettings) {
-    assert(pUnknownSettingCount != nullptr);
+static VkResult GetUnknownSettingsResult(uint32_t unknown_setting_count, uint32_t *pUnknownSettingCount,
+                                         const char **pUnknownSettings) {
+    if (pUnknownSettings == nullptr) {
+        *pUnknownSettingCount = unknown_setting_count;
+        return VK_SUCCESS;
+    } else if (unknown_setting_count > *pUnknownSettingCount) {
+        return VK_INCOMPLETE;
+    } else {
+        return VK_SUCCESS;
+    }
+}
 
-    uint32_t current_unknown_setting_count = 0;
-    if (pCreateInfo != nullptr) {
-        for (uint32_t info_index = 0, info_count = pCreateInfo->settingCount; info_index < info_count; ++info_index) {
-            const char *current_setting_name = pCreateInfo->pSettings[info_index].pSettingName;
-            if (!vlHasSetting(settingsCount, pSettings, current_setting_name)) {
-                if (pUnknownSettings != nullptr && current_unknown_setting_count < *pUnknownSettingCount) {
-                    pUnknownSettings[current_unknown_setting_count] = current_setting_name;
-                }
+// Below this number of name comparisons, comparing the names is faster than building a registry
+static const uint64_t KNOWN_SETTING_REGISTRY_THRESHOLD = 16384;
+
+// Count the settings of 'pCreateInfo' not in 'pSettings', write the first 'capacity' of them to 'pUnknownSettings'
+static VkResult FindUnknownSettings(const VkLayerSettingsCreateInfoEXT *pCreateInfo, uint32_t settingsCount, const char **pSettings,
+                                    uint32_t capacity, const char **pUnknownSettings, uint32_t &unknown_setting_count) {
+    unknown_setting_count = 0;
+    if (pCreateInfo == nullptr) {
+        return VK_SUCCESS;
+    }
 
-                ++current_unknown_setting_count;
+    if (static_cast<uint64_t>(settingsCount) * pCreateInfo->settingCount >= KNOWN_SETTING_REGISTRY_THRESHOLD) {
+        try {
+            // Unlike vlCreateKnownLayerSettings, duplicated known settings are accepted
+            vl::KnownSettingRegistry registry(nullptr);
+            registry.Reserve(settingsCount);
+            for (uint32_t setting_index = 0; setting_index < settingsCount; ++setting_index) {
+                registry.Add(pSettings[setting_index]);
             }
+            unknown_setting_count = registry.FindUnknownSettings(pCreateInfo, capacity, pUnknownSettings);
+        } catch (const std::bad_alloc &) {
+            return VK_ERROR_OUT_OF_HOST_MEMORY;
         }
+        return VK_SUCCESS;
     }
 
-    if (pUnknownSettings == nullptr) {
-        *pUnknownSettingCount = current_unknown_setting_count;
-        return VK_SUCCESS;
-    } else if (current_unknown_setting_count > *pUnknownSettingCount) {
-        return VK_INCOMPLETE;
-    } else {
-        return VK_SUCCESS;
+    for (uint32_t info_index = 0, info_count = pCreateInfo->settingCount; info_index < info_count; ++info_index) {
+        const char *current_setting_name = pCreateInfo->pSettings[info_index].pSettingName;
+        if (!vlHasSetting(settingsCount, pSettings, current_setting_name)) {
+            if (pUnknownSettings != nullptr && unknown_setting_count < capacity) {
+                pUnknownSettings[unknown_setting_count] = current_setting_name;
+            }
+
+            ++unknown_setting_count;
+        }
     }
 
     return VK_SUCCESS;
 }
 
+VkResult vlGetUnknownSettings(const VkLayerSettingsCreateInfoEXT* pCreateInfo, uint32_t settingsCount, const char** pSettings,
+    uint32_t* pUnknownSettingCount, const char** pUnknownSettings) {
+    assert(pUnknownSettingCount != nullptr);
+
+    uint32_t unknown_setting_count = 0;
+    const uint32_t capacity = pUnknownSettings != nullptr ? *pUnknownSettingCount : 0;
+    const VkResult result = FindUnknownSettings(pCreateInfo, settingsCount, pSettings, capacity, pUnknownSettings, unknown_setting_count);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    return GetUnknownSettingsResult(unknown_setting_count, pUnknownSettingCount, pUnknownSettings);
+}
+
 VkResult vlGetUnknownSettings(const VkLayerSettingsCreateInfoEXT* pCreateInfo, uint32_t settingsCount, const char** pSettings,
     std::vector<const char*>& unknownSettings) {
+    // A single pass: there can't be more unknown settings than settings
+    unknownSettings.resize(pCreateInfo != nullptr ? pCreateInfo->settingCount : 0);
+
     uint32_t unknown_setting_count = 0;
-    VkResult result = vlGetUnknownSettings(pCreateInfo, settingsCount, pSettings, &unknown_setting_count, nullptr);
+    const VkResult result = FindUnknownSettings(pCreateInfo, settingsCount, pSettings, static_cast<uint32_t>(unknownSettings.size()),
+                                                unknownSettings.data(), unknown_setting_count);
+    unknownSettings.resize(unknown_setting_count);
 
-    if (unknown_setting_count > 0) {
-        unknownSettings.resize(unknown_setting_count);
+    return result;
+}
+
+VkResult vlCreateKnownLayerSettings(uint32_t settingsCount, const char *const *pSettings, const VkAllocationCallbacks *pAllocator,
+                                    VlKnownLayerSettings *pKnownLayerSettings) {
+    assert(pKnownLayerSettings != nullptr);
 
-        result = vlGetUnknownSettings(pCreateInfo, settingsCount, pSettings, &unknown_setting_count, &unknownSettings[0]);
+    void *memory = vl::Arena::AllocateSystem(pAllocator, sizeof(vl::KnownSettingRegistry));
+    if (memory == nullptr) {
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
     }
 
-    return result;
+    vl::KnownSettingRegistry *registry = new (memory) vl::KnownSettingRegistry(pAllocator);
+
+    VkResult result = VK_SUCCESS;
+    try {
+        registry->Reserve(settingsCount);
+        for (uint32_t setting_index = 0; setting_index < settingsCount; ++setting_index) {
+            if (!registry->Add(pSettings[setting_index])) {
+                result = VK_ERROR_INITIALIZATION_FAILED;
+                break;
+            }
+        }
+    } catch (const std::bad_alloc &) {
+        result = VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+
+    if (result != VK_SUCCESS) {
+        registry->~KnownSettingRegistry();
+        vl::Arena::FreeSystem(pAllocator, memory);
+        return result;
+    }
+
+    *pKnownLayerSettings = (VlKnownLayerSettings)registry;
+    return VK_SUCCESS;
+}
+
+void vlDestroyKnownLayerSettings(VlKnownLayerSettings knownLayerSettings, const VkAllocationCallbacks *pAllocator) {
+    if (knownLayerSettings == VK_NULL_HANDLE) {
+        return;
+    }
+
+    vl::KnownSettingRegistry *registry = (vl::KnownSettingRegistry *)knownLayerSettings;
+
+    // The allocation callbacks of the creation are used, the registry keeps a copy of them
+    (void)pAllocator;
+    VkAllocationCallbacks allocator{};
+    const VkAllocationCallbacks *pCreateAllocator = registry->GetArena().GetAllocationCallbacks(allocator);
+
+    registry->~KnownSettingRegistry();
+    vl::Arena::FreeSystem(pCreateAllocator, registry);
+}
+
+VkResult vlGetUnknownLayerSettings(VlKnownLayerSettings knownLayerSettings, const VkLayerSettingsCreateInfoEXT *pCreateInfo,
+                                   uint32_t *pUnknownSettingCount, const char **pUnknownSettings) {
+    assert(knownLayerSettings != VK_NULL_HANDLE);
+    assert(pUnknownSettingCount != nullptr);
+
+    const vl::KnownSettingRegistry *registry = (const vl::KnownSettingRegistry *)knownLayerSettings;
+    const uint32_t capacity = pUnknownSettings != nullptr ? *pUnknownSettingCount : 0;
+    const uint32_t unknown_setting_count = registry->FindUnknownSettings(pCreateInfo, capacity, pUnknownSettings);
+
+    return GetUnknownSettingsResult(unknown_setting_count, pUnknownSettingCount, pUnknownSettings);
+}
+
+VkResult vlGetUnknownLayerSettings(VlKnownLayerSettings knownLayerSettings, const VkLayerSettingsCreateInfoEXT *pCreateInfo,
+                                   std::vector<const char *> &unknownSettings) {
+    assert(knownLayerSettings != VK_NULL_HANDLE);
+
+    const vl::KnownSettingRegistry *registry = (const vl::KnownSettingRegistry *)knownLayerSettings;
+
+    unknownSettings.resize(pCreateInfo != nullptr ? pCreateInfo->settingCount : 0);
+    unknownSettings.resize(
+        registry->FindUnknownSettings(pCreateInfo, static_cast<uint32_t>(unknownSettings.size()), unknownSettings.data()));
+
+    return VK_SUCCESS;
 }
@@ -7,6 +7,13 @@
 // Author(s):
 // - Christophe Riccio <christophe@lunarg.com>
 #include "vulkan/layer/vk_layer_settings.hpp"
+#include "layer_settings_util.hpp"
+
+#include <algorithm>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 static std::string Merge(const std::vector<std::string> &strings) {
     std::string result;
@@ -140,6 +147,18 @@ void vlGetLayerSettingValues(VlLayerSettingSet layerSettingSet, const char *pSet
     }
 }
 
+void vlGetLayerSettingValues(VlLayerSettingSet layerSettingSet, const char *pSettingName,
+                             std::vector<std::string_view> &settingValues) {
+    uint32_t value_count = 0;
+    vlGetLayerSettingValues(layerSettingSet, pSettingName, VL_LAYER_SETTING_TYPE_STRING, &value_count, nullptr);
+    settingValues.clear();
+    if (value_count > 0) {
+        std::vector<const char *> values(value_count);
+        vlGetLayerSettingValues(layerSettingSet, pSettingName, VL_LAYER_SETTING_TYPE_STRING, &value_count, &values[0]);
+        settingValues.assign(values.begin(), values.begin() + value_count);
+    }
+}
+
 void vlGetLayerSettingValue(VlLayerSettingSet layerSettingSet, const char* pSettingName, VlFrameset& settingValue) {
     uint32_t value_count = sizeof(VlFrameset) / sizeof(VlFrameset::count);
     vlGetLayerSettingValues(layerSettingSet, pSettingName, VL_LAYER_SETTING_TYPE_UINT32, &value_count, &settingValue);
@@ -193,3 +212,360 @@ void vlGetLayerSettingValues(VlLayerSettingSet layerSettingSet, const char *pSet
         SetCustomStypeInfo(values, settingValues);
     }
 }
+
+// Frames 'begin', 'begin + step', ... up to 'end' included, selected by one frameset or by merged framesets
+struct FrameInterval {
+    uint64_t step;
+    uint64_t residue;
+    uint64_t begin;
+    uint64_t end;  // VlFrameSchedule::NO_FRAME when unbounded
+};
+
+// Longest period of the segments which selected frames are stored in a bit mask
+static const uint64_t MAX_MASK_PERIOD = 4096;
+
+static uint64_t Gcd(uint64_t a, uint64_t b) {
+    while (b != 0) {
+        const uint64_t r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+// Index of the lowest bit set, 'bits' isn't 0
+static uint64_t FindLowestBit(uint64_t bits) {
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward64(&index, bits);
+    return index;
+#else
+    return static_cast<uint64_t>(__builtin_ctzll(bits));
+#endif
+}
+
+VlFrameSchedule::VlFrameSchedule(const std::vector<VlFrameset> &framesets)
+    : VlFrameSchedule(static_cast<uint32_t>(framesets.size()), framesets.data()) {}
+
+VlFrameSchedule::VlFrameSchedule(uint32_t framesetCount, const VlFrameset *pFramesets) {
+    std::vector<FrameInterval> intervals;
+    for (uint32_t i = 0; i < framesetCount; ++i) {
+        const VlFrameset &frameset = pFramesets[i];
+        if (frameset.step == 0) {
+            continue;
+        }
+
+        FrameInterval interval{};
+        interval.step = frameset.count == 1 ? 1 : frameset.step;
+        interval.begin = frameset.first;
+        interval.end = frameset.count == 0 ? NO_FRAME : frameset.first + static_cast<uint64_t>(frameset.count - 1) * frameset.step;
+        interval.residue = interval.begin % interval.step;
+        intervals.push_back(interval);
+    }
+
+    // Merge the overlapping and adjacent intervals of each progression
+    std::sort(intervals.begin(), intervals.end(), [](const FrameInterval &a, const FrameInterval &b) {
+        return std::tie(a.step, a.residue, a.begin) < std::tie(b.step, b.residue, b.begin);
+    });
+
+    std::vector<FrameInterval> merged_intervals;
+    for (const FrameInterval &interval : intervals) {
+        if (!merged_intervals.empty()) {
+            FrameInterval &last = merged_intervals.back();
+            if (last.step == interval.step && last.residue == interval.residue &&
+                (last.end == NO_FRAME || interval.begin <= last.end + last.step)) {
+                last.end = std::max(last.end, interval.end);
+                continue;
+            }
+        }
+        merged_intervals.push_back(interval);
+    }
+
+    // Split the frames where an interval begins or ends, each segment is then covered by a constant set of progressions
+    std::vector<uint64_t> boundaries;
+    for (const FrameInterval &interval : merged_intervals) {
+        boundaries.push_back(interval.begin);
+        if (interval.end != NO_FRAME) {
+            boundaries.push_back(interval.end + 1);
+        }
+    }
+    std::sort(boundaries.begin(), boundaries.end());
+    boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+
+    std::vector<Progression> segment_progressions;
+    for (uint64_t boundary : boundaries) {
+        segment_progressions.clear();
+        for (const FrameInterval &interval : merged_intervals) {
+            if (interval.begin <= boundary && (interval.end == NO_FRAME || boundary <= interval.end)) {
+                if (interval.step == 1) {
+                    segment_progressions.assign(1, Progression{1, 0});
+                    break;
+                }
+                segment_progressions.push_back(Progression{interval.step, interval.residue});
+            }
+        }
+
+        Segment segment{boundary, 0, 0, 0};
+        for (const Progression &progression : segment_progressions) {
+            segment.period = segment.period == 0 ? progression.step : segment.period / Gcd(segment.period, progression.step) * progression.step;
+            if (segment.period > MAX_MASK_PERIOD) {
+                break;
+            }
+        }
+
+        if (segment.period == 0 && !this->segments.empty() && this->segments.back().period == 0) {
+            continue;  // No frame selected, like the previous segment
+        }
+
+        if (segment.period == 0) {
+            // No frame selected
+        } else if (segment.period <= MAX_MASK_PERIOD) {
+            segment.offset = this->masks.size();
+            segment.count = static_cast<std::size_t>((segment.period + 63) / 64);
+            this->masks.resize(this->masks.size() + segment.count, 0);
+            for (const Progression &progression : segment_progressions) {
+                for (uint64_t residue = progression.residue; residue < segment.period; residue += progression.step) {
+                    this->masks[segment.offset + residue / 64] |= 1ull << (residue % 64);
+                }
+            }
+        } else {
+            segment.offset = this->progressions.size();
+            segment.count = segment_progressions.size();
+            this->progressions.insert(this->progressions.end(), segment_progressions.begin(), segment_progressions.end());
+        }
+
+        this->segments.push_back(segment);
+    }
+}
+
+VlFrameSchedule::VlFrameSchedule(const VlFrameSchedule &other)
+    : segments(other.segments), masks(other.masks), progressions(other.progressions) {}
+
+VlFrameSchedule &VlFrameSchedule::operator=(const VlFrameSchedule &other) {
+    this->segments = other.segments;
+    this->masks = other.masks;
+    this->progressions = other.progressions;
+    this->segment_hint.store(0, std::memory_order_relaxed);
+    return *this;
+}
+
+std::size_t VlFrameSchedule::FindSegment(uint64_t frame) const {
+    const std::size_t count = this->segments.size();
+    if (count == 0 || frame < this->segments[0].begin) {
+        return count;
+    }
+
+    const auto contains = [&](std::size_t index) {
+        return this->segments[index].begin <= frame && (index + 1 == count || frame < this->segments[index + 1].begin);
+    };
+
+    // Frames are usually queried in increasing order: the segment of the last query or the next one
+    const std::size_t hint = this->segment_hint.load(std::memory_order_relaxed);
+    if (hint < count && contains(hint)) {
+        return hint;
+    }
+    if (hint + 1 < count && contains(hint + 1)) {
+        this->segment_hint.store(hint + 1, std::memory_order_relaxed);
+        return hint + 1;
+    }
+
+    const auto it = std::upper_bound(this->segments.begin(), this->segments.end(), frame,
+                                     [](uint64_t frame, const Segment &segment) { return frame < segment.begin; });
+    const std::size_t index = static_cast<std::size_t>(it - this->segments.begin()) - 1;
+    this->segment_hint.store(index, std::memory_order_relaxed);
+    return index;
+}
+
+bool VlFrameSchedule::IsSelected(uint64_t frame) const {
+    const std::size_t index = this->FindSegment(frame);
+    if (index == this->segments.size()) {
+        return false;
+    }
+
+    const Segment &segment = this->segments[index];
+    if (segment.period == 0) {
+        return false;
+    }
+
+    if (segment.period <= MAX_MASK_PERIOD) {
+        const uint64_t residue = frame % segment.period;
+        return (this->masks[segment.offset + residue / 64] >> (residue % 64)) & 1;
+    }
+
+    for (std::size_t i = segment.offset, n = segment.offset + segment.count; i < n; ++i) {
+        if (frame % this->progressions[i].step == this->progressions[i].residue) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t VlFrameSchedule::NextSelectedInSegment(const Segment &segment, uint64_t frame) const {
+    if (segment.period == 0) {
+        return NO_FRAME;
+    }
+
+    if (segment.period <= MAX_MASK_PERIOD) {
+        // Search the mask from the residue of 'frame', then from its start for the next period
+        const uint64_t residue = frame % segment.period;
+        for (std::size_t word = static_cast<std::size_t>(residue / 64); word < segment.count; ++word) {
+            uint64_t bits = this->masks[segment.offset + word];
+            if (word == residue / 64) {
+                bits &= ~0ull << (residue % 64);
+            }
+            if (bits != 0) {
+                return frame + (word * 64 + FindLowestBit(bits)) - residue;
+            }
+        }
+        for (std::size_t word = 0; word < segment.count; ++word) {
+            const uint64_t bits = this->masks[segment.offset + word];
+            if (bits != 0) {
+                return frame + (segment.period - residue) + word * 64 + FindLowestBit(bits);
+            }
+        }
+        return NO_FRAME;
+    }
+
+    uint64_t next = NO_FRAME;
+    for (std::size_t i = segment.offset, n = segment.offset + segment.count; i < n; ++i) {
+        const Progression &progression = this->progressions[i];
+        next = std::min(next, frame + (progression.residue + progression.step - frame % progression.step) % progression.step);
+    }
+    return next;
+}
+
+uint64_t VlFrameSchedule::NextSelected(uint64_t frame) const {
+    const std::size_t count = this->segments.size();
+    if (count == 0) {
+        return NO_FRAME;
+    }
+
+    std::size_t index = this->FindSegment(frame);
+    if (index == count) {
+        index = 0;  // Before the first selected frame
+    }
+
+    for (; index < count; ++index) {
+        const Segment &segment = this->segments[index];
+        const uint64_t next = this->NextSelectedInSegment(segment, std::max(frame, segment.begin));
+        if (index + 1 == count || next < this->segments[index + 1].begin) {
+            return next;
+        }
+    }
+    return NO_FRAME;
+}
+
+// Sets of up to this number of ranges are searched with a loop the compiler vectorizes, larger ones by bisection
+static const std::size_t UINT32_SET_LINEAR_SEARCH_MAX = 32;
+
+// Dense sets are stored in a bitmap while it's no larger than the sorted ranges, or than this number of words
+static const std::size_t UINT32_SET_BITMAP_MIN_WORDS = 64;
+
+VlUint32Set::VlUint32Set(uint32_t valueCount, const uint32_t *pValues) {
+    std::vector<std::pair<uint32_t, uint32_t>> ranges;
+    ranges.reserve(valueCount);
+    for (uint32_t i = 0; i < valueCount; ++i) {
+        ranges.emplace_back(pValues[i], pValues[i]);
+    }
+    *this = VlUint32Set(std::move(ranges));
+}
+
+VlUint32Set::VlUint32Set(std::vector<std::pair<uint32_t, uint32_t>> ranges) {
+    std::sort(ranges.begin(), ranges.end());
+
+    // Merge overlapping and adjacent ranges
+    for (const std::pair<uint32_t, uint32_t> &range : ranges) {
+        if (!this->range_lasts.empty() && static_cast<uint64_t>(range.first) <= static_cast<uint64_t>(this->range_lasts.back()) + 1) {
+            this->range_lasts.back() = std::max(this->range_lasts.back(), range.second);
+        } else {
+            this->range_firsts.push_back(range.first);
+            this->range_lasts.push_back(range.second);
+        }
+    }
+
+    if (this->range_firsts.empty()) {
+        return;
+    }
+
+    const uint64_t size = static_cast<uint64_t>(this->range_lasts.back()) - this->range_firsts.front() + 1;
+    const uint64_t word_count = (size + 63) / 64;
+    if (word_count > std::max<uint64_t>(UINT32_SET_BITMAP_MIN_WORDS, this->range_firsts.size())) {
+        return;
+    }
+
+    this->bitmap_begin = this->range_firsts.front();
+    this->bitmap_size = size;
+    this->bitmap.assign(static_cast<std::size_t>(word_count), 0);
+    for (std::size_t i = 0, n = this->range_firsts.size(); i < n; ++i) {
+        for (uint64_t bit = this->range_firsts[i] - this->bitmap_begin, last = this->range_lasts[i] - this->bitmap_begin; bit <= last;
+             ++bit) {
+            this->bitmap[static_cast<std::size_t>(bit / 64)] |= 1ull << (bit % 64);
+        }
+    }
+    this->range_firsts.clear();
+    this->range_lasts.clear();
+}
+
+bool VlUint32Set::Contains(uint32_t value) const {
+    if (!this->bitmap.empty()) {
+        const uint64_t bit = static_cast<uint64_t>(value) - this->bitmap_begin;  // Wraps for values before the bitmap
+        return bit < this->bitmap_size && ((this->bitmap[static_cast<std::size_t>(bit / 64)] >> (bit % 64)) & 1) != 0;
+    }
+
+    // Number of ranges starting at or before 'value', the last of them is the only one which may contain it
+    const std::size_t count = this->range_firsts.size();
+    const uint32_t *firsts = this->range_firsts.data();
+    std::size_t below = 0;
+    if (count <= UINT32_SET_LINEAR_SEARCH_MAX) {
+        for (std::size_t i = 0; i < count; ++i) {
+            below += firsts[i] <= value ? 1 : 0;
+        }
+    } else {
+        const uint32_t *base = firsts;
+        for (std::size_t n = count; n > 1;) {
+            const std::size_t half = n / 2;
+            base = base[half] <= value ? base + half : base;
+            n -= half;
+        }
+        below = static_cast<std::size_t>(base - firsts) + (*base <= value ? 1 : 0);
+    }
+
+    return below > 0 && value <= this->range_lasts[below - 1];
+}
+
+VkResult vlGetLayerSettingValues(VlLayerSettingSet layerSettingSet, const char *pSettingName, VlUint32Set &settingValues) {
+    // String values are interned by the layer setting set, reading them doesn't copy them
+    std::vector<std::string_view> values;
+    vlGetLayerSettingValues(layerSettingSet, pSettingName, values);
+
+    VkResult result = VK_SUCCESS;
+    std::vector<std::pair<uint32_t, uint32_t>> ranges;
+    ranges.reserve(values.size());
+    for (std::string_view value : values) {
+        // "100-200" is tokenized as the numbers of a frameset
+        std::pair<uint32_t, uint32_t> range;
+        uint32_t *numbers[] = {&range.first, &range.second};
+        std::size_t number_count = 0;
+        bool valid = !value.empty() && value.back() != '-';
+
+        std::size_t position = 0;
+        std::string_view number;
+        while (valid && vl::NextListValue(value, '-', position, number)) {
+            valid = number_count < std::size(numbers) && !number.empty() &&
+                    vl::ParseInteger(number, *numbers[number_count]) == vl::PARSE_SUCCESS;
+            ++number_count;
+        }
+
+        if (number_count == 1) {
+            range.second = range.first;
+        }
+        if (!valid || number_count == 0 || range.first > range.second) {
+            result = VK_ERROR_FORMAT_NOT_SUPPORTED;
+            continue;
+        }
+        ranges.push_back(range);
+    }
+
+    settingValues = VlUint32Set(std::move(ranges));
+    return result;
+}
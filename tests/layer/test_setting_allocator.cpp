@@ -0,0 +1,149 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include "vulkan/layer/vk_layer_settings.h"
+#include "layer_settings_arena.hpp"
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+
+static void SetEnv(const char *value) {
+#ifdef _WIN32
+    _putenv(value);
+#else
+    putenv(const_cast<char *>(value));
+#endif
+}
+
+struct AllocationCounter {
+    std::size_t allocation_count{0};
+    std::size_t free_count{0};
+};
+
+static void *VKAPI_PTR CountingAllocation(void *pUserData, size_t size, size_t alignment, VkSystemAllocationScope) {
+    static_cast<AllocationCounter *>(pUserData)->allocation_count++;
+    const size_t aligned_size = (size + alignment - 1) / alignment * alignment;
+#ifdef _WIN32
+    return _aligned_malloc(aligned_size, alignment);
+#else
+    return std::aligned_alloc(alignment, aligned_size);
+#endif
+}
+
+static void *VKAPI_PTR CountingReallocation(void *, void *, size_t, size_t, VkSystemAllocationScope) { return nullptr; }
+
+static void VKAPI_PTR CountingFree(void *pUserData, void *pMemory) {
+    if (pMemory == nullptr) {
+        return;
+    }
+    static_cast<AllocationCounter *>(pUserData)->free_count++;
+#ifdef _WIN32
+    _aligned_free(pMemory);
+#else
+    std::free(pMemory);
+#endif
+}
+
+static VkAllocationCallbacks MakeCountingAllocator(AllocationCounter *counter) {
+    VkAllocationCallbacks allocator{};
+    allocator.pUserData = counter;
+    allocator.pfnAllocation = CountingAllocation;
+    allocator.pfnReallocation = CountingReallocation;
+    allocator.pfnFree = CountingFree;
+    return allocator;
+}
+
+TEST(test_layer_setting_allocator, vlCreateLayerSettingSet) {
+    SetEnv("VK_LUNARG_TEST_MY_ALLOCATOR_ENV_SETTING=value1,value2");
+
+    AllocationCounter counter;
+    const VkAllocationCallbacks allocator = MakeCountingAllocator(&counter);
+
+    const std::int32_t int_values[] = {76, -82};
+    const char *string_values[] = {"VALUE_A", "VALUE_B"};
+    const VkLayerSettingEXT settings[] = {
+        {"VK_LAYER_LUNARG_test", "my_int_setting", VK_LAYER_SETTING_TYPE_INT32_EXT, 2, int_values},
+        {"VK_LAYER_LUNARG_test", "my_string_setting", VK_LAYER_SETTING_TYPE_STRING_EXT, 2, string_values}};
+
+    const VkLayerSettingsCreateInfoEXT layer_settings_create_info{
+        VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr, static_cast<std::uint32_t>(std::size(settings)), settings};
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    EXPECT_EQ(VK_SUCCESS,
+              vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", &layer_settings_create_info, &allocator, nullptr, &layerSettingSet));
+    EXPECT_LT(0u, counter.allocation_count);
+
+    std::int32_t read_ints[2] = {};
+    uint32_t count = 2;
+    EXPECT_EQ(VK_SUCCESS, vlGetLayerSettingValues(layerSettingSet, "my_int_setting", VL_LAYER_SETTING_TYPE_INT32, &count, read_ints));
+    EXPECT_EQ(76, read_ints[0]);
+    EXPECT_EQ(-82, read_ints[1]);
+
+    const char *read_strings[2] = {};
+    count = 2;
+    EXPECT_EQ(VK_SUCCESS,
+              vlGetLayerSettingValues(layerSettingSet, "my_string_setting", VL_LAYER_SETTING_TYPE_STRING, &count, read_strings));
+    EXPECT_STREQ("VALUE_A", read_strings[0]);
+    EXPECT_STREQ("VALUE_B", read_strings[1]);
+
+    count = 2;
+    EXPECT_EQ(VK_SUCCESS, vlGetLayerSettingValues(layerSettingSet, "my_allocator_env_setting", VL_LAYER_SETTING_TYPE_STRING,
+                                                  &count, read_strings));
+    EXPECT_STREQ("value1", read_strings[0]);
+    EXPECT_STREQ("value2", read_strings[1]);
+
+    EXPECT_EQ(VK_SUCCESS, vlFreezeLayerSettingSet(layerSettingSet));
+    EXPECT_TRUE(vlHasLayerSetting(layerSettingSet, "my_int_setting"));
+
+    VlLayerSettingSetMemoryUsage memory_usage{};
+    vlGetLayerSettingSetMemoryUsage(layerSettingSet, &memory_usage);
+    EXPECT_LT(0u, memory_usage.allocatedBytes);
+    EXPECT_LE(memory_usage.allocatedBytes, memory_usage.peakAllocatedBytes);
+
+    // The allocation callbacks given at creation are used even if destroy is called without them
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+    EXPECT_EQ(counter.allocation_count, counter.free_count);
+}
+
+TEST(test_layer_setting_allocator, vlGetLayerSettingSetMemoryUsage) {
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr, &layerSettingSet);
+
+    VlLayerSettingSetMemoryUsage memory_usage{};
+    vlGetLayerSettingSetMemoryUsage(layerSettingSet, &memory_usage);
+    EXPECT_LT(0u, memory_usage.allocatedBytes);
+    EXPECT_LE(memory_usage.allocatedBytes, memory_usage.peakAllocatedBytes);
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+TEST(test_layer_setting_allocator, Arena) {
+    AllocationCounter counter;
+    const VkAllocationCallbacks allocator = MakeCountingAllocator(&counter);
+
+    {
+        vl::Arena arena(&allocator);
+
+        void *small = arena.Allocate(24);
+        arena.Deallocate(small, 24);
+        EXPECT_EQ(small, arena.Allocate(32));  // Same size class, the freed memory is recycled
+        const std::size_t small_bytes = arena.GetAllocatedBytes();
+
+        void *large = arena.Allocate(100000);
+        EXPECT_LT(small_bytes, arena.GetAllocatedBytes());
+        arena.Deallocate(large, 100000);
+        EXPECT_EQ(small_bytes, arena.GetAllocatedBytes());
+        EXPECT_LT(small_bytes, arena.GetPeakAllocatedBytes());
+
+        vl::ArenaVector<vl::ArenaString> strings{vl::ArenaAllocator<vl::ArenaString>(&arena)};
+        strings.emplace_back("a string long enough to not fit in the small string buffer");
+        EXPECT_EQ(&arena, strings[0].get_allocator().GetArena());
+    }
+
+    EXPECT_EQ(counter.allocation_count, counter.free_count);
+}
@@ -9,6 +9,8 @@
 #include <gtest/gtest.h>
 
 #include "vulkan/layer/vk_layer_settings.h"
+#include <string>
+#include <vector>
 
 TEST(test_layer_setting_api, vlHasLayerSetting_NotFound) {
     VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
@@ -523,3 +525,218 @@ TEST(test_layer_setting_api, vlGetLayerSettingValues_String) {
 
     vlDestroyLayerSettingSet(layerSettingSet, nullptr);
 }
+
+TEST(test_layer_setting_api, vlGetLayerSettingValues_StringStable) {
+    const int32_t int_values[] = {76, -82};
+    const char *string_values[] = {"76", "VALUE_B"};
+    const VkLayerSettingEXT settings[] = {
+        {"VK_LAYER_LUNARG_test", "int_setting", VK_LAYER_SETTING_TYPE_INT32_EXT, 2, int_values},
+        {"VK_LAYER_LUNARG_test", "string_setting", VK_LAYER_SETTING_TYPE_STRING_EXT, 2, string_values}};
+
+    const VkLayerSettingsCreateInfoEXT layer_settings_create_info{VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr,
+                                                                  static_cast<uint32_t>(std::size(settings)), settings};
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", &layer_settings_create_info, nullptr, nullptr, &layerSettingSet);
+
+    const char *int_strings[2] = {};
+    uint32_t value_count = 2;
+    EXPECT_EQ(VK_SUCCESS,
+              vlGetLayerSettingValues(layerSettingSet, "int_setting", VL_LAYER_SETTING_TYPE_STRING, &value_count, int_strings));
+    EXPECT_STREQ("76", int_strings[0]);
+    EXPECT_STREQ("-82", int_strings[1]);
+
+    // Querying another setting doesn't overwrite the previous values, equal strings are shared
+    const char *string_strings[2] = {};
+    EXPECT_EQ(VK_SUCCESS, vlGetLayerSettingValues(layerSettingSet, "string_setting", VL_LAYER_SETTING_TYPE_STRING, &value_count,
+                                                  string_strings));
+    EXPECT_STREQ("76", int_strings[0]);
+    EXPECT_STREQ("-82", int_strings[1]);
+    EXPECT_EQ(int_strings[0], string_strings[0]);
+    EXPECT_STREQ("VALUE_B", string_strings[1]);
+
+    // Repeated queries return the same strings
+    const char *int_strings_again[2] = {};
+    EXPECT_EQ(VK_SUCCESS, vlGetLayerSettingValues(layerSettingSet, "int_setting", VL_LAYER_SETTING_TYPE_STRING, &value_count,
+                                                  int_strings_again));
+    EXPECT_EQ(int_strings[0], int_strings_again[0]);
+    EXPECT_EQ(int_strings[1], int_strings_again[1]);
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+TEST(test_layer_setting_api, vlGetLayerSettingValues_Chained) {
+    const std::int32_t value_a = 76;
+    const std::int32_t value_b = 82;
+    const std::int32_t value_c = 93;
+
+    const VkLayerSettingEXT settings_second[] = {
+        {"VK_LAYER_LUNARG_test", "setting_a", VK_LAYER_SETTING_TYPE_INT32_EXT, 1, &value_c},
+        {"VK_LAYER_LUNARG_test", "setting_b", VK_LAYER_SETTING_TYPE_INT32_EXT, 1, &value_b}
+    };
+
+    const VkLayerSettingsCreateInfoEXT layer_settings_create_info_second{
+        VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr, static_cast<std::uint32_t>(std::size(settings_second)),
+        settings_second};
+
+    VkDebugReportCallbackCreateInfoEXT debug_report_callback_create_info{};
+    debug_report_callback_create_info.sType = VK_STRUCTURE_TYPE_DEBUG_REPORT_CALLBACK_CREATE_INFO_EXT;
+    debug_report_callback_create_info.pNext = &layer_settings_create_info_second;
+
+    const VkLayerSettingEXT settings_first[] = {
+        {"VK_LAYER_LUNARG_other", "setting_b", VK_LAYER_SETTING_TYPE_INT32_EXT, 1, &value_c},
+        {"VK_LAYER_LUNARG_test", "setting_a", VK_LAYER_SETTING_TYPE_INT32_EXT, 1, &value_a}
+    };
+
+    const VkLayerSettingsCreateInfoEXT layer_settings_create_info_first{
+        VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, &debug_report_callback_create_info,
+        static_cast<std::uint32_t>(std::size(settings_first)), settings_first};
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", &layer_settings_create_info_first, nullptr, nullptr, &layerSettingSet);
+
+    EXPECT_TRUE(vlHasLayerSetting(layerSettingSet, "setting_a"));
+    EXPECT_TRUE(vlHasLayerSetting(layerSettingSet, "setting_b"));
+    EXPECT_FALSE(vlHasLayerSetting(layerSettingSet, "setting_c"));
+
+    // The first occurrence of a setting in the pNext chain is used
+    std::int32_t value = 0;
+    uint32_t value_count = 1;
+    EXPECT_EQ(VK_SUCCESS, vlGetLayerSettingValues(layerSettingSet, "setting_a", VL_LAYER_SETTING_TYPE_INT32, &value_count, &value));
+    EXPECT_EQ(76, value);
+
+    // Settings of other layers are ignored
+    EXPECT_EQ(VK_SUCCESS, vlGetLayerSettingValues(layerSettingSet, "setting_b", VL_LAYER_SETTING_TYPE_INT32, &value_count, &value));
+    EXPECT_EQ(82, value);
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+TEST(test_layer_setting_api, vlGetLayerSettingValues_ManySettings) {
+    std::vector<std::string> names;
+    for (std::int32_t i = 0; i < 500; ++i) {
+        names.push_back("setting_" + std::to_string(i));
+    }
+
+    std::vector<std::int32_t> values(names.size());
+    std::vector<VkLayerSettingEXT> settings;
+    for (std::size_t i = 0, n = names.size(); i < n; ++i) {
+        values[i] = static_cast<std::int32_t>(i);
+        settings.push_back({"VK_LAYER_LUNARG_test", names[i].c_str(), VK_LAYER_SETTING_TYPE_INT32_EXT, 1, &values[i]});
+        settings.push_back({"VK_LAYER_LUNARG_other", names[i].c_str(), VK_LAYER_SETTING_TYPE_INT32_EXT, 1, &values[0]});
+    }
+
+    const VkLayerSettingsCreateInfoEXT layer_settings_create_info{
+        VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr, static_cast<std::uint32_t>(settings.size()), &settings[0]};
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", &layer_settings_create_info, nullptr, nullptr, &layerSettingSet);
+
+    for (std::size_t i = 0, n = names.size(); i < n; ++i) {
+        std::int32_t value = -1;
+        uint32_t value_count = 1;
+        EXPECT_EQ(VK_SUCCESS,
+                  vlGetLayerSettingValues(layerSettingSet, names[i].c_str(), VL_LAYER_SETTING_TYPE_INT32, &value_count, &value));
+        EXPECT_EQ(static_cast<std::int32_t>(i), value);
+    }
+
+    EXPECT_FALSE(vlHasLayerSetting(layerSettingSet, "SETTING_0"));
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+TEST(test_layer_setting_api, vlHasLayerSetting_ManySettings) {
+    std::vector<std::string> names;
+    for (std::int32_t i = 0; i < 1000; ++i) {
+        names.push_back("setting_" + std::to_string(i));
+    }
+
+    // Only the even settings are set for the layer, the odd ones for another layer
+    const std::int32_t value = 76;
+    std::vector<VkLayerSettingEXT> settings;
+    for (std::size_t i = 0, n = names.size(); i < n; ++i) {
+        const char *layer_name = (i % 2) == 0 ? "VK_LAYER_LUNARG_test" : "VK_LAYER_LUNARG_other";
+        settings.push_back({layer_name, names[i].c_str(), VK_LAYER_SETTING_TYPE_INT32_EXT, 1, &value});
+    }
+
+    const VkLayerSettingsCreateInfoEXT layer_settings_create_info{
+        VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr, static_cast<std::uint32_t>(settings.size()), &settings[0]};
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", &layer_settings_create_info, nullptr, nullptr, &layerSettingSet);
+
+    for (std::size_t i = 0, n = names.size(); i < n; ++i) {
+        EXPECT_EQ((i % 2) == 0 ? VK_TRUE : VK_FALSE, vlHasLayerSetting(layerSettingSet, names[i].c_str()));
+
+        std::int32_t read_value = 0;
+        uint32_t value_count = 1;
+        EXPECT_EQ(VK_SUCCESS,
+                  vlGetLayerSettingValues(layerSettingSet, names[i].c_str(), VL_LAYER_SETTING_TYPE_INT32, &value_count, &read_value));
+        EXPECT_EQ((i % 2) == 0 ? 1u : 0u, value_count);
+    }
+
+    EXPECT_FALSE(vlHasLayerSetting(layerSettingSet, "setting_1000"));
+    EXPECT_FALSE(vlHasLayerSetting(layerSettingSet, "Setting_0"));
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+TEST(test_layer_setting_api, vlGetLayerSettingValuesBatch) {
+    const std::int32_t input_int32[] = {76, -82};
+    const VkBool32 input_bool = VK_TRUE;
+    const char *input_string = "value";
+    const VkLayerSettingEXT settings[] = {
+        {"VK_LAYER_LUNARG_test", "int32_setting", VK_LAYER_SETTING_TYPE_INT32_EXT, 2, input_int32},
+        {"VK_LAYER_LUNARG_test", "bool_setting", VK_LAYER_SETTING_TYPE_BOOL32_EXT, 1, &input_bool},
+        {"VK_LAYER_LUNARG_test", "string_setting", VK_LAYER_SETTING_TYPE_STRING_EXT, 1, &input_string}
+    };
+
+    const VkLayerSettingsCreateInfoEXT layer_settings_create_info{
+        VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr, static_cast<uint32_t>(std::size(settings)), settings};
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", &layer_settings_create_info, nullptr, nullptr, &layerSettingSet);
+
+    std::int32_t values_int32[2] = {};
+    std::int32_t value_incomplete = 0;
+    VkBool32 value_bool = VK_FALSE;
+    const char *value_string = nullptr;
+    std::int64_t value_int64 = 0;
+
+    VlLayerSettingQuery queries[] = {
+        {"int32_setting", VL_LAYER_SETTING_TYPE_INT32, 0, nullptr, VK_ERROR_UNKNOWN},
+        {"int32_setting", VL_LAYER_SETTING_TYPE_INT32, 2, values_int32, VK_ERROR_UNKNOWN},
+        {"int32_setting", VL_LAYER_SETTING_TYPE_INT32, 1, &value_incomplete, VK_ERROR_UNKNOWN},
+        {"bool_setting", VL_LAYER_SETTING_TYPE_BOOL32, 1, &value_bool, VK_ERROR_UNKNOWN},
+        {"string_setting", VL_LAYER_SETTING_TYPE_STRING, 1, &value_string, VK_ERROR_UNKNOWN},
+        {"int32_setting", VL_LAYER_SETTING_TYPE_INT64, 1, &value_int64, VK_ERROR_UNKNOWN},
+        {"unset_setting", VL_LAYER_SETTING_TYPE_INT32, 1, values_int32, VK_ERROR_UNKNOWN}
+    };
+
+    VkResult result = vlGetLayerSettingValuesBatch(layerSettingSet, static_cast<uint32_t>(std::size(queries)), queries);
+    EXPECT_EQ(VK_INCOMPLETE, result);
+
+    EXPECT_EQ(VK_SUCCESS, queries[0].result);
+    EXPECT_EQ(2, queries[0].valueCount);
+
+    EXPECT_EQ(VK_SUCCESS, queries[1].result);
+    EXPECT_EQ(2, queries[1].valueCount);
+    EXPECT_EQ(76, values_int32[0]);
+    EXPECT_EQ(-82, values_int32[1]);
+
+    EXPECT_EQ(VK_INCOMPLETE, queries[2].result);
+    EXPECT_EQ(76, value_incomplete);
+
+    EXPECT_EQ(VK_SUCCESS, queries[3].result);
+    EXPECT_EQ(VK_TRUE, value_bool);
+
+    EXPECT_EQ(VK_SUCCESS, queries[4].result);
+    EXPECT_STREQ("value", value_string);
+
+    EXPECT_EQ(VK_ERROR_FORMAT_NOT_SUPPORTED, queries[5].result);
+
+    EXPECT_EQ(VK_SUCCESS, queries[6].result);
+    EXPECT_EQ(0, queries[6].valueCount);
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
@@ -0,0 +1,114 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include "vulkan/layer/vk_layer_settings.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+static void SetSettingsPath(const std::filesystem::path &filename) {
+#ifdef _WIN32
+    _putenv_s("VK_LAYER_SETTINGS_PATH", filename.string().c_str());
+#else
+    setenv("VK_LAYER_SETTINGS_PATH", filename.c_str(), 1);
+#endif
+}
+
+static void WriteFile(const std::filesystem::path &filename, const char *content) {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    file << content;
+}
+
+static std::string GetStringSetting(const char *pSettingName) {
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr, &layerSettingSet);
+
+    uint32_t value_count = 1;
+    const char *value = nullptr;
+    vlGetLayerSettingValues(layerSettingSet, pSettingName, VL_LAYER_SETTING_TYPE_STRING, &value_count, &value);
+    const std::string result = value == nullptr ? "" : value;
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+    return result;
+}
+
+static std::filesystem::path GetDirectory(const char *name) {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    return directory;
+}
+
+TEST(test_layer_setting_cache, LoadCache) {
+    const std::filesystem::path directory = GetDirectory("test_layer_setting_cache_load");
+    const std::filesystem::path filename = directory / "vk_layer_settings.txt";
+    SetSettingsPath(filename);
+
+    WriteFile(filename,
+              "lunarg_test.my_setting = 76\n"
+              "lunarg_test.my_list = A,B\n"
+              "lunarg_other.other_setting = 1\n");
+    EXPECT_EQ(VK_SUCCESS, vlCompileLayerSettingsCache("VK_LAYER_LUNARG_test"));
+    EXPECT_TRUE(std::filesystem::exists(directory / "vk_layer_settings.lunarg_test.cache"));
+
+    // Same size and modification time: the settings are loaded from the cache, not from the settings file
+    const std::filesystem::file_time_type last_write_time = std::filesystem::last_write_time(filename);
+    WriteFile(filename,
+              "lunarg_test.my_setting = 82\n"
+              "lunarg_test.my_list = C,D\n"
+              "lunarg_other.other_setting = 1\n");
+    std::filesystem::last_write_time(filename, last_write_time);
+
+    EXPECT_EQ("76", GetStringSetting("my_setting"));
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr, &layerSettingSet);
+    EXPECT_TRUE(vlHasLayerSetting(layerSettingSet, "my_list"));
+    EXPECT_FALSE(vlHasLayerSetting(layerSettingSet, "other_setting"));
+
+    uint32_t value_count = 0;
+    EXPECT_EQ(VK_SUCCESS, vlGetLayerSettingValues(layerSettingSet, "my_list", VL_LAYER_SETTING_TYPE_STRING, &value_count, nullptr));
+    EXPECT_EQ(2u, value_count);
+    const char *values[2] = {};
+    EXPECT_EQ(VK_SUCCESS, vlGetLayerSettingValues(layerSettingSet, "my_list", VL_LAYER_SETTING_TYPE_STRING, &value_count, values));
+    EXPECT_STREQ("A", values[0]);
+    EXPECT_STREQ("B", values[1]);
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+
+    // A different size invalidates the cache
+    WriteFile(filename, "lunarg_test.my_setting = 1024\n");
+    EXPECT_EQ("1024", GetStringSetting("my_setting"));
+}
+
+TEST(test_layer_setting_cache, InvalidCache) {
+    const std::filesystem::path directory = GetDirectory("test_layer_setting_cache_invalid");
+    const std::filesystem::path filename = directory / "vk_layer_settings.txt";
+    SetSettingsPath(filename);
+
+    WriteFile(filename, "lunarg_test.my_setting = 76\n");
+    EXPECT_EQ(VK_SUCCESS, vlCompileLayerSettingsCache("VK_LAYER_LUNARG_test"));
+
+    // A truncated cache is ignored
+    std::filesystem::resize_file(directory / "vk_layer_settings.lunarg_test.cache", 20);
+    EXPECT_EQ("76", GetStringSetting("my_setting"));
+
+    // The cache of another layer isn't loaded
+    std::filesystem::remove(directory / "vk_layer_settings.lunarg_test.cache");
+    WriteFile(filename, "lunarg_other.my_setting = 82\n");
+    EXPECT_EQ(VK_SUCCESS, vlCompileLayerSettingsCache("VK_LAYER_LUNARG_other"));
+    std::filesystem::copy_file(directory / "vk_layer_settings.lunarg_other.cache", directory / "vk_layer_settings.lunarg_test.cache");
+    EXPECT_EQ("", GetStringSetting("my_setting"));
+}
+
+TEST(test_layer_setting_cache, MissingSettingsFile) {
+    const std::filesystem::path directory = GetDirectory("test_layer_setting_cache_missing");
+    SetSettingsPath(directory / "vk_layer_settings.txt");
+
+    EXPECT_EQ(VK_ERROR_INITIALIZATION_FAILED, vlCompileLayerSettingsCache("VK_LAYER_LUNARG_test"));
+}
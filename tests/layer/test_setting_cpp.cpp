@@ -414,6 +414,35 @@ TEST(test_layer_setting_cpp, vlGetLayerSettingValues_String) {
     vlDestroyLayerSettingSet(layerSettingSet, nullptr);
 }
 
+TEST(test_layer_setting_cpp, vlGetLayerSettingValues_StringView) {
+    const char* values_data[] = {"VALUE_A", "VALUE_B"};
+    const uint32_t value_count = static_cast<uint32_t>(std::size(values_data));
+
+    const VkLayerSettingEXT settings[] = {
+        {"VK_LAYER_LUNARG_test", "my_setting", VK_LAYER_SETTING_TYPE_STRING_EXT, value_count, values_data}
+    };
+    const uint32_t settings_size = static_cast<uint32_t>(std::size(settings));
+
+    const VkLayerSettingsCreateInfoEXT layer_settings_create_info{
+        VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr, settings_size, settings};
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", &layer_settings_create_info, nullptr, nullptr, &layerSettingSet);
+
+    std::vector<std::string_view> values;
+    vlGetLayerSettingValues(layerSettingSet, "my_setting", values);
+    EXPECT_EQ(2, values.size());
+    EXPECT_EQ("VALUE_A", values[0]);
+    EXPECT_EQ("VALUE_B", values[1]);
+
+    std::vector<std::string_view> values_again;
+    vlGetLayerSettingValues(layerSettingSet, "my_setting", values_again);
+    EXPECT_EQ(values[0].data(), values_again[0].data());
+    EXPECT_EQ(values[1].data(), values_again[1].data());
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
 TEST(test_layer_setting_cpp, vlGetLayerSettingValue_Frameset) {
     const VlFrameset value_data{76, 100, 10};
 
@@ -588,3 +617,212 @@ TEST(test_layer_setting_cpp, vlGetUnknownSettings) {
     EXPECT_STREQ("bool_value", unknown_settings[0]);
     EXPECT_STREQ("frameset_value", unknown_settings[1]);
 }
+
+TEST(test_layer_setting_cpp, vlGetUnknownLayerSettings) {
+    const uint32_t value = 76;
+    const VkLayerSettingEXT settings[] = {
+        {"VK_LAYER_LUNARG_test", "setting_a", VK_LAYER_SETTING_TYPE_UINT32_EXT, 1, &value},
+        {"VK_LAYER_LUNARG_test", "setting_d", VK_LAYER_SETTING_TYPE_UINT32_EXT, 1, &value}};
+    const VkLayerSettingsCreateInfoEXT layer_settings_create_info{VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr,
+                                                                  static_cast<uint32_t>(std::size(settings)), settings};
+
+    const char* setting_names[] = {"setting_a", "setting_b", "setting_c"};
+    VlKnownLayerSettings known_layer_settings = VK_NULL_HANDLE;
+    vlCreateKnownLayerSettings(static_cast<uint32_t>(std::size(setting_names)), setting_names, nullptr, &known_layer_settings);
+
+    std::vector<const char*> unknown_settings;
+    EXPECT_EQ(VK_SUCCESS, vlGetUnknownLayerSettings(known_layer_settings, &layer_settings_create_info, unknown_settings));
+    ASSERT_EQ(1, unknown_settings.size());
+    EXPECT_STREQ("setting_d", unknown_settings[0]);
+
+    vlDestroyKnownLayerSettings(known_layer_settings, nullptr);
+}
+
+struct TestLayerSettings {
+    VL_LAYER_SETTING(bool, bool_value, false);
+    VL_LAYER_SETTING(int32_t, int32_value, 1);
+    VL_LAYER_SETTING(std::vector<uint32_t>, uint32_values, {1, 2, 3});
+    VL_LAYER_SETTING(double, double_value, 1.0);
+    VL_LAYER_SETTING(std::string, string_value, "default");
+    VL_LAYER_SETTING(std::vector<std::string>, string_values, {});
+    VL_LAYER_SETTING(VlFrameset, frameset_value, {0, 1, 1});
+    VL_LAYER_SETTING(uint64_t, unset_value, 76);
+
+    auto GetLayerSettings() {
+        return std::tie(bool_value, int32_value, uint32_values, double_value, string_value, string_values, frameset_value,
+                        unset_value);
+    }
+};
+
+static void TestGetLayerSettings(bool frozen) {
+    const VkBool32 value_bool = VK_TRUE;
+    const int32_t value_int32 = -76;
+    const uint32_t values_uint32[] = {82, 83};
+    const double value_double = 2.5;
+    const char *value_string = "value";
+    const char *values_string[] = {"value0", "value1"};
+    const uint32_t value_frameset[] = {10, 20, 2};
+
+    const VkLayerSettingEXT settings[] = {
+        {"VK_LAYER_LUNARG_test", "bool_value", VK_LAYER_SETTING_TYPE_BOOL32_EXT, 1, &value_bool},
+        {"VK_LAYER_LUNARG_test", "int32_value", VK_LAYER_SETTING_TYPE_INT32_EXT, 1, &value_int32},
+        {"VK_LAYER_LUNARG_test", "uint32_values", VK_LAYER_SETTING_TYPE_UINT32_EXT, 2, values_uint32},
+        {"VK_LAYER_LUNARG_test", "double_value", VK_LAYER_SETTING_TYPE_FLOAT64_EXT, 1, &value_double},
+        {"VK_LAYER_LUNARG_test", "string_value", VK_LAYER_SETTING_TYPE_STRING_EXT, 1, &value_string},
+        {"VK_LAYER_LUNARG_test", "string_values", VK_LAYER_SETTING_TYPE_STRING_EXT, 2, values_string},
+        {"VK_LAYER_LUNARG_test", "frameset_value", VK_LAYER_SETTING_TYPE_UINT32_EXT, 3, value_frameset}
+    };
+
+    const VkLayerSettingsCreateInfoEXT layer_settings_create_info{
+        VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr, static_cast<uint32_t>(std::size(settings)), settings};
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", &layer_settings_create_info, nullptr, nullptr, &layerSettingSet);
+    if (frozen) {
+        vlFreezeLayerSettingSet(layerSettingSet);
+    }
+
+    TestLayerSettings layer_settings;
+    vlGetLayerSettings(layerSettingSet, layer_settings);
+
+    EXPECT_EQ(true, layer_settings.bool_value.value);
+    EXPECT_EQ(-76, layer_settings.int32_value.value);
+    EXPECT_EQ(std::vector<uint32_t>({82, 83}), layer_settings.uint32_values.value);
+    EXPECT_DOUBLE_EQ(2.5, layer_settings.double_value.value);
+    EXPECT_EQ("value", layer_settings.string_value.value);
+    EXPECT_EQ(std::vector<std::string>({"value0", "value1"}), layer_settings.string_values.value);
+    EXPECT_EQ(10, layer_settings.frameset_value.value.first);
+    EXPECT_EQ(20, layer_settings.frameset_value.value.count);
+    EXPECT_EQ(2, layer_settings.frameset_value.value.step);
+    EXPECT_EQ(76, layer_settings.unset_value.value);
+    EXPECT_STREQ("unset_value", layer_settings.unset_value.pSettingName);
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+TEST(test_layer_setting_cpp, vlGetLayerSettings) { TestGetLayerSettings(false); }
+
+TEST(test_layer_setting_cpp, vlGetLayerSettings_Frozen) { TestGetLayerSettings(true); }
+
+// Reference implementation of the frames selected by framesets: iterate every frameset
+static bool IsFrameSelected(const std::vector<VlFrameset> &framesets, uint64_t frame) {
+    for (const VlFrameset &frameset : framesets) {
+        if (frameset.step == 0 || frame < frameset.first || (frame - frameset.first) % frameset.step != 0) {
+            continue;
+        }
+        if (frameset.count == 0 || (frame - frameset.first) / frameset.step < frameset.count) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void TestFrameSchedule(const std::vector<VlFrameset> &framesets, uint64_t frame_count) {
+    const VlFrameSchedule schedule(framesets);
+
+    uint64_t next_selected = VlFrameSchedule::NO_FRAME;
+    for (uint64_t frame = frame_count; frame-- > 0;) {
+        const bool selected = IsFrameSelected(framesets, frame);
+        EXPECT_EQ(selected, schedule.IsSelected(frame)) << "frame " << frame;
+        if (selected) {
+            next_selected = frame;
+        }
+        if (next_selected != VlFrameSchedule::NO_FRAME) {
+            EXPECT_EQ(next_selected, schedule.NextSelected(frame)) << "frame " << frame;
+        }
+    }
+
+    // Frames queried in increasing order, as by a layer counting the presented frames
+    for (uint64_t frame = 0; frame < frame_count; ++frame) {
+        EXPECT_EQ(IsFrameSelected(framesets, frame), schedule.IsSelected(frame)) << "frame " << frame;
+    }
+}
+
+TEST(test_layer_setting_cpp, VlFrameSchedule) {
+    TestFrameSchedule({}, 16);
+    TestFrameSchedule({{76, 100, 10}, {1, 100, 1}}, 1200);
+    TestFrameSchedule({{10, 5, 3}, {11, 5, 3}, {12, 1, 7}, {0, 3, 0}}, 64);
+    TestFrameSchedule({{5, 0, 4}, {7, 0, 6}, {100, 10, 1}}, 400);
+    TestFrameSchedule({{3, 0, 97}, {5, 0, 89}, {8, 20, 83}}, 20000);  // Period too long for a mask
+
+    const VlFrameSchedule empty;
+    EXPECT_FALSE(empty.IsSelected(0));
+    EXPECT_EQ(VlFrameSchedule::NO_FRAME, empty.NextSelected(0));
+
+    const VlFrameSchedule bounded(std::vector<VlFrameset>{{10, 2, 5}});
+    EXPECT_EQ(10u, bounded.NextSelected(0));
+    EXPECT_EQ(15u, bounded.NextSelected(11));
+    EXPECT_EQ(VlFrameSchedule::NO_FRAME, bounded.NextSelected(16));
+
+    const VlFrameSchedule unbounded(std::vector<VlFrameset>{{0, 0, 1}});
+    EXPECT_TRUE(unbounded.IsSelected(0xFFFFFFFFFFull));
+    EXPECT_EQ(0xFFFFFFFFFFull, unbounded.NextSelected(0xFFFFFFFFFFull));
+}
+
+TEST(test_layer_setting_cpp, VlUint32Set) {
+    VlUint32Set empty;
+    EXPECT_TRUE(empty.Empty());
+    EXPECT_FALSE(empty.Contains(0));
+
+    // Sparse values, such as message IDs, are searched in sorted ranges
+    const uint32_t message_ids[] = {0x4dae5635, 0x76589099, 0xc05b3a9d, 0x00000000, 0xffffffff};
+    const VlUint32Set message_id_set(static_cast<uint32_t>(std::size(message_ids)), message_ids);
+    EXPECT_FALSE(message_id_set.Empty());
+    for (uint32_t message_id : message_ids) {
+        EXPECT_TRUE(message_id_set.Contains(message_id));
+        EXPECT_FALSE(message_id_set.Contains(message_id ^ 0x10));
+    }
+
+    // Dense values are set in a bitmap
+    const VlUint32Set range_set({{100, 200}, {150, 300}, {302, 302}});
+    EXPECT_FALSE(range_set.Contains(99));
+    EXPECT_TRUE(range_set.Contains(100));
+    EXPECT_TRUE(range_set.Contains(250));
+    EXPECT_TRUE(range_set.Contains(300));
+    EXPECT_FALSE(range_set.Contains(301));
+    EXPECT_TRUE(range_set.Contains(302));
+    EXPECT_FALSE(range_set.Contains(303));
+    EXPECT_FALSE(range_set.Contains(0xffffffff));
+
+    // Many sparse values are searched by bisection
+    std::vector<uint32_t> values;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        values.push_back(i * 2654435761u | 1u);
+    }
+    const VlUint32Set large_set(static_cast<uint32_t>(values.size()), values.data());
+    for (uint32_t value : values) {
+        EXPECT_TRUE(large_set.Contains(value));
+        EXPECT_FALSE(large_set.Contains(value - 1));
+    }
+}
+
+TEST(test_layer_setting_cpp, vlGetLayerSettingValues_Uint32Set) {
+    const char *values_data[] = {"0x4dae5635", "100-200", "0x10-0x1f", "5", "invalid", "-3", "8-", "20-10"};
+    const VkLayerSettingEXT settings[] = {
+        {"VK_LAYER_LUNARG_test", "message_id_filter", VK_LAYER_SETTING_TYPE_STRING_EXT, static_cast<uint32_t>(std::size(values_data)),
+         values_data}};
+    const VkLayerSettingsCreateInfoEXT layer_settings_create_info{VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr,
+                                                                  static_cast<uint32_t>(std::size(settings)), settings};
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", &layer_settings_create_info, nullptr, nullptr, &layerSettingSet);
+
+    VlUint32Set message_ids;
+    EXPECT_EQ(VK_ERROR_FORMAT_NOT_SUPPORTED, vlGetLayerSettingValues(layerSettingSet, "message_id_filter", message_ids));
+    EXPECT_TRUE(message_ids.Contains(0x4dae5635));
+    EXPECT_TRUE(message_ids.Contains(100));
+    EXPECT_TRUE(message_ids.Contains(200));
+    EXPECT_FALSE(message_ids.Contains(201));
+    EXPECT_TRUE(message_ids.Contains(0x10));
+    EXPECT_TRUE(message_ids.Contains(0x1f));
+    EXPECT_TRUE(message_ids.Contains(5));
+    EXPECT_FALSE(message_ids.Contains(3));
+    EXPECT_FALSE(message_ids.Contains(8));
+    EXPECT_FALSE(message_ids.Contains(15));
+
+    VlUint32Set missing;
+    EXPECT_EQ(VK_SUCCESS, vlGetLayerSettingValues(layerSettingSet, "missing_setting", missing));
+    EXPECT_TRUE(missing.Empty());
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
@@ -0,0 +1,341 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include "vulkan/layer/vk_layer_settings.h"
+#include "vulkan/layer/vk_layer_settings.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <string>
+#include <vector>
+
+void test_helper_SetLayerSetting(VlLayerSettingSet layerSettingSet, const char *pSettingName, const char *pValue);
+
+static void SetEnv(const char *value) {
+#ifdef _WIN32
+    _putenv(value);
+#else
+    putenv(const_cast<char *>(value));
+#endif
+}
+
+// A setting of each source, and settings set by several sources
+static VlLayerSettingSet CreateEnumerateLayerSettingSet() {
+    SetEnv("VK_LUNARG_TEST_ENUM_ENV_NONE=1");
+    SetEnv("VK_TEST_ENUM_ENV_VENDOR=2");
+    SetEnv("VK_ENUM_ENV_NAMESPACE=3");
+    SetEnv("VK_LUNARG_TEST_ENUM_ENV_API=4");
+
+    static const int32_t value = 76;
+    static const VkLayerSettingEXT settings[] = {
+        {"VK_LAYER_LUNARG_test", "enum_api", VK_LAYER_SETTING_TYPE_INT32_EXT, 1, &value},
+        {"VK_LAYER_LUNARG_test", "enum_both", VK_LAYER_SETTING_TYPE_INT32_EXT, 1, &value},
+        {"VK_LAYER_LUNARG_test", "enum_env_api", VK_LAYER_SETTING_TYPE_INT32_EXT, 1, &value},
+        {"VK_LAYER_LUNARG_other", "enum_other", VK_LAYER_SETTING_TYPE_INT32_EXT, 1, &value}};
+    const VkLayerSettingsCreateInfoEXT layer_settings_create_info{VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr,
+                                                                  static_cast<uint32_t>(std::size(settings)), settings};
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", &layer_settings_create_info, nullptr, nullptr, &layerSettingSet);
+    test_helper_SetLayerSetting(layerSettingSet, "lunarg_test.enum_file", "5");
+    test_helper_SetLayerSetting(layerSettingSet, "lunarg_test.enum_both", "6");
+
+    return layerSettingSet;
+}
+
+static std::vector<VlLayerSettingInfo> EnumerateLayerSettings(VlLayerSettingSet layerSettingSet, const char *pPrefix) {
+    uint32_t setting_count = 0;
+    EXPECT_EQ(VK_SUCCESS, vlEnumerateLayerSettings(layerSettingSet, pPrefix, &setting_count, nullptr));
+
+    std::vector<VlLayerSettingInfo> settings(setting_count);
+    EXPECT_EQ(VK_SUCCESS, vlEnumerateLayerSettings(layerSettingSet, pPrefix, &setting_count, settings.data()));
+    EXPECT_EQ(settings.size(), setting_count);
+
+    return settings;
+}
+
+static void ExpectEnumerateSources(VlLayerSettingSet layerSettingSet) {
+    // VK_ENUM_ENV_NAMESPACE sets enum_env_namespace, but only the variables with the layer name are enumerated
+    const std::vector<VlLayerSettingInfo> &settings = EnumerateLayerSettings(layerSettingSet, "enum_*");
+    ASSERT_EQ(6, settings.size());
+    EXPECT_TRUE(vlHasLayerSetting(layerSettingSet, "enum_env_namespace"));
+
+    EXPECT_STREQ("enum_api", settings[0].pSettingName);
+    EXPECT_EQ(VL_LAYER_SETTING_SOURCE_API, settings[0].source);
+    EXPECT_STREQ("enum_both", settings[1].pSettingName);
+    EXPECT_EQ(VL_LAYER_SETTING_SOURCE_FILE, settings[1].source);
+    EXPECT_STREQ("enum_env_api", settings[2].pSettingName);
+    EXPECT_EQ(VL_LAYER_SETTING_SOURCE_ENV, settings[2].source);
+    EXPECT_STREQ("enum_env_none", settings[3].pSettingName);
+    EXPECT_EQ(VL_LAYER_SETTING_SOURCE_ENV, settings[3].source);
+    EXPECT_STREQ("enum_env_vendor", settings[4].pSettingName);
+    EXPECT_EQ(VL_LAYER_SETTING_SOURCE_ENV, settings[4].source);
+    EXPECT_STREQ("enum_file", settings[5].pSettingName);
+    EXPECT_EQ(VL_LAYER_SETTING_SOURCE_FILE, settings[5].source);
+}
+
+TEST(test_layer_setting_enumerate, Sources) {
+    VlLayerSettingSet layerSettingSet = CreateEnumerateLayerSettingSet();
+
+    ExpectEnumerateSources(layerSettingSet);
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+TEST(test_layer_setting_enumerate, Frozen) {
+    VlLayerSettingSet layerSettingSet = CreateEnumerateLayerSettingSet();
+    vlFreezeLayerSettingSet(layerSettingSet);
+
+    ExpectEnumerateSources(layerSettingSet);
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+TEST(test_layer_setting_enumerate, Prefix) {
+    VlLayerSettingSet layerSettingSet = CreateEnumerateLayerSettingSet();
+
+    const std::vector<VlLayerSettingInfo> &env_settings = EnumerateLayerSettings(layerSettingSet, "enum_env_*");
+    ASSERT_EQ(3, env_settings.size());
+    EXPECT_STREQ("enum_env_api", env_settings[0].pSettingName);
+    EXPECT_STREQ("enum_env_vendor", env_settings[2].pSettingName);
+
+    // The trailing '*' is optional
+    EXPECT_EQ(3, EnumerateLayerSettings(layerSettingSet, "enum_env_").size());
+    EXPECT_EQ(1, EnumerateLayerSettings(layerSettingSet, "enum_file").size());
+    EXPECT_TRUE(EnumerateLayerSettings(layerSettingSet, "enum_other").empty());
+    EXPECT_TRUE(EnumerateLayerSettings(layerSettingSet, "enum_missing*").empty());
+
+    // Every setting, including the ones set by the environment variables of the other tests
+    EXPECT_LE(6, EnumerateLayerSettings(layerSettingSet, nullptr).size());
+    EXPECT_EQ(EnumerateLayerSettings(layerSettingSet, nullptr).size(), EnumerateLayerSettings(layerSettingSet, "*").size());
+
+    std::vector<VlLayerSettingInfo> settings;
+    EXPECT_EQ(VK_SUCCESS, vlEnumerateLayerSettings(layerSettingSet, "enum_env_*", settings));
+    EXPECT_EQ(3, settings.size());
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+TEST(test_layer_setting_enumerate, LoaderVariables) {
+    SetEnv("VK_ICD_FILENAMES=/usr/share/vulkan/icd.d/test_icd.json");
+    SetEnv("VK_LOADER_DEBUG=all");
+    SetEnv("VK_LUNARG_OTHER_LOADER_SETTING=1");
+    SetEnv("VK_LUNARG_TEST_LOADER_SETTING=2");
+
+    for (bool frozen : {false, true}) {
+        VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+        vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr, &layerSettingSet);
+        if (frozen) {
+            vlFreezeLayerSettingSet(layerSettingSet);
+        }
+        const uint64_t fingerprint = vlGetLayerSettingsFingerprint(layerSettingSet);
+
+        // Only the variables with the layer name are enumerated, each once with its most specific prefix
+        for (const VlLayerSettingInfo &setting : EnumerateLayerSettings(layerSettingSet, nullptr)) {
+            const std::string setting_name = setting.pSettingName;
+            EXPECT_NE("icd_filenames", setting_name);
+            EXPECT_NE("loader_debug", setting_name);
+            EXPECT_NE("lunarg_other_loader_setting", setting_name);
+            EXPECT_NE("lunarg_test_loader_setting", setting_name);
+        }
+        const std::vector<VlLayerSettingInfo> &settings = EnumerateLayerSettings(layerSettingSet, "loader_");
+        ASSERT_EQ(1, settings.size());
+        EXPECT_STREQ("loader_setting", settings[0].pSettingName);
+
+        // VK_ variables are still read when queried by name
+        EXPECT_TRUE(vlHasLayerSetting(layerSettingSet, "loader_debug"));
+        EXPECT_TRUE(vlHasLayerSetting(layerSettingSet, "lunarg_other_loader_setting"));
+        EXPECT_TRUE(vlHasLayerSetting(layerSettingSet, "lunarg_test_loader_setting"));
+
+        vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+
+        // The queries read the VK_ variables, so every one of them changes the fingerprint
+        SetEnv("VK_LOADER_DEBUG=error");
+        vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr, &layerSettingSet);
+        if (frozen) {
+            vlFreezeLayerSettingSet(layerSettingSet);
+        }
+        EXPECT_NE(fingerprint, vlGetLayerSettingsFingerprint(layerSettingSet));
+        vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+        SetEnv("VK_LOADER_DEBUG=all");
+    }
+}
+
+TEST(test_layer_setting_enumerate, Incomplete) {
+    VlLayerSettingSet layerSettingSet = CreateEnumerateLayerSettingSet();
+
+    VlLayerSettingInfo settings[2] = {};
+    uint32_t setting_count = 2;
+    EXPECT_EQ(VK_INCOMPLETE, vlEnumerateLayerSettings(layerSettingSet, "enum_", &setting_count, settings));
+    EXPECT_EQ(2, setting_count);
+    EXPECT_STREQ("enum_api", settings[0].pSettingName);
+    EXPECT_STREQ("enum_both", settings[1].pSettingName);
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+TEST(test_layer_setting_enumerate, Fingerprint) {
+    const int32_t api_value = 76;
+    const VkLayerSettingEXT settings[] = {{"VK_LAYER_LUNARG_test", "fingerprint_setting", VK_LAYER_SETTING_TYPE_INT32_EXT, 1, &api_value}};
+    const VkLayerSettingsCreateInfoEXT layer_settings_create_info{VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr, 1,
+                                                                  settings};
+
+    VlLayerSettingSet api_set = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", &layer_settings_create_info, nullptr, nullptr, &api_set);
+
+    VlLayerSettingSet file_set = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr, &file_set);
+    test_helper_SetLayerSetting(file_set, "lunarg_test.fingerprint_setting", "76");
+
+    VlLayerSettingSet other_set = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr, &other_set);
+    test_helper_SetLayerSetting(other_set, "lunarg_test.fingerprint_setting", "82");
+
+    // The same values from any source give the same fingerprint
+    const uint64_t fingerprint = vlGetLayerSettingsFingerprint(api_set);
+    EXPECT_EQ(fingerprint, vlGetLayerSettingsFingerprint(file_set));
+    EXPECT_NE(fingerprint, vlGetLayerSettingsFingerprint(other_set));
+
+    // Frozen sets compute it when frozen
+    vlFreezeLayerSettingSet(api_set);
+    EXPECT_EQ(fingerprint, vlGetLayerSettingsFingerprint(api_set));
+    vlFreezeLayerSettingSet(other_set);
+    EXPECT_NE(fingerprint, vlGetLayerSettingsFingerprint(other_set));
+
+    vlDestroyLayerSettingSet(other_set, nullptr);
+    vlDestroyLayerSettingSet(file_set, nullptr);
+    vlDestroyLayerSettingSet(api_set, nullptr);
+}
+
+TEST(test_layer_setting_enumerate, FingerprintSourceChange) {
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr, &layerSettingSet);
+
+    const uint64_t fingerprint = vlGetLayerSettingsFingerprint(layerSettingSet);
+    EXPECT_EQ(fingerprint, vlGetLayerSettingsFingerprint(layerSettingSet));
+
+    test_helper_SetLayerSetting(layerSettingSet, "lunarg_test.fingerprint_list", "a,b");
+    const uint64_t list_fingerprint = vlGetLayerSettingsFingerprint(layerSettingSet);
+    EXPECT_NE(fingerprint, list_fingerprint);
+
+    // Values are hashed one by one, the delimiter of the list doesn't change them
+    VlLayerSettingSet delimiter_set = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr, &delimiter_set);
+#ifdef _WIN32
+    test_helper_SetLayerSetting(delimiter_set, "lunarg_test.fingerprint_list", "a;b");
+#else
+    test_helper_SetLayerSetting(delimiter_set, "lunarg_test.fingerprint_list", "a:b");
+#endif
+    EXPECT_EQ(list_fingerprint, vlGetLayerSettingsFingerprint(delimiter_set));
+
+    vlDestroyLayerSettingSet(delimiter_set, nullptr);
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+TEST(test_layer_setting_enumerate, FingerprintTypedValues) {
+    const VkBool32 api_bool = VK_TRUE;
+    const float api_float = 1.0f;
+    const float api_precise_float = 1.0000001f;
+    const VkLayerSettingEXT settings[] = {
+        {"VK_LAYER_LUNARG_test", "fingerprint_typed_bool", VK_LAYER_SETTING_TYPE_BOOL32_EXT, 1, &api_bool},
+        {"VK_LAYER_LUNARG_test", "fingerprint_typed_float", VK_LAYER_SETTING_TYPE_FLOAT32_EXT, 1, &api_float}};
+    const VkLayerSettingsCreateInfoEXT layer_settings_create_info{VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr,
+                                                                  static_cast<uint32_t>(std::size(settings)), settings};
+    VlLayerSettingSet api_set = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", &layer_settings_create_info, nullptr, nullptr, &api_set);
+
+    // The spellings of the same values in the other sources
+    VlLayerSettingSet file_set = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr, &file_set);
+    test_helper_SetLayerSetting(file_set, "lunarg_test.fingerprint_typed_bool", "true");
+    test_helper_SetLayerSetting(file_set, "lunarg_test.fingerprint_typed_float", "1.0");
+
+    const uint64_t fingerprint = vlGetLayerSettingsFingerprint(api_set);
+    EXPECT_EQ(fingerprint, vlGetLayerSettingsFingerprint(file_set));
+    vlFreezeLayerSettingSet(file_set);
+    EXPECT_EQ(fingerprint, vlGetLayerSettingsFingerprint(file_set));
+
+    // Floats are hashed with the decimals which tell them apart
+    const VkLayerSettingEXT precise_settings[] = {
+        {"VK_LAYER_LUNARG_test", "fingerprint_typed_bool", VK_LAYER_SETTING_TYPE_BOOL32_EXT, 1, &api_bool},
+        {"VK_LAYER_LUNARG_test", "fingerprint_typed_float", VK_LAYER_SETTING_TYPE_FLOAT32_EXT, 1, &api_precise_float}};
+    const VkLayerSettingsCreateInfoEXT precise_create_info{VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr,
+                                                           static_cast<uint32_t>(std::size(precise_settings)), precise_settings};
+    VlLayerSettingSet precise_set = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", &precise_create_info, nullptr, nullptr, &precise_set);
+
+    const uint64_t precise_fingerprint = vlGetLayerSettingsFingerprint(precise_set);
+    EXPECT_NE(fingerprint, precise_fingerprint);
+
+    // Queried as strings formatted as with printf "%f"
+    uint32_t value_count = 1;
+    const char *value = nullptr;
+    vlGetLayerSettingValues(precise_set, "fingerprint_typed_float", VL_LAYER_SETTING_TYPE_STRING, &value_count, &value);
+    EXPECT_STREQ("1.000000", value);
+    vlGetLayerSettingValues(api_set, "fingerprint_typed_float", VL_LAYER_SETTING_TYPE_STRING, &value_count, &value);
+    EXPECT_STREQ("1.000000", value);
+
+    VlLayerSettingSet precise_file_set = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr, &precise_file_set);
+    test_helper_SetLayerSetting(precise_file_set, "lunarg_test.fingerprint_typed_bool", "true");
+    test_helper_SetLayerSetting(precise_file_set, "lunarg_test.fingerprint_typed_float", "1.0000001");
+    EXPECT_EQ(precise_fingerprint, vlGetLayerSettingsFingerprint(precise_file_set));
+
+    // The cached fingerprint follows the changes of the settings
+    test_helper_SetLayerSetting(precise_file_set, "lunarg_test.fingerprint_typed_string", "value");
+    EXPECT_NE(precise_fingerprint, vlGetLayerSettingsFingerprint(precise_file_set));
+
+    vlDestroyLayerSettingSet(precise_file_set, nullptr);
+    vlDestroyLayerSettingSet(precise_set, nullptr);
+    vlDestroyLayerSettingSet(file_set, nullptr);
+    vlDestroyLayerSettingSet(api_set, nullptr);
+}
+
+TEST(test_layer_setting_enumerate, FingerprintSpellings) {
+    // Spellings of the same number in the same source are different values of a string setting
+    const char *spellings[][2] = {{"7", "07"}, {"16", "0x10"}, {"1", "1.0"}, {"1", "true"}};
+    for (const auto &spelling : spellings) {
+        VlLayerSettingSet first_set = VK_NULL_HANDLE;
+        vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr, &first_set);
+        test_helper_SetLayerSetting(first_set, "lunarg_test.fingerprint_spelling", spelling[0]);
+
+        VlLayerSettingSet second_set = VK_NULL_HANDLE;
+        vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr, &second_set);
+        test_helper_SetLayerSetting(second_set, "lunarg_test.fingerprint_spelling", spelling[1]);
+
+        EXPECT_NE(vlGetLayerSettingsFingerprint(first_set), vlGetLayerSettingsFingerprint(second_set)) << spelling[1];
+
+        vlDestroyLayerSettingSet(second_set, nullptr);
+        vlDestroyLayerSettingSet(first_set, nullptr);
+    }
+}
+
+TEST(test_layer_setting_enumerate, FingerprintNamespaceVariable) {
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr, &layerSettingSet);
+    const uint64_t fingerprint = vlGetLayerSettingsFingerprint(layerSettingSet);
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+
+    // Not enumerated, but read by the queries
+    SetEnv("VK_FINGERPRINT_NAMESPACE_SETTING=42");
+
+    for (bool frozen : {false, true}) {
+        vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr, &layerSettingSet);
+        if (frozen) {
+            vlFreezeLayerSettingSet(layerSettingSet);
+        }
+
+        EXPECT_TRUE(vlHasLayerSetting(layerSettingSet, "fingerprint_namespace_setting"));
+        EXPECT_TRUE(EnumerateLayerSettings(layerSettingSet, "fingerprint_namespace_").empty());
+        EXPECT_NE(fingerprint, vlGetLayerSettingsFingerprint(layerSettingSet));
+
+        vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+    }
+
+    SetEnv("VK_FINGERPRINT_NAMESPACE_SETTING=");
+}
@@ -11,6 +11,8 @@
 
 #include "vulkan/layer/vk_layer_settings.h"
 #include <vector>
+#include <string>
+#include <cstdint>
 #include <cstdlib>
 
 static void SetEnv(const char* value) {
@@ -379,6 +381,28 @@ TEST(test_layer_setting_env, vlGetLayerSettingValues_Frameset) {
     vlDestroyLayerSettingSet(layerSettingSet, nullptr);
 }
 
+TEST(test_layer_setting_env, vlGetLayerSettingValues_FramesetInvalid) {
+    SetEnv("VK_LUNARG_TEST_MY_SETTING_FRAMESET_INVALID=abc,true,1.5,-1");
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr, &layerSettingSet);
+
+    // Invalid framesets select no frame
+    uint32_t value_count = 4;
+    std::vector<VlFrameset> values(value_count, VlFrameset{76, 1, 1});
+    VkResult result_complete = vlGetLayerSettingValues(layerSettingSet, "my_setting_frameset_invalid",
+                                                       VL_LAYER_SETTING_TYPE_FRAMESET, &value_count, &values[0]);
+    EXPECT_EQ(VK_SUCCESS, result_complete);
+    EXPECT_EQ(4, value_count);
+    for (const VlFrameset &value : values) {
+        EXPECT_EQ(0, value.first);
+        EXPECT_EQ(0, value.count);
+        EXPECT_EQ(0, value.step);
+    }
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
 TEST(test_layer_setting_env, vlGetLayerSettingValues_String) {
     SetEnv("VK_LUNARG_TEST_MY_SETTING=VALUE_A,VALUE_B");
 
@@ -413,3 +437,139 @@ TEST(test_layer_setting_env, vlGetLayerSettingValues_String) {
 
     vlDestroyLayerSettingSet(layerSettingSet, nullptr);
 }
+
+TEST(test_layer_setting_env, EnvVar_Priority) {
+    SetEnv("VK_MY_SETTING_PRIORITY=namespace");
+    SetEnv("VK_TEST_MY_SETTING_PRIORITY=vendor");
+    SetEnv("VK_LUNARG_TEST_MY_SETTING_PRIORITY=none");
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr, &layerSettingSet);
+
+    uint32_t value_count = 1;
+    const char *value = nullptr;
+    VkResult result_complete =
+        vlGetLayerSettingValues(layerSettingSet, "my_setting_priority", VL_LAYER_SETTING_TYPE_STRING, &value_count, &value);
+    EXPECT_EQ(VK_SUCCESS, result_complete);
+    EXPECT_STREQ("none", value);
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+TEST(test_layer_setting_env, EnvVar_EveryPrefix) {
+    SetEnv("VK_TEST_MODE=vendor");
+    SetEnv("VK_LUNARG_FOO=namespace");
+    SetEnv("VK_LUNARG_TEST_BAR=none");
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr, &layerSettingSet);
+
+    // A variable sets the setting named by each prefix it starts with
+    EXPECT_TRUE(vlHasLayerSetting(layerSettingSet, "mode"));
+    EXPECT_TRUE(vlHasLayerSetting(layerSettingSet, "test_mode"));
+    EXPECT_TRUE(vlHasLayerSetting(layerSettingSet, "lunarg_foo"));
+    EXPECT_TRUE(vlHasLayerSetting(layerSettingSet, "bar"));
+    EXPECT_TRUE(vlHasLayerSetting(layerSettingSet, "lunarg_test_bar"));
+
+    uint32_t value_count = 1;
+    const char *value = nullptr;
+    VkResult result_complete =
+        vlGetLayerSettingValues(layerSettingSet, "lunarg_test_bar", VL_LAYER_SETTING_TYPE_STRING, &value_count, &value);
+    EXPECT_EQ(VK_SUCCESS, result_complete);
+    EXPECT_STREQ("none", value);
+
+    vlFreezeLayerSettingSet(layerSettingSet);
+    EXPECT_TRUE(vlHasLayerSetting(layerSettingSet, "test_mode"));
+    EXPECT_TRUE(vlHasLayerSetting(layerSettingSet, "lunarg_foo"));
+    EXPECT_TRUE(vlHasLayerSetting(layerSettingSet, "lunarg_test_bar"));
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+TEST(test_layer_setting_env, EnvVar_WorkaroundLayerName) {
+    SetEnv("VK_KHRONOS_SYNC2_MY_SETTING_SYNC2=sync2");
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_KHRONOS_synchronization2", nullptr, nullptr, nullptr, &layerSettingSet);
+
+    EXPECT_TRUE(vlHasLayerSetting(layerSettingSet, "my_setting_sync2"));
+
+    uint32_t value_count = 1;
+    const char *value = nullptr;
+    VkResult result_complete =
+        vlGetLayerSettingValues(layerSettingSet, "my_setting_sync2", VL_LAYER_SETTING_TYPE_STRING, &value_count, &value);
+    EXPECT_EQ(VK_SUCCESS, result_complete);
+    EXPECT_STREQ("sync2", value);
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+TEST(test_layer_setting_env, EnvVar_ReadAtCreation) {
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr, &layerSettingSet);
+
+    // The environment is read once when the layer setting set is created
+    SetEnv("VK_LUNARG_TEST_MY_SETTING_LATE=true");
+    EXPECT_FALSE(vlHasLayerSetting(layerSettingSet, "my_setting_late"));
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+static std::vector<std::string> log_messages;
+
+static void VKAPI_PTR RecordLog(const char *pSettingName, const char *pMessage) {
+    (void)pSettingName;
+    log_messages.push_back(pMessage);
+}
+
+TEST(test_layer_setting_env, vlGetLayerSettingValues_OutOfRange) {
+    SetEnv("VK_LUNARG_TEST_MY_SETTING_RANGE=18446744073709551615,0x8000000000000000,18446744073709551616");
+
+    log_messages.clear();
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, RecordLog, &layerSettingSet);
+
+    uint32_t value_count = 3;
+    std::uint64_t values_uint64[3] = {};
+    VkResult result_uint64 =
+        vlGetLayerSettingValues(layerSettingSet, "my_setting_range", VL_LAYER_SETTING_TYPE_UINT64, &value_count, values_uint64);
+    EXPECT_EQ(VK_SUCCESS, result_uint64);
+    EXPECT_EQ(UINT64_MAX, values_uint64[0]);
+    EXPECT_EQ(0x8000000000000000ull, values_uint64[1]);
+    EXPECT_EQ(UINT64_MAX, values_uint64[2]);
+    ASSERT_EQ(1, log_messages.size());
+    EXPECT_NE(std::string::npos, log_messages[0].find("18446744073709551616"));
+
+    log_messages.clear();
+
+    std::int32_t values_int32[3] = {};
+    VkResult result_int32 =
+        vlGetLayerSettingValues(layerSettingSet, "my_setting_range", VL_LAYER_SETTING_TYPE_INT32, &value_count, values_int32);
+    EXPECT_EQ(VK_SUCCESS, result_int32);
+    EXPECT_EQ(INT32_MAX, values_int32[0]);
+    EXPECT_EQ(3, log_messages.size());
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+TEST(test_layer_setting_env, vlGetLayerSettingValues_NegativeUnsigned) {
+    SetEnv("VK_LUNARG_TEST_MY_SETTING_NEGATIVE=-1,0x10,-2147483648");
+
+    log_messages.clear();
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, RecordLog, &layerSettingSet);
+
+    uint32_t value_count = 3;
+    std::uint32_t values[3] = {};
+    VkResult result =
+        vlGetLayerSettingValues(layerSettingSet, "my_setting_negative", VL_LAYER_SETTING_TYPE_UINT32, &value_count, values);
+    EXPECT_EQ(VK_SUCCESS, result);
+    EXPECT_EQ(0xFFFFFFFFu, values[0]);
+    EXPECT_EQ(16u, values[1]);
+    EXPECT_EQ(0x80000000u, values[2]);
+    EXPECT_TRUE(log_messages.empty());
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
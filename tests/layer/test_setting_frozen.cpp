@@ -0,0 +1,226 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include "vulkan/layer/vk_layer_settings.h"
+#include <vector>
+#include <thread>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+static void SetEnv(const char *value) {
+#ifdef _WIN32
+    _putenv(value);
+#else
+    putenv(const_cast<char *>(value));
+#endif
+}
+
+TEST(test_layer_setting_frozen, vlHasLayerSetting) {
+    SetEnv("VK_LUNARG_TEST_MY_FROZEN_ENV_SETTING=1");
+
+    const std::int32_t value = 76;
+    const VkLayerSettingEXT settings[] = {
+        {"VK_LAYER_LUNARG_test", "my_setting", VK_LAYER_SETTING_TYPE_INT32_EXT, 1, &value},
+        {"VK_LAYER_LUNARG_other", "other_setting", VK_LAYER_SETTING_TYPE_INT32_EXT, 1, &value}
+    };
+
+    const VkLayerSettingsCreateInfoEXT layer_settings_create_info{
+        VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr, static_cast<std::uint32_t>(std::size(settings)), settings};
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", &layer_settings_create_info, nullptr, nullptr, &layerSettingSet);
+    EXPECT_EQ(VK_SUCCESS, vlFreezeLayerSettingSet(layerSettingSet));
+    EXPECT_EQ(VK_SUCCESS, vlFreezeLayerSettingSet(layerSettingSet));
+
+    EXPECT_TRUE(vlHasLayerSetting(layerSettingSet, "my_setting"));
+    EXPECT_TRUE(vlHasLayerSetting(layerSettingSet, "my_frozen_env_setting"));
+    EXPECT_TRUE(vlHasLayerSetting(layerSettingSet, "MY_FROZEN_ENV_SETTING"));
+    EXPECT_FALSE(vlHasLayerSetting(layerSettingSet, "other_setting"));
+    EXPECT_FALSE(vlHasLayerSetting(layerSettingSet, "setting_key"));
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+TEST(test_layer_setting_frozen, vlGetLayerSettingValues_Int32) {
+    const std::int32_t input_values[] = {76, -82};
+    const VkLayerSettingEXT settings[] = {
+        {"VK_LAYER_LUNARG_test", "my_setting", VK_LAYER_SETTING_TYPE_INT32_EXT, 2, input_values}
+    };
+
+    const VkLayerSettingsCreateInfoEXT layer_settings_create_info{
+        VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr, static_cast<std::uint32_t>(std::size(settings)), settings};
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", &layer_settings_create_info, nullptr, nullptr, &layerSettingSet);
+    vlFreezeLayerSettingSet(layerSettingSet);
+
+    uint32_t value_count = 0;
+    VkResult result_count =
+        vlGetLayerSettingValues(layerSettingSet, "my_setting", VL_LAYER_SETTING_TYPE_INT32, &value_count, nullptr);
+    EXPECT_EQ(VK_SUCCESS, result_count);
+    EXPECT_EQ(2, value_count);
+
+    std::int32_t values[2] = {};
+
+    value_count = 1;
+    VkResult result_incomplete =
+        vlGetLayerSettingValues(layerSettingSet, "my_setting", VL_LAYER_SETTING_TYPE_INT32, &value_count, values);
+    EXPECT_EQ(VK_INCOMPLETE, result_incomplete);
+    EXPECT_EQ(76, values[0]);
+    EXPECT_EQ(0, values[1]);
+
+    value_count = 2;
+    VkResult result_complete =
+        vlGetLayerSettingValues(layerSettingSet, "my_setting", VL_LAYER_SETTING_TYPE_INT32, &value_count, values);
+    EXPECT_EQ(VK_SUCCESS, result_complete);
+    EXPECT_EQ(76, values[0]);
+    EXPECT_EQ(-82, values[1]);
+
+    value_count = 0;
+    VkResult result_unknown =
+        vlGetLayerSettingValues(layerSettingSet, "my_setting", VL_LAYER_SETTING_TYPE_INT32, &value_count, values);
+    EXPECT_EQ(VK_ERROR_UNKNOWN, result_unknown);
+
+    value_count = 2;
+    std::int64_t values_int64[2] = {};
+    VkResult result_format =
+        vlGetLayerSettingValues(layerSettingSet, "my_setting", VL_LAYER_SETTING_TYPE_INT64, &value_count, values_int64);
+    EXPECT_EQ(VK_ERROR_FORMAT_NOT_SUPPORTED, result_format);
+
+    value_count = 2;
+    VkResult result_unset =
+        vlGetLayerSettingValues(layerSettingSet, "setting_key", VL_LAYER_SETTING_TYPE_INT32, &value_count, values);
+    EXPECT_EQ(VK_SUCCESS, result_unset);
+    EXPECT_EQ(0, value_count);
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+static void LogMessage(const char *pSettingName, const char *pMessage) {
+    (void)pSettingName;
+    (void)pMessage;
+}
+
+TEST(test_layer_setting_frozen, ConcurrentQueries) {
+    SetEnv("VK_LUNARG_TEST_MY_FROZEN_LIST=1,2,3,4");
+    SetEnv("VK_LUNARG_TEST_MY_FROZEN_INVALID=value");
+
+    const VkBool32 input_bool = VK_TRUE;
+    const std::uint32_t input_uint32[] = {76, 82};
+    const double input_float64 = 3.5;
+    const char *input_strings[] = {"value0", "value1"};
+    const VkLayerSettingEXT settings[] = {
+        {"VK_LAYER_LUNARG_test", "my_bool", VK_LAYER_SETTING_TYPE_BOOL32_EXT, 1, &input_bool},
+        {"VK_LAYER_LUNARG_test", "my_uint32", VK_LAYER_SETTING_TYPE_UINT32_EXT, 2, input_uint32},
+        {"VK_LAYER_LUNARG_test", "my_float64", VK_LAYER_SETTING_TYPE_FLOAT64_EXT, 1, &input_float64},
+        {"VK_LAYER_LUNARG_test", "my_strings", VK_LAYER_SETTING_TYPE_STRING_EXT, 2, input_strings}
+    };
+
+    const VkLayerSettingsCreateInfoEXT layer_settings_create_info{
+        VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr, static_cast<std::uint32_t>(std::size(settings)), settings};
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", &layer_settings_create_info, nullptr, LogMessage, &layerSettingSet);
+    vlFreezeLayerSettingSet(layerSettingSet);
+
+    uint32_t reference_count = 2;
+    const char *reference_strings[2] = {};
+    vlGetLayerSettingValues(layerSettingSet, "my_strings", VL_LAYER_SETTING_TYPE_STRING, &reference_count, reference_strings);
+
+    std::vector<int> failures(8, 0);
+    std::vector<std::thread> threads;
+    for (std::size_t thread_index = 0; thread_index < failures.size(); ++thread_index) {
+        threads.emplace_back([&, thread_index]() {
+            for (int query = 0; query < 1000; ++query) {
+                VkBool32 value_bool = VK_FALSE;
+                uint32_t count_bool = 1;
+                vlGetLayerSettingValues(layerSettingSet, "my_bool", VL_LAYER_SETTING_TYPE_BOOL32, &count_bool, &value_bool);
+                failures[thread_index] += value_bool == VK_TRUE ? 0 : 1;
+
+                std::uint32_t values_uint32[2] = {};
+                uint32_t count_uint32 = 2;
+                vlGetLayerSettingValues(layerSettingSet, "my_uint32", VL_LAYER_SETTING_TYPE_UINT32, &count_uint32, values_uint32);
+                failures[thread_index] += values_uint32[0] == 76 && values_uint32[1] == 82 ? 0 : 1;
+
+                double value_float64 = 0.0;
+                uint32_t count_float64 = 1;
+                vlGetLayerSettingValues(layerSettingSet, "my_float64", VL_LAYER_SETTING_TYPE_FLOAT64, &count_float64,
+                                        &value_float64);
+                failures[thread_index] += value_float64 == 3.5 ? 0 : 1;
+
+                const char *values_strings[2] = {};
+                uint32_t count_strings = 2;
+                vlGetLayerSettingValues(layerSettingSet, "my_strings", VL_LAYER_SETTING_TYPE_STRING, &count_strings,
+                                        values_strings);
+                failures[thread_index] += values_strings[0] == reference_strings[0] && values_strings[1] == reference_strings[1] ? 0 : 1;
+
+                std::uint64_t values_list[4] = {};
+                uint32_t count_list = 4;
+                vlGetLayerSettingValues(layerSettingSet, "my_frozen_list", VL_LAYER_SETTING_TYPE_UINT64, &count_list, values_list);
+                failures[thread_index] += values_list[0] == 1 && values_list[3] == 4 ? 0 : 1;
+
+                std::int32_t value_invalid = 0;
+                uint32_t count_invalid = 1;
+                vlGetLayerSettingValues(layerSettingSet, "my_frozen_invalid", VL_LAYER_SETTING_TYPE_INT32, &count_invalid,
+                                        &value_invalid);
+
+                // Settings missing from the frozen settings are resolved on their first query
+                uint32_t count_late = 4;
+                vlGetLayerSettingValues(layerSettingSet, "MY_FROZEN_LIST", VL_LAYER_SETTING_TYPE_UINT64, &count_late, values_list);
+                failures[thread_index] += count_late == 4 ? 0 : 1;
+
+                failures[thread_index] += vlHasLayerSetting(layerSettingSet, "my_bool") == VK_TRUE ? 0 : 1;
+            }
+        });
+    }
+
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    for (int failure : failures) {
+        EXPECT_EQ(0, failure);
+    }
+
+    EXPECT_STREQ("value0", reference_strings[0]);
+    EXPECT_STREQ("value1", reference_strings[1]);
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+TEST(test_layer_setting_frozen, UnknownSettings) {
+    const std::int32_t value = 76;
+    const VkLayerSettingEXT settings[] = {{"VK_LAYER_LUNARG_test", "my_setting", VK_LAYER_SETTING_TYPE_INT32_EXT, 1, &value}};
+    const VkLayerSettingsCreateInfoEXT layer_settings_create_info{VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr, 1,
+                                                                  settings};
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSetWithFlags("VK_LAYER_LUNARG_test", &layer_settings_create_info, nullptr, nullptr,
+                                     VL_LAYER_SETTING_SET_CREATE_STATISTICS_BIT, &layerSettingSet);
+    vlFreezeLayerSettingSet(layerSettingSet);
+
+    VlLayerSettingStatistics statistics{};
+    vlGetLayerSettingStatistics(layerSettingSet, &statistics);
+
+    // Settings no source sets are answered by the presence filter, they're neither resolved nor stored
+    for (int i = 0; i < 1000; ++i) {
+        const std::string setting_name = "my_unknown_setting_" + std::to_string(i);
+        std::int32_t read_value = 0;
+        uint32_t value_count = 1;
+        EXPECT_EQ(VK_SUCCESS, vlGetLayerSettingValues(layerSettingSet, setting_name.c_str(), VL_LAYER_SETTING_TYPE_INT32,
+                                                      &value_count, &read_value));
+        EXPECT_EQ(0u, value_count);
+    }
+
+    VlLayerSettingStatistics unknown_statistics{};
+    vlGetLayerSettingStatistics(layerSettingSet, &unknown_statistics);
+    EXPECT_EQ(statistics.cacheMissCount, unknown_statistics.cacheMissCount);
+    EXPECT_EQ(statistics.allocatedBytes, unknown_statistics.allocatedBytes);
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
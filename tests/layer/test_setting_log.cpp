@@ -0,0 +1,146 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include "vulkan/layer/vk_layer_settings.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+static void SetEnv(const char *value) {
+#ifdef _WIN32
+    _putenv(value);
+#else
+    putenv(const_cast<char *>(value));
+#endif
+}
+
+// Messages are logged by the background thread of the layer setting set
+static std::mutex logged_messages_mutex;
+static std::vector<std::string> logged_messages;
+
+static void VKAPI_PTR RecordMessage(const char *pSettingName, const char *pMessage) {
+    std::lock_guard<std::mutex> lock(logged_messages_mutex);
+    logged_messages.push_back(std::string(pSettingName) + ": " + pMessage);
+}
+
+static std::vector<std::string> GetLoggedMessages() {
+    std::lock_guard<std::mutex> lock(logged_messages_mutex);
+    return logged_messages;
+}
+
+static void QueryInt32(VlLayerSettingSet layerSettingSet, const char *pSettingName) {
+    int32_t value = 0;
+    uint32_t value_count = 1;
+    vlGetLayerSettingValues(layerSettingSet, pSettingName, VL_LAYER_SETTING_TYPE_INT32, &value_count, &value);
+}
+
+TEST(test_layer_setting_log, Disabled) {
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr, &layerSettingSet);
+
+    EXPECT_EQ(VK_ERROR_FEATURE_NOT_PRESENT, vlSetLayerSettingLogRateLimit(layerSettingSet, 10));
+    EXPECT_EQ(VK_ERROR_FEATURE_NOT_PRESENT, vlFlushLayerSettingLog(layerSettingSet));
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+TEST(test_layer_setting_log, Duplicates) {
+    SetEnv("VK_LUNARG_TEST_MY_DUPLICATE_SETTING=not_an_integer");
+
+    logged_messages.clear();
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSetWithFlags("VK_LAYER_LUNARG_test", nullptr, nullptr, RecordMessage,
+                                     VL_LAYER_SETTING_SET_CREATE_ASYNC_LOG_BIT, &layerSettingSet);
+
+    for (int i = 0; i < 10; ++i) {
+        QueryInt32(layerSettingSet, "my_duplicate_setting");
+    }
+    EXPECT_EQ(VK_SUCCESS, vlFlushLayerSettingLog(layerSettingSet));
+
+    const std::vector<std::string> &messages = GetLoggedMessages();
+    ASSERT_EQ(2u, messages.size());
+    EXPECT_STREQ("my_duplicate_setting: The data provided (not_an_integer) is not an integer value.", messages[0].c_str());
+    EXPECT_STREQ("VK_LAYER_LUNARG_test: 9 duplicate messages suppressed.", messages[1].c_str());
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+    EXPECT_EQ(2u, GetLoggedMessages().size());
+}
+
+TEST(test_layer_setting_log, RateLimit) {
+    static std::vector<std::string> variables;
+    for (int i = 0; i < 20; ++i) {
+        variables.push_back("VK_LUNARG_TEST_MY_RATE_SETTING_" + std::to_string(i) + "=not_an_integer");
+    }
+    for (const std::string &variable : variables) {
+        SetEnv(variable.c_str());
+    }
+
+    logged_messages.clear();
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSetWithFlags("VK_LAYER_LUNARG_test", nullptr, nullptr, RecordMessage,
+                                     VL_LAYER_SETTING_SET_CREATE_ASYNC_LOG_BIT, &layerSettingSet);
+    EXPECT_EQ(VK_SUCCESS, vlSetLayerSettingLogRateLimit(layerSettingSet, 5));
+
+    for (int i = 0; i < 20; ++i) {
+        QueryInt32(layerSettingSet, ("my_rate_setting_" + std::to_string(i)).c_str());
+    }
+    EXPECT_EQ(VK_SUCCESS, vlFlushLayerSettingLog(layerSettingSet));
+
+    const std::vector<std::string> &messages = GetLoggedMessages();
+    ASSERT_EQ(6u, messages.size());
+    EXPECT_STREQ("VK_LAYER_LUNARG_test: 15 messages suppressed by the rate limit.", messages[5].c_str());
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+TEST(test_layer_setting_log, RateLimitedLoggedLater) {
+    SetEnv("VK_LUNARG_TEST_MY_FIRST_LIMITED_SETTING=not_an_integer");
+    SetEnv("VK_LUNARG_TEST_MY_SECOND_LIMITED_SETTING=not_an_integer");
+
+    logged_messages.clear();
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSetWithFlags("VK_LAYER_LUNARG_test", nullptr, nullptr, RecordMessage,
+                                     VL_LAYER_SETTING_SET_CREATE_ASYNC_LOG_BIT, &layerSettingSet);
+    EXPECT_EQ(VK_SUCCESS, vlSetLayerSettingLogRateLimit(layerSettingSet, 1));
+
+    QueryInt32(layerSettingSet, "my_first_limited_setting");
+    QueryInt32(layerSettingSet, "my_second_limited_setting");
+    EXPECT_EQ(VK_SUCCESS, vlFlushLayerSettingLog(layerSettingSet));
+    ASSERT_EQ(2u, GetLoggedMessages().size());
+
+    // A message suppressed by the rate limit isn't a duplicate once the rate window ends
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    QueryInt32(layerSettingSet, "my_second_limited_setting");
+    EXPECT_EQ(VK_SUCCESS, vlFlushLayerSettingLog(layerSettingSet));
+
+    const std::vector<std::string> &messages = GetLoggedMessages();
+    ASSERT_EQ(3u, messages.size());
+    EXPECT_STREQ("VK_LAYER_LUNARG_test: 1 messages suppressed by the rate limit.", messages[1].c_str());
+    EXPECT_STREQ("my_second_limited_setting: The data provided (not_an_integer) is not an integer value.", messages[2].c_str());
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+TEST(test_layer_setting_log, Destroy) {
+    SetEnv("VK_LUNARG_TEST_MY_DESTROY_SETTING=not_an_integer");
+
+    logged_messages.clear();
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSetWithFlags("VK_LAYER_LUNARG_test", nullptr, nullptr, RecordMessage,
+                                     VL_LAYER_SETTING_SET_CREATE_ASYNC_LOG_BIT, &layerSettingSet);
+
+    QueryInt32(layerSettingSet, "my_destroy_setting");
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+
+    const std::vector<std::string> &messages = GetLoggedMessages();
+    ASSERT_EQ(1u, messages.size());
+    EXPECT_STREQ("my_destroy_setting: The data provided (not_an_integer) is not an integer value.", messages[0].c_str());
+}
@@ -0,0 +1,389 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include "vulkan/layer/vk_layer_settings.h"
+#include "layer_settings_overlay.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if (defined(__linux__) && !defined(__ANDROID__)) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+void test_helper_SetLayerSetting(VlLayerSettingSet layerSettingSet, const char *pSettingName, const char *pValue);
+
+static std::string GetStringSetting(VlLayerSettingSet layerSettingSet, const char *pSettingName) {
+    uint32_t value_count = 1;
+    const char *value = nullptr;
+    vlGetLayerSettingValues(layerSettingSet, pSettingName, VL_LAYER_SETTING_TYPE_STRING, &value_count, &value);
+    return value == nullptr ? "" : value;
+}
+
+#if (defined(__linux__) && !defined(__ANDROID__)) || defined(__APPLE__)
+
+static std::string GetSegmentName(const char *pTestName) {
+    return "vl_test_" + std::string(pTestName) + "_" + std::to_string(getpid());
+}
+
+// Frozen layer setting sets load the overlay values on a background thread
+template <typename Predicate>
+static bool WaitFor(Predicate predicate) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+TEST(test_layer_setting_overlay, Priority) {
+    const std::string &segment = GetSegmentName("priority");
+    ASSERT_EQ(VK_SUCCESS, vlSetLayerSettingsOverlayValue(segment.c_str(), "VK_LAYER_LUNARG_test", "overlay_env", "overlay"));
+    ASSERT_EQ(VK_SUCCESS, vlSetLayerSettingsOverlayValue(segment.c_str(), "VK_LAYER_LUNARG_test", "overlay_file", "overlay"));
+    ASSERT_EQ(VK_SUCCESS, vlSetLayerSettingsOverlayValue(segment.c_str(), "VK_LAYER_LUNARG_test", "overlay_api", "overlay"));
+    ASSERT_EQ(VK_SUCCESS, vlSetLayerSettingsOverlayValue(segment.c_str(), "VK_LAYER_LUNARG_test", "overlay_only", "overlay"));
+    ASSERT_EQ(VK_SUCCESS, vlSetLayerSettingsOverlayValue(segment.c_str(), "VK_LAYER_LUNARG_other", "overlay_other", "overlay"));
+
+    setenv("VK_LUNARG_TEST_OVERLAY_ENV", "env", 1);
+
+    const char *api_value = "api";
+    const VkLayerSettingEXT settings[] = {{"VK_LAYER_LUNARG_test", "overlay_api", VK_LAYER_SETTING_TYPE_STRING_EXT, 1, &api_value}};
+    const VkLayerSettingsCreateInfoEXT layer_settings_create_info{VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr, 1,
+                                                                  settings};
+
+    struct Expected {
+        VlLayerSettingsOverlayPriority priority;
+        const char *env;
+        const char *file;
+        const char *api;
+    };
+
+    const Expected expected_values[] = {
+        {VL_LAYER_SETTINGS_OVERLAY_PRIORITY_HIGHEST, "overlay", "overlay", "overlay"},
+        {VL_LAYER_SETTINGS_OVERLAY_PRIORITY_BELOW_ENV, "env", "overlay", "overlay"},
+        {VL_LAYER_SETTINGS_OVERLAY_PRIORITY_BELOW_FILE, "env", "file", "overlay"},
+        {VL_LAYER_SETTINGS_OVERLAY_PRIORITY_LOWEST, "env", "file", "api"},
+    };
+
+    for (const Expected &expected : expected_values) {
+        VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+        vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", &layer_settings_create_info, nullptr, nullptr, &layerSettingSet);
+        test_helper_SetLayerSetting(layerSettingSet, "lunarg_test.overlay_file", "file");
+
+        EXPECT_EQ(VK_SUCCESS, vlAttachLayerSettingsOverlay(layerSettingSet, segment.c_str(), expected.priority));
+
+        EXPECT_EQ(expected.env, GetStringSetting(layerSettingSet, "overlay_env"));
+        EXPECT_EQ(expected.file, GetStringSetting(layerSettingSet, "overlay_file"));
+        EXPECT_EQ(expected.api, GetStringSetting(layerSettingSet, "overlay_api"));
+        EXPECT_EQ("overlay", GetStringSetting(layerSettingSet, "overlay_only"));
+        EXPECT_TRUE(vlHasLayerSetting(layerSettingSet, "overlay_only"));
+        EXPECT_FALSE(vlHasLayerSetting(layerSettingSet, "overlay_other"));
+
+        vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+    }
+
+    unsetenv("VK_LUNARG_TEST_OVERLAY_ENV");
+    EXPECT_EQ(VK_SUCCESS, vlRemoveLayerSettingsOverlay(segment.c_str()));
+}
+
+TEST(test_layer_setting_overlay, Update) {
+    const std::string &segment = GetSegmentName("update");
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr, &layerSettingSet);
+
+    // The segment is created by the first process using it
+    EXPECT_EQ(VK_SUCCESS,
+              vlAttachLayerSettingsOverlay(layerSettingSet, segment.c_str(), VL_LAYER_SETTINGS_OVERLAY_PRIORITY_HIGHEST));
+    EXPECT_EQ(VK_ERROR_INITIALIZATION_FAILED,
+              vlAttachLayerSettingsOverlay(layerSettingSet, segment.c_str(), VL_LAYER_SETTINGS_OVERLAY_PRIORITY_HIGHEST));
+    EXPECT_FALSE(vlHasLayerSetting(layerSettingSet, "my_setting"));
+
+    EXPECT_EQ(VK_SUCCESS, vlSetLayerSettingsOverlayValue(segment.c_str(), "VK_LAYER_LUNARG_test", "my_setting", "76"));
+    EXPECT_EQ("76", GetStringSetting(layerSettingSet, "my_setting"));
+
+    EXPECT_EQ(VK_SUCCESS, vlSetLayerSettingsOverlayValue(segment.c_str(), "VK_LAYER_LUNARG_test", "my_setting", "82"));
+    EXPECT_EQ("82", GetStringSetting(layerSettingSet, "my_setting"));
+
+    EXPECT_EQ(VK_SUCCESS, vlSetLayerSettingsOverlayValue(segment.c_str(), "VK_LAYER_LUNARG_test", "my_setting", nullptr));
+    EXPECT_FALSE(vlHasLayerSetting(layerSettingSet, "my_setting"));
+
+    const std::string long_value(512, 'a');
+    EXPECT_EQ(VK_ERROR_INITIALIZATION_FAILED,
+              vlSetLayerSettingsOverlayValue(segment.c_str(), "VK_LAYER_LUNARG_test", "my_setting", long_value.c_str()));
+
+    // The layer setting set keeps reading the segment once removed
+    EXPECT_EQ(VK_SUCCESS, vlSetLayerSettingsOverlayValue(segment.c_str(), "VK_LAYER_LUNARG_test", "my_setting", "true"));
+    EXPECT_EQ(VK_SUCCESS, vlRemoveLayerSettingsOverlay(segment.c_str()));
+    EXPECT_EQ("true", GetStringSetting(layerSettingSet, "my_setting"));
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+TEST(test_layer_setting_overlay, Enumerate) {
+    const std::string &segment = GetSegmentName("enumerate");
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr, &layerSettingSet);
+    test_helper_SetLayerSetting(layerSettingSet, "lunarg_test.overlay_enum_file", "file");
+    EXPECT_EQ(VK_SUCCESS,
+              vlAttachLayerSettingsOverlay(layerSettingSet, segment.c_str(), VL_LAYER_SETTINGS_OVERLAY_PRIORITY_HIGHEST));
+    vlFreezeLayerSettingSet(layerSettingSet);
+
+    std::vector<VlLayerSettingInfo> settings(2);
+    uint32_t setting_count = 2;
+    EXPECT_EQ(VK_SUCCESS, vlEnumerateLayerSettings(layerSettingSet, "overlay_enum_*", &setting_count, settings.data()));
+    ASSERT_EQ(1, setting_count);
+    EXPECT_EQ(VL_LAYER_SETTING_SOURCE_FILE, settings[0].source);
+
+    // The frozen set is frozen again with the overlay values
+    EXPECT_EQ(VK_SUCCESS, vlSetLayerSettingsOverlayValue(segment.c_str(), "VK_LAYER_LUNARG_test", "overlay_enum_file", "overlay"));
+    EXPECT_EQ(VK_SUCCESS, vlSetLayerSettingsOverlayValue(segment.c_str(), "VK_LAYER_LUNARG_test", "overlay_enum_only", "overlay"));
+
+    ASSERT_TRUE(WaitFor([&]() {
+        setting_count = 2;
+        return vlEnumerateLayerSettings(layerSettingSet, "overlay_enum_*", &setting_count, settings.data()) == VK_SUCCESS &&
+               setting_count == 2;
+    }));
+    EXPECT_STREQ("overlay_enum_file", settings[0].pSettingName);
+    EXPECT_EQ(VL_LAYER_SETTING_SOURCE_OVERLAY, settings[0].source);
+    EXPECT_STREQ("overlay_enum_only", settings[1].pSettingName);
+    EXPECT_EQ(VL_LAYER_SETTING_SOURCE_OVERLAY, settings[1].source);
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+    EXPECT_EQ(VK_SUCCESS, vlRemoveLayerSettingsOverlay(segment.c_str()));
+}
+
+TEST(test_layer_setting_overlay, WriterProcess) {
+    const std::string &segment = GetSegmentName("writer");
+    const uint32_t last_value = 500;
+
+    // The writer waits for the readers to start
+    int start_pipe[2];
+    ASSERT_EQ(0, pipe(start_pipe));
+
+    const pid_t writer = fork();
+    ASSERT_NE(-1, writer);
+    if (writer == 0) {
+        close(start_pipe[1]);
+        char start = 0;
+        if (read(start_pipe[0], &start, 1) != 1) {
+            _exit(1);
+        }
+
+        // Each value is written three times in a single update, so a torn read shows different values
+        for (uint32_t value = 1; value <= last_value; ++value) {
+            const std::string &values = std::to_string(value) + "," + std::to_string(value) + "," + std::to_string(value);
+            if (vlSetLayerSettingsOverlayValue(segment.c_str(), "VK_LAYER_LUNARG_test", "my_counter", values.c_str()) != VK_SUCCESS) {
+                _exit(2);
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        _exit(0);
+    }
+    close(start_pipe[0]);
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr, &layerSettingSet);
+    EXPECT_EQ(VK_SUCCESS,
+              vlAttachLayerSettingsOverlay(layerSettingSet, segment.c_str(), VL_LAYER_SETTINGS_OVERLAY_PRIORITY_HIGHEST));
+    vlFreezeLayerSettingSet(layerSettingSet);
+
+    std::atomic<uint32_t> torn_reads{0};
+    std::atomic<uint32_t> decreasing_reads{0};
+    std::atomic<uint32_t> completed_readers{0};
+
+    std::vector<std::thread> readers;
+    for (int reader_index = 0; reader_index < 4; ++reader_index) {
+        readers.emplace_back([&]() {
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+
+            uint32_t previous_value = 0;
+            while (previous_value < last_value && std::chrono::steady_clock::now() < deadline) {
+                uint32_t values[3] = {0, 0, 0};
+                uint32_t value_count = 3;
+                if (vlGetLayerSettingValues(layerSettingSet, "my_counter", VL_LAYER_SETTING_TYPE_UINT32, &value_count, values) !=
+                    VK_SUCCESS) {
+                    continue;  // Not written yet
+                }
+
+                if (values[0] != values[1] || values[1] != values[2]) {
+                    ++torn_reads;
+                }
+                if (values[0] < previous_value) {
+                    ++decreasing_reads;
+                }
+                previous_value = values[0];
+            }
+
+            if (previous_value == last_value) {
+                ++completed_readers;
+            }
+        });
+    }
+
+    ASSERT_EQ(1, write(start_pipe[1], "s", 1));
+    close(start_pipe[1]);
+
+    for (std::thread &reader : readers) {
+        reader.join();
+    }
+
+    int status = 0;
+    ASSERT_EQ(writer, waitpid(writer, &status, 0));
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(0, WEXITSTATUS(status));
+
+    EXPECT_EQ(0u, torn_reads.load());
+    EXPECT_EQ(0u, decreasing_reads.load());
+    EXPECT_EQ(4u, completed_readers.load());
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+    vlRemoveLayerSettingsOverlay(segment.c_str());
+}
+
+static vl::SettingsOverlaySegment *MapOverlaySegment(const std::string &segment) {
+    const int fd = shm_open(("/" + segment).c_str(), O_RDWR, 0600);
+    if (fd < 0) {
+        return nullptr;
+    }
+    void *mapping = mmap(nullptr, sizeof(vl::SettingsOverlaySegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    return mapping == MAP_FAILED ? nullptr : static_cast<vl::SettingsOverlaySegment *>(mapping);
+}
+
+TEST(test_layer_setting_overlay, DeadWriter) {
+    const std::string &segment = GetSegmentName("dead_writer");
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr, &layerSettingSet);
+    EXPECT_EQ(VK_SUCCESS,
+              vlAttachLayerSettingsOverlay(layerSettingSet, segment.c_str(), VL_LAYER_SETTINGS_OVERLAY_PRIORITY_HIGHEST));
+    EXPECT_EQ(VK_SUCCESS, vlSetLayerSettingsOverlayValue(segment.c_str(), "VK_LAYER_LUNARG_test", "my_setting", "76"));
+    EXPECT_EQ("76", GetStringSetting(layerSettingSet, "my_setting"));
+
+    vl::SettingsOverlaySegment *overlay_segment = MapOverlaySegment(segment);
+    ASSERT_NE(nullptr, overlay_segment);
+    EXPECT_EQ(0u, overlay_segment->sequence.load() & 1);
+    EXPECT_EQ(0u, overlay_segment->writer_pid.load());
+
+    // A writer which took the table without recording its process ID yet is considered running
+    overlay_segment->sequence.fetch_add(1);
+    EXPECT_EQ(VK_ERROR_INITIALIZATION_FAILED,
+              vlSetLayerSettingsOverlayValue(segment.c_str(), "VK_LAYER_LUNARG_test", "my_setting", "82"));
+    overlay_segment->sequence.fetch_add(1);
+
+    // The writer takes the table and waits, then exits as if it crashed while writing
+    int exit_pipe[2];
+    ASSERT_EQ(0, pipe(exit_pipe));
+
+    const pid_t writer = fork();
+    ASSERT_NE(-1, writer);
+    if (writer == 0) {
+        close(exit_pipe[1]);
+        overlay_segment->sequence.fetch_add(1);
+        overlay_segment->writer_pid.store(static_cast<uint32_t>(getpid()));
+        char exit_byte = 0;
+        if (read(exit_pipe[0], &exit_byte, 1) < 0) {
+            _exit(1);
+        }
+        _exit(0);
+    }
+    close(exit_pipe[0]);
+
+    // A running writer isn't taken over
+    ASSERT_TRUE(WaitFor([&]() { return overlay_segment->writer_pid.load() == static_cast<uint32_t>(writer); }));
+    EXPECT_EQ(VK_ERROR_INITIALIZATION_FAILED,
+              vlSetLayerSettingsOverlayValue(segment.c_str(), "VK_LAYER_LUNARG_test", "my_setting", "82"));
+
+    close(exit_pipe[1]);
+    int status = 0;
+    ASSERT_EQ(writer, waitpid(writer, &status, 0));
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(0, WEXITSTATUS(status));
+
+    // Readers keep the values of the last completed write
+    EXPECT_EQ("76", GetStringSetting(layerSettingSet, "my_setting"));
+
+    // The next writer takes the table over once the write deadline is reached
+    EXPECT_EQ(VK_SUCCESS, vlSetLayerSettingsOverlayValue(segment.c_str(), "VK_LAYER_LUNARG_test", "my_setting", "82"));
+    EXPECT_EQ("82", GetStringSetting(layerSettingSet, "my_setting"));
+    EXPECT_EQ(0u, overlay_segment->sequence.load() & 1);
+    EXPECT_EQ(0u, overlay_segment->writer_pid.load());
+    EXPECT_EQ(VK_SUCCESS, vlSetLayerSettingsOverlayValue(segment.c_str(), "VK_LAYER_LUNARG_test", "my_setting", "true"));
+    EXPECT_EQ("true", GetStringSetting(layerSettingSet, "my_setting"));
+
+    munmap(overlay_segment, sizeof(vl::SettingsOverlaySegment));
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+    vlRemoveLayerSettingsOverlay(segment.c_str());
+}
+
+TEST(test_layer_setting_overlay, ReleaseReplacedValues) {
+    const std::string &segment = GetSegmentName("release");
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr, &layerSettingSet);
+    EXPECT_EQ(VK_SUCCESS,
+              vlAttachLayerSettingsOverlay(layerSettingSet, segment.c_str(), VL_LAYER_SETTINGS_OVERLAY_PRIORITY_HIGHEST));
+    vlFreezeLayerSettingSet(layerSettingSet);
+
+    VlLayerSettingSetMemoryUsage memory_usage{};
+    for (int update = 1; update <= 40; ++update) {
+        const char *value = update % 2 == 0 ? "76" : "82";
+        EXPECT_EQ(VK_SUCCESS, vlSetLayerSettingsOverlayValue(segment.c_str(), "VK_LAYER_LUNARG_test", "my_setting", value));
+        ASSERT_TRUE(WaitFor([&]() { return GetStringSetting(layerSettingSet, "my_setting") == value; }));
+        if (update == 10) {
+            vlGetLayerSettingSetMemoryUsage(layerSettingSet, &memory_usage);
+        }
+    }
+
+    // The overlay values and frozen settings replaced by each update are released
+    VlLayerSettingSetMemoryUsage final_memory_usage{};
+    vlGetLayerSettingSetMemoryUsage(layerSettingSet, &final_memory_usage);
+    EXPECT_EQ(memory_usage.allocatedBytes, final_memory_usage.allocatedBytes);
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+    vlRemoveLayerSettingsOverlay(segment.c_str());
+}
+
+#else
+
+TEST(test_layer_setting_overlay, NotSupported) {
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr, &layerSettingSet);
+
+    EXPECT_EQ(VK_ERROR_FEATURE_NOT_PRESENT,
+              vlAttachLayerSettingsOverlay(layerSettingSet, "vl_test_overlay", VL_LAYER_SETTINGS_OVERLAY_PRIORITY_HIGHEST));
+    EXPECT_EQ(VK_ERROR_FEATURE_NOT_PRESENT, vlSetLayerSettingsOverlayValue("vl_test_overlay", "VK_LAYER_LUNARG_test", "my_setting", "76"));
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+#endif
+
+TEST(test_layer_setting_overlay, ResolvedSnapshot) {
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSetWithFlags("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr,
+                                     VL_LAYER_SETTING_SET_CREATE_RESOLVED_SNAPSHOT_BIT, &layerSettingSet);
+
+    EXPECT_EQ(VK_ERROR_FEATURE_NOT_PRESENT,
+              vlAttachLayerSettingsOverlay(layerSettingSet, "vl_test_snapshot", VL_LAYER_SETTINGS_OVERLAY_PRIORITY_HIGHEST));
+    EXPECT_EQ("", GetStringSetting(layerSettingSet, "my_setting"));
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
@@ -0,0 +1,202 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include "vulkan/layer/vk_layer_settings.h"
+#include <vector>
+#include <cstdlib>
+#include <string>
+
+static void SetEnv(const char *value) {
+#ifdef _WIN32
+    _putenv(value);
+#else
+    putenv(const_cast<char *>(value));
+#endif
+}
+
+TEST(test_layer_setting_snapshot, vlHasLayerSetting) {
+    const std::int32_t value = 76;
+    const VkLayerSettingEXT settings[] = {
+        {"VK_LAYER_LUNARG_test", "my_setting", VK_LAYER_SETTING_TYPE_INT32_EXT, 1, &value},
+        {"VK_LAYER_LUNARG_other", "other_setting", VK_LAYER_SETTING_TYPE_INT32_EXT, 1, &value}
+    };
+
+    const VkLayerSettingsCreateInfoEXT layer_settings_create_info{
+        VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr, static_cast<std::uint32_t>(std::size(settings)), settings};
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSetWithFlags("VK_LAYER_LUNARG_test", &layer_settings_create_info, nullptr, nullptr,
+                                     VL_LAYER_SETTING_SET_CREATE_RESOLVED_SNAPSHOT_BIT, &layerSettingSet);
+
+    EXPECT_TRUE(vlHasLayerSetting(layerSettingSet, "my_setting"));
+    EXPECT_FALSE(vlHasLayerSetting(layerSettingSet, "other_setting"));
+    EXPECT_FALSE(vlHasLayerSetting(layerSettingSet, "setting_key"));
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+TEST(test_layer_setting_snapshot, vlGetLayerSettingValues_Int32) {
+    const std::int32_t input_values[] = {76, -82};
+    const VkLayerSettingEXT settings[] = {
+        {"VK_LAYER_LUNARG_test", "my_setting", VK_LAYER_SETTING_TYPE_INT32_EXT, 2, input_values}
+    };
+
+    const VkLayerSettingsCreateInfoEXT layer_settings_create_info{
+        VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr, static_cast<std::uint32_t>(std::size(settings)), settings};
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSetWithFlags("VK_LAYER_LUNARG_test", &layer_settings_create_info, nullptr, nullptr,
+                                     VL_LAYER_SETTING_SET_CREATE_RESOLVED_SNAPSHOT_BIT, &layerSettingSet);
+
+    for (int query = 0; query < 2; ++query) {
+        uint32_t value_count = 0;
+        VkResult result_count =
+            vlGetLayerSettingValues(layerSettingSet, "my_setting", VL_LAYER_SETTING_TYPE_INT32, &value_count, nullptr);
+        EXPECT_EQ(VK_SUCCESS, result_count);
+        EXPECT_EQ(2, value_count);
+
+        std::vector<std::int32_t> values(static_cast<uint32_t>(value_count));
+
+        value_count = 1;
+        VkResult result_incomplete =
+            vlGetLayerSettingValues(layerSettingSet, "my_setting", VL_LAYER_SETTING_TYPE_INT32, &value_count, &values[0]);
+        EXPECT_EQ(VK_INCOMPLETE, result_incomplete);
+        EXPECT_EQ(76, values[0]);
+        EXPECT_EQ(0, values[1]);
+        EXPECT_EQ(1, value_count);
+
+        value_count = 2;
+        VkResult result_complete =
+            vlGetLayerSettingValues(layerSettingSet, "my_setting", VL_LAYER_SETTING_TYPE_INT32, &value_count, &values[0]);
+        EXPECT_EQ(VK_SUCCESS, result_complete);
+        EXPECT_EQ(76, values[0]);
+        EXPECT_EQ(-82, values[1]);
+        EXPECT_EQ(2, value_count);
+    }
+
+    uint32_t value_count = 2;
+    std::int64_t values_int64[2] = {};
+    VkResult result_format =
+        vlGetLayerSettingValues(layerSettingSet, "my_setting", VL_LAYER_SETTING_TYPE_INT64, &value_count, values_int64);
+    EXPECT_EQ(VK_ERROR_FORMAT_NOT_SUPPORTED, result_format);
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+TEST(test_layer_setting_snapshot, vlGetLayerSettingValues_String) {
+    const std::uint32_t input_values[] = {76, 82};
+    const VkLayerSettingEXT settings[] = {
+        {"VK_LAYER_LUNARG_test", "my_setting", VK_LAYER_SETTING_TYPE_UINT32_EXT, 2, input_values}
+    };
+
+    const VkLayerSettingsCreateInfoEXT layer_settings_create_info{
+        VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr, static_cast<std::uint32_t>(std::size(settings)), settings};
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSetWithFlags("VK_LAYER_LUNARG_test", &layer_settings_create_info, nullptr, nullptr,
+                                     VL_LAYER_SETTING_SET_CREATE_RESOLVED_SNAPSHOT_BIT, &layerSettingSet);
+
+    uint32_t value_count = 2;
+    const char *values_first[2] = {};
+    VkResult result_first =
+        vlGetLayerSettingValues(layerSettingSet, "my_setting", VL_LAYER_SETTING_TYPE_STRING, &value_count, values_first);
+    EXPECT_EQ(VK_SUCCESS, result_first);
+    EXPECT_STREQ("76", values_first[0]);
+    EXPECT_STREQ("82", values_first[1]);
+
+    // Values returned by the snapshot remain valid and identical across queries
+    const char *values_second[2] = {};
+    VkResult result_second =
+        vlGetLayerSettingValues(layerSettingSet, "my_setting", VL_LAYER_SETTING_TYPE_STRING, &value_count, values_second);
+    EXPECT_EQ(VK_SUCCESS, result_second);
+    EXPECT_EQ(values_first[0], values_second[0]);
+    EXPECT_EQ(values_first[1], values_second[1]);
+    EXPECT_STREQ("76", values_first[0]);
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+TEST(test_layer_setting_snapshot, EnvVar_OverrideAPI) {
+    SetEnv("VK_LUNARG_TEST_MY_SNAPSHOT_SETTING=1.5,2.5");
+
+    const float input_values[] = {76.f};
+    const VkLayerSettingEXT settings[] = {
+        {"VK_LAYER_LUNARG_test", "my_snapshot_setting", VK_LAYER_SETTING_TYPE_FLOAT32_EXT, 1, input_values}
+    };
+
+    const VkLayerSettingsCreateInfoEXT layer_settings_create_info{
+        VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr, static_cast<std::uint32_t>(std::size(settings)), settings};
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSetWithFlags("VK_LAYER_LUNARG_test", &layer_settings_create_info, nullptr, nullptr,
+                                     VL_LAYER_SETTING_SET_CREATE_RESOLVED_SNAPSHOT_BIT, &layerSettingSet);
+
+    uint32_t value_count = 0;
+    VkResult result_count =
+        vlGetLayerSettingValues(layerSettingSet, "my_snapshot_setting", VL_LAYER_SETTING_TYPE_FLOAT32, &value_count, nullptr);
+    EXPECT_EQ(VK_SUCCESS, result_count);
+    EXPECT_EQ(2, value_count);
+
+    std::vector<float> values(static_cast<uint32_t>(value_count));
+    VkResult result_complete =
+        vlGetLayerSettingValues(layerSettingSet, "my_snapshot_setting", VL_LAYER_SETTING_TYPE_FLOAT32, &value_count, &values[0]);
+    EXPECT_EQ(VK_SUCCESS, result_complete);
+    EXPECT_FLOAT_EQ(1.5f, values[0]);
+    EXPECT_FLOAT_EQ(2.5f, values[1]);
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+TEST(test_layer_setting_snapshot, EnvVar_ResolvedAtCreation) {
+    SetEnv("VK_LUNARG_TEST_MY_SNAPSHOT_ENV_SETTING=76");
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSetWithFlags("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr,
+                                     VL_LAYER_SETTING_SET_CREATE_RESOLVED_SNAPSHOT_BIT | VL_LAYER_SETTING_SET_CREATE_STATISTICS_BIT,
+                                     &layerSettingSet);
+
+    VlLayerSettingStatistics created{};
+    vlGetLayerSettingStatistics(layerSettingSet, &created);
+
+    int32_t value = 0;
+    uint32_t value_count = 1;
+    EXPECT_EQ(VK_SUCCESS,
+              vlGetLayerSettingValues(layerSettingSet, "my_snapshot_env_setting", VL_LAYER_SETTING_TYPE_INT32, &value_count, &value));
+    EXPECT_EQ(76, value);
+
+    // The environment setting was looked up at creation
+    VlLayerSettingStatistics queried{};
+    vlGetLayerSettingStatistics(layerSettingSet, &queried);
+    EXPECT_EQ(created.envLookupCount, queried.envLookupCount);
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+TEST(test_layer_setting_snapshot, UnknownSettings) {
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSetWithFlags("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr,
+                                     VL_LAYER_SETTING_SET_CREATE_RESOLVED_SNAPSHOT_BIT, &layerSettingSet);
+
+    VlLayerSettingSetMemoryUsage created{};
+    vlGetLayerSettingSetMemoryUsage(layerSettingSet, &created);
+
+    // Names no source sets are answered without being added to the snapshot
+    for (int i = 0; i < 1000; ++i) {
+        const std::string &name = "my_unknown_setting_" + std::to_string(i);
+        EXPECT_FALSE(vlHasLayerSetting(layerSettingSet, name.c_str()));
+
+        uint32_t value_count = 0;
+        EXPECT_EQ(VK_SUCCESS, vlGetLayerSettingValues(layerSettingSet, name.c_str(), VL_LAYER_SETTING_TYPE_INT32, &value_count, nullptr));
+        EXPECT_EQ(0, value_count);
+    }
+
+    VlLayerSettingSetMemoryUsage queried{};
+    vlGetLayerSettingSetMemoryUsage(layerSettingSet, &queried);
+    EXPECT_EQ(created.allocatedBytes, queried.allocatedBytes);
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
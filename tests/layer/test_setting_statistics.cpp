@@ -0,0 +1,162 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include "vulkan/layer/vk_layer_settings.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static void SetEnv(const char *value) {
+#ifdef _WIN32
+    _putenv(value);
+#else
+    putenv(const_cast<char *>(value));
+#endif
+}
+
+static std::vector<std::string> logged_messages;
+
+static void VKAPI_PTR RecordMessage(const char *pSettingName, const char *pMessage) {
+    logged_messages.push_back(std::string(pSettingName) + ": " + pMessage);
+}
+
+TEST(test_layer_setting_statistics, Disabled) {
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr, &layerSettingSet);
+
+    VlLayerSettingStatistics statistics{};
+    EXPECT_EQ(VK_ERROR_FEATURE_NOT_PRESENT, vlGetLayerSettingStatistics(layerSettingSet, &statistics));
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
+
+TEST(test_layer_setting_statistics, vlGetLayerSettingStatistics) {
+    SetEnv("VK_LUNARG_TEST_MY_STATISTICS_ENV_SETTING=not_an_integer");
+
+    const int32_t value = 76;
+    const VkLayerSettingEXT settings[] = {{"VK_LAYER_LUNARG_test", "my_setting", VK_LAYER_SETTING_TYPE_INT32_EXT, 1, &value}};
+    const VkLayerSettingsCreateInfoEXT layer_settings_create_info{VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr, 1,
+                                                                  settings};
+
+    logged_messages.clear();
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSetWithFlags("VK_LAYER_LUNARG_test", &layer_settings_create_info, nullptr, RecordMessage,
+                                     VL_LAYER_SETTING_SET_CREATE_STATISTICS_BIT, &layerSettingSet);
+
+    int32_t read_value = 0;
+    uint32_t value_count = 1;
+    EXPECT_EQ(VK_SUCCESS, vlGetLayerSettingValues(layerSettingSet, "my_setting", VL_LAYER_SETTING_TYPE_INT32, &value_count, &read_value));
+    EXPECT_EQ(76, read_value);
+    vlGetLayerSettingValues(layerSettingSet, "my_statistics_env_setting", VL_LAYER_SETTING_TYPE_INT32, &value_count, &read_value);
+
+    VlLayerSettingStatistics statistics{};
+    EXPECT_EQ(VK_SUCCESS, vlGetLayerSettingStatistics(layerSettingSet, &statistics));
+    EXPECT_EQ(2u, statistics.envLookupCount);
+    EXPECT_EQ(2u, statistics.fileLookupCount);
+    EXPECT_EQ(2u, statistics.apiLookupCount);
+    EXPECT_EQ(0u, statistics.cacheHitCount);
+    EXPECT_EQ(0u, statistics.cacheMissCount);
+    EXPECT_LT(0u, statistics.getenvCount);
+    EXPECT_EQ(1u, statistics.parseFailureCount);
+    EXPECT_LT(0u, statistics.allocatedBytes);
+    EXPECT_LE(statistics.allocatedBytes, statistics.peakAllocatedBytes);
+    EXPECT_EQ(2u, statistics.getLayerSettingValuesCount);
+    EXPECT_LT(0u, statistics.getLayerSettingValuesNanoseconds);
+
+    // Frozen values are resolved once, later queries only copy them
+    vlFreezeLayerSettingSet(layerSettingSet);
+    for (int i = 0; i < 3; ++i) {
+        vlGetLayerSettingValues(layerSettingSet, "my_setting", VL_LAYER_SETTING_TYPE_INT32, &value_count, &read_value);
+    }
+    vlGetLayerSettingValues(layerSettingSet, "My_Setting", VL_LAYER_SETTING_TYPE_INT32, &value_count, &read_value);
+
+    EXPECT_EQ(VK_SUCCESS, vlGetLayerSettingStatistics(layerSettingSet, &statistics));
+    EXPECT_EQ(3u, statistics.cacheHitCount);
+    EXPECT_EQ(1u, statistics.cacheMissCount);
+    EXPECT_EQ(6u, statistics.getLayerSettingValuesCount);
+
+    const std::size_t message_count = logged_messages.size();
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+    EXPECT_EQ(message_count, logged_messages.size());
+}
+
+TEST(test_layer_setting_statistics, LogStatistics) {
+    logged_messages.clear();
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSetWithFlags("VK_LAYER_LUNARG_test", nullptr, nullptr, RecordMessage,
+                                     VL_LAYER_SETTING_SET_CREATE_LOG_STATISTICS_BIT, &layerSettingSet);
+
+    VlLayerSettingStatistics statistics{};
+    EXPECT_EQ(VK_SUCCESS, vlGetLayerSettingStatistics(layerSettingSet, &statistics));
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+    ASSERT_EQ(1u, logged_messages.size());
+    EXPECT_EQ(0u, logged_messages[0].find("VK_LAYER_LUNARG_test: lookups env 0 file 0 api 0"));
+}
+
+TEST(test_layer_setting_statistics, LazySettingsFile) {
+    const std::filesystem::path filename = std::filesystem::temp_directory_path() / "test_layer_setting_statistics_lazy.txt";
+    {
+        std::ofstream file(filename, std::ios::trunc);
+        file << "lunarg_test.lazy_setting = 76\n";
+    }
+#ifdef _WIN32
+    _putenv_s("VK_LAYER_SETTINGS_PATH", filename.string().c_str());
+#else
+    setenv("VK_LAYER_SETTINGS_PATH", filename.c_str(), 1);
+#endif
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSetWithFlags("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr, VL_LAYER_SETTING_SET_CREATE_STATISTICS_BIT,
+                                     &layerSettingSet);
+
+    // The settings file isn't looked for until a query needs it
+    VlLayerSettingStatistics statistics{};
+    EXPECT_EQ(VK_SUCCESS, vlGetLayerSettingStatistics(layerSettingSet, &statistics));
+    EXPECT_EQ(0u, statistics.findSettingsFileNanoseconds);
+    EXPECT_EQ(0u, statistics.parseSettingsFileNanoseconds);
+    EXPECT_EQ(1u, statistics.getenvCount);  // The environment scan
+
+    // Concurrent first queries find and parse the settings file once
+    std::vector<int32_t> values(4, 0);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        threads.emplace_back([&, i]() {
+            uint32_t value_count = 1;
+            vlGetLayerSettingValues(layerSettingSet, "lazy_setting", VL_LAYER_SETTING_TYPE_INT32, &value_count, &values[i]);
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    for (int32_t value : values) {
+        EXPECT_EQ(76, value);
+    }
+
+    EXPECT_EQ(VK_SUCCESS, vlGetLayerSettingStatistics(layerSettingSet, &statistics));
+    EXPECT_LT(0u, statistics.findSettingsFileNanoseconds);
+    EXPECT_LT(0u, statistics.parseSettingsFileNanoseconds);
+    const uint64_t getenv_count = statistics.getenvCount;
+
+    uint32_t value_count = 1;
+    int32_t value = 0;
+    vlGetLayerSettingValues(layerSettingSet, "lazy_setting", VL_LAYER_SETTING_TYPE_INT32, &value_count, &value);
+    EXPECT_EQ(VK_SUCCESS, vlGetLayerSettingStatistics(layerSettingSet, &statistics));
+    EXPECT_EQ(getenv_count, statistics.getenvCount);
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+
+#ifdef _WIN32
+    _putenv_s("VK_LAYER_SETTINGS_PATH", "");
+#else
+    unsetenv("VK_LAYER_SETTINGS_PATH");
+#endif
+}
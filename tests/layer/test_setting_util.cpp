@@ -7,10 +7,22 @@
 // Author(s):
 // - Christophe Riccio <christophe@lunarg.com>
 #include "layer_settings_util.hpp"
+#include "layer_settings_file.hpp"
 
 #include <gtest/gtest.h>
 #include <vulkan/vulkan.h>
 
+#include <cfloat>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <regex>
+#include <string>
+#include <vector>
+
 TEST(test_layer_settings_util, FindSettingsInChain_found_first) {
     VkDebugReportCallbackCreateInfoEXT debugReportCallbackCreateInfo{};
     debugReportCallbackCreateInfo.sType = VK_STRUCTURE_TYPE_DEBUG_REPORT_CALLBACK_CREATE_INFO_EXT;
@@ -395,6 +407,179 @@ TEST(test_layer_settings_util, is_framesets) {
     EXPECT_EQ(false, vl::IsFrameSets("1-8-2-1"));
 }
 
+// Strings covering the characters that matter to the validators: every string up to 4 characters over a small
+// alphabet and random longer strings
+static std::vector<std::string> GenerateValidatorInputs() {
+    static const char alphabet[] = {'0', '1', '9', 'a', 'f', 'x', 'F', 'X', 'g', '-', '.', ',', '|', ' '};
+    const std::size_t alphabet_size = std::size(alphabet);
+
+    std::vector<std::string> inputs{""};
+    for (std::size_t begin = 0, length = 1; length <= 4; ++length) {
+        const std::size_t end = inputs.size();
+        for (std::size_t i = begin; i < end; ++i) {
+            for (char c : alphabet) {
+                inputs.push_back(inputs[i] + c);
+            }
+        }
+        begin = end;
+    }
+
+    static const char *tokens[] = {"0", "12", "0x", "0x1F", "-", ".", "f", ",", "1-2", "1-8-2", "-0x", "a", "|"};
+    std::mt19937 generator(76);
+    std::uniform_int_distribution<std::size_t> token_count(1, 8);
+    std::uniform_int_distribution<std::size_t> token_index(0, std::size(tokens) - 1);
+    std::uniform_int_distribution<std::size_t> char_index(0, alphabet_size - 1);
+    for (int i = 0; i < 20000; ++i) {
+        std::string input;
+        for (std::size_t j = 0, n = token_count(generator); j < n; ++j) {
+            input += (j & 1) ? std::string(1, alphabet[char_index(generator)]) : tokens[token_index(generator)];
+        }
+        inputs.push_back(input);
+    }
+
+    return inputs;
+}
+
+// The validators used to be implemented with these regular expressions
+TEST(test_layer_settings_util, validators_match_regex) {
+    const std::regex integer_regex("^-?([0-9]*|0x[0-9|a-z|A-Z]*)$");
+    const std::regex float_regex("^-?[0-9]*([.][0-9]*f?)?$");
+    const std::regex framesets_regex("^([0-9]+([-][0-9]+){0,2})(,([0-9]+([-][0-9]+){0,2}))*$");
+
+    for (const std::string &input : GenerateValidatorInputs()) {
+        EXPECT_EQ(std::regex_search(input, integer_regex), vl::IsInteger(input)) << "IsInteger(\"" << input << "\")";
+        EXPECT_EQ(std::regex_search(input, float_regex), vl::IsFloat(input)) << "IsFloat(\"" << input << "\")";
+        EXPECT_EQ(std::regex_search(input, framesets_regex), vl::IsFrameSets(input)) << "IsFrameSets(\"" << input << "\")";
+    }
+}
+
+TEST(test_layer_settings_util, parse_integer) {
+    int32_t value_int32 = 0;
+    EXPECT_EQ(vl::PARSE_SUCCESS, vl::ParseInteger("-76", value_int32));
+    EXPECT_EQ(-76, value_int32);
+    EXPECT_EQ(vl::PARSE_SUCCESS, vl::ParseInteger("0x1F", value_int32));
+    EXPECT_EQ(31, value_int32);
+    EXPECT_EQ(vl::PARSE_SUCCESS, vl::ParseInteger("-0X1f", value_int32));
+    EXPECT_EQ(-31, value_int32);
+    EXPECT_EQ(vl::PARSE_SUCCESS, vl::ParseInteger("-2147483648", value_int32));
+    EXPECT_EQ(INT32_MIN, value_int32);
+    EXPECT_EQ(vl::PARSE_OUT_OF_RANGE, vl::ParseInteger("2147483648", value_int32));
+    EXPECT_EQ(INT32_MAX, value_int32);
+    EXPECT_EQ(vl::PARSE_OUT_OF_RANGE, vl::ParseInteger("-2147483649", value_int32));
+    EXPECT_EQ(INT32_MIN, value_int32);
+    EXPECT_EQ(vl::PARSE_SUCCESS, vl::ParseInteger("", value_int32));
+    EXPECT_EQ(0, value_int32);
+    EXPECT_EQ(vl::PARSE_INVALID, vl::ParseInteger("12a", value_int32));
+    EXPECT_EQ(vl::PARSE_INVALID, vl::ParseInteger("0xzz", value_int32));
+    EXPECT_EQ(vl::PARSE_INVALID, vl::ParseInteger("+1", value_int32));
+
+    uint32_t value_uint32 = 0;
+    EXPECT_EQ(vl::PARSE_SUCCESS, vl::ParseInteger("0xFFFFFFFF", value_uint32));
+    EXPECT_EQ(0xFFFFFFFFu, value_uint32);
+    EXPECT_EQ(vl::PARSE_OUT_OF_RANGE, vl::ParseInteger("0x100000000", value_uint32));
+    EXPECT_EQ(0xFFFFFFFFu, value_uint32);
+    EXPECT_EQ(vl::PARSE_SUCCESS, vl::ParseInteger("0x10", value_uint32));
+    EXPECT_EQ(16u, value_uint32);
+    EXPECT_EQ(vl::PARSE_SUCCESS, vl::ParseInteger("-1", value_uint32));
+    EXPECT_EQ(0xFFFFFFFFu, value_uint32);
+    EXPECT_EQ(vl::PARSE_SUCCESS, vl::ParseInteger("-2147483648", value_uint32));
+    EXPECT_EQ(0x80000000u, value_uint32);
+    EXPECT_EQ(vl::PARSE_OUT_OF_RANGE, vl::ParseInteger("-2147483649", value_uint32));
+    EXPECT_EQ(0x80000000u, value_uint32);
+
+    uint64_t value_uint64 = 0;
+    EXPECT_EQ(vl::PARSE_SUCCESS, vl::ParseInteger("18446744073709551615", value_uint64));
+    EXPECT_EQ(UINT64_MAX, value_uint64);
+    EXPECT_EQ(vl::PARSE_OUT_OF_RANGE, vl::ParseInteger("18446744073709551616", value_uint64));
+    EXPECT_EQ(UINT64_MAX, value_uint64);
+    EXPECT_EQ(vl::PARSE_SUCCESS, vl::ParseInteger("-1", value_uint64));
+    EXPECT_EQ(UINT64_MAX, value_uint64);
+
+    int64_t value_int64 = 0;
+    EXPECT_EQ(vl::PARSE_SUCCESS, vl::ParseInteger("-9223372036854775808", value_int64));
+    EXPECT_EQ(INT64_MIN, value_int64);
+    EXPECT_EQ(vl::PARSE_OUT_OF_RANGE, vl::ParseInteger("9223372036854775808", value_int64));
+    EXPECT_EQ(INT64_MAX, value_int64);
+}
+
+TEST(test_layer_settings_util, parse_bool) {
+    VkBool32 value = VK_FALSE;
+    EXPECT_EQ(vl::PARSE_SUCCESS, vl::ParseBool("TRUE", value));
+    EXPECT_EQ(VK_TRUE, value);
+    EXPECT_EQ(vl::PARSE_SUCCESS, vl::ParseBool("off", value));
+    EXPECT_EQ(VK_FALSE, value);
+    EXPECT_EQ(vl::PARSE_SUCCESS, vl::ParseBool("On", value));
+    EXPECT_EQ(VK_TRUE, value);
+    EXPECT_EQ(vl::PARSE_SUCCESS, vl::ParseBool("0", value));
+    EXPECT_EQ(VK_FALSE, value);
+    EXPECT_EQ(vl::PARSE_SUCCESS, vl::ParseBool("0x10", value));
+    EXPECT_EQ(VK_TRUE, value);
+    EXPECT_EQ(vl::PARSE_INVALID, vl::ParseBool("yes", value));
+    EXPECT_EQ(VK_FALSE, value);
+}
+
+TEST(test_layer_settings_util, parse_float) {
+    float value_float = 0.0f;
+    EXPECT_EQ(vl::PARSE_SUCCESS, vl::ParseFloat("-1.5F", value_float));
+    EXPECT_FLOAT_EQ(-1.5f, value_float);
+    EXPECT_EQ(vl::PARSE_SUCCESS, vl::ParseFloat("76.", value_float));
+    EXPECT_FLOAT_EQ(76.0f, value_float);
+    EXPECT_EQ(vl::PARSE_SUCCESS, vl::ParseFloat(".25", value_float));
+    EXPECT_FLOAT_EQ(0.25f, value_float);
+    EXPECT_EQ(vl::PARSE_SUCCESS, vl::ParseFloat("-", value_float));
+    EXPECT_FLOAT_EQ(0.0f, value_float);
+    EXPECT_EQ(vl::PARSE_INVALID, vl::ParseFloat("1e5", value_float));
+    EXPECT_EQ(vl::PARSE_INVALID, vl::ParseFloat("1f", value_float));
+    EXPECT_EQ(vl::PARSE_INVALID, vl::ParseFloat("inf", value_float));
+    EXPECT_EQ(vl::PARSE_OUT_OF_RANGE, vl::ParseFloat("1" + std::string(40, '0'), value_float));
+    EXPECT_FLOAT_EQ(FLT_MAX, value_float);
+
+    double value_double = 0.0;
+    EXPECT_EQ(vl::PARSE_SUCCESS, vl::ParseFloat("1" + std::string(40, '0'), value_double));
+    EXPECT_DOUBLE_EQ(1e40, value_double);
+    EXPECT_EQ(vl::PARSE_SUCCESS, vl::ParseFloat("-0.125f", value_double));
+    EXPECT_DOUBLE_EQ(-0.125, value_double);
+}
+
+TEST(test_layer_settings_util, parse_frameset) {
+    VlFrameset value{};
+    EXPECT_EQ(vl::PARSE_SUCCESS, vl::ParseFrameSet("76", value));
+    EXPECT_EQ(76u, value.first);
+    EXPECT_EQ(1u, value.count);
+    EXPECT_EQ(1u, value.step);
+    EXPECT_EQ(vl::PARSE_SUCCESS, vl::ParseFrameSet("1-8-2", value));
+    EXPECT_EQ(1u, value.first);
+    EXPECT_EQ(8u, value.count);
+    EXPECT_EQ(2u, value.step);
+    EXPECT_EQ(vl::PARSE_OUT_OF_RANGE, vl::ParseFrameSet("4294967296-2", value));
+    EXPECT_EQ(UINT32_MAX, value.first);
+    EXPECT_EQ(2u, value.count);
+
+    for (const char *invalid : {"", "-1", "1-", "1--4", "1-8-2-1", "a", "+1"}) {
+        value = VlFrameset{76, 1, 1};
+        EXPECT_EQ(vl::PARSE_INVALID, vl::ParseFrameSet(invalid, value)) << invalid;
+        EXPECT_EQ(0u, value.first) << invalid;
+        EXPECT_EQ(0u, value.count) << invalid;
+        EXPECT_EQ(0u, value.step) << invalid;
+    }
+}
+
+TEST(test_layer_settings_util, next_list_value) {
+    for (const char *list : {"", ",", "a", "a,", ",a", "a,,b", "a,b,", "a,b,c"}) {
+        const std::vector<std::string> &split = vl::Split(list, ',');
+
+        std::vector<std::string> values;
+        std::size_t position = 0;
+        std::string_view value;
+        while (vl::NextListValue(list, ',', position, value)) {
+            values.emplace_back(value);
+        }
+
+        EXPECT_EQ(split, values) << list;
+        EXPECT_EQ(split.size(), vl::CountListValues(list, ',')) << list;
+    }
+}
+
 TEST(test_layer_settings_util, to_framesets) {
     {
         std::vector<VlFrameset> framesets = vl::ToFrameSets("0");
@@ -673,3 +858,187 @@ TEST(test_layer_settings_util, vlGetUnknownSettings) {
     EXPECT_STREQ("bool_value", unknown_settings[0]);
     EXPECT_STREQ("frameset_value", unknown_settings[1]);
 }
+
+TEST(test_layer_settings_util, vlGetUnknownSettings_ManyKnownSettings) {
+    // Enough known settings for vlGetUnknownSettings to index them
+    std::vector<std::string> known_names;
+    for (int i = 0; i < 10000; ++i) {
+        known_names.push_back("known_setting_" + std::to_string(i));
+    }
+    std::vector<const char *> known_settings;
+    for (const std::string &name : known_names) {
+        known_settings.push_back(name.c_str());
+    }
+    known_settings.push_back("known_setting_0");  // Duplicates are accepted
+
+    const uint32_t value = 76;
+    const VkLayerSettingEXT settings[] = {
+        {"VK_LAYER_LUNARG_test", "known_setting_42", VK_LAYER_SETTING_TYPE_UINT32_EXT, 1, &value},
+        {"VK_LAYER_LUNARG_test", "unknown_setting", VK_LAYER_SETTING_TYPE_UINT32_EXT, 1, &value},
+        {"VK_LAYER_LUNARG_test", "Known_Setting_7", VK_LAYER_SETTING_TYPE_UINT32_EXT, 1, &value},
+        {"VK_LAYER_LUNARG_test", "known_setting_9999", VK_LAYER_SETTING_TYPE_UINT32_EXT, 1, &value}};
+    const VkLayerSettingsCreateInfoEXT create_info{VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr,
+                                                   static_cast<uint32_t>(std::size(settings)), settings};
+
+    uint32_t unknown_settings_count = 0;
+    EXPECT_EQ(VK_SUCCESS, vlGetUnknownSettings(&create_info, static_cast<uint32_t>(known_settings.size()), &known_settings[0],
+                                               &unknown_settings_count, nullptr));
+    EXPECT_EQ(2, unknown_settings_count);
+
+    const char *unknown_settings[2] = {};
+    unknown_settings_count = 1;
+    EXPECT_EQ(VK_INCOMPLETE, vlGetUnknownSettings(&create_info, static_cast<uint32_t>(known_settings.size()), &known_settings[0],
+                                                  &unknown_settings_count, unknown_settings));
+    EXPECT_STREQ("unknown_setting", unknown_settings[0]);
+    EXPECT_EQ(nullptr, unknown_settings[1]);
+
+    unknown_settings_count = 2;
+    EXPECT_EQ(VK_SUCCESS, vlGetUnknownSettings(&create_info, static_cast<uint32_t>(known_settings.size()), &known_settings[0],
+                                               &unknown_settings_count, unknown_settings));
+    EXPECT_STREQ("unknown_setting", unknown_settings[0]);
+    EXPECT_STREQ("Known_Setting_7", unknown_settings[1]);
+}
+
+TEST(test_layer_settings_util, vlCreateKnownLayerSettings) {
+    const char *duplicated_settings[] = {"setting_a", "setting_b", "setting_a"};
+    VlKnownLayerSettings known_layer_settings = VK_NULL_HANDLE;
+    EXPECT_EQ(VK_ERROR_INITIALIZATION_FAILED,
+              vlCreateKnownLayerSettings(static_cast<uint32_t>(std::size(duplicated_settings)), duplicated_settings, nullptr,
+                                         &known_layer_settings));
+    EXPECT_EQ(VK_NULL_HANDLE, known_layer_settings);
+
+    const char *known_settings[] = {"setting_a", "setting_b", "setting_c"};
+    ASSERT_EQ(VK_SUCCESS, vlCreateKnownLayerSettings(static_cast<uint32_t>(std::size(known_settings)), known_settings, nullptr,
+                                                     &known_layer_settings));
+
+    const uint32_t value = 76;
+    const VkLayerSettingEXT settings[] = {
+        {"VK_LAYER_LUNARG_test", "setting_a", VK_LAYER_SETTING_TYPE_UINT32_EXT, 1, &value},
+        {"VK_LAYER_LUNARG_test", "setting_d", VK_LAYER_SETTING_TYPE_UINT32_EXT, 1, &value},
+        {"VK_LAYER_LUNARG_test", "setting_c", VK_LAYER_SETTING_TYPE_UINT32_EXT, 1, &value},
+        {"VK_LAYER_LUNARG_test", "setting_e", VK_LAYER_SETTING_TYPE_UINT32_EXT, 1, &value}};
+    const VkLayerSettingsCreateInfoEXT create_info{VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr,
+                                                   static_cast<uint32_t>(std::size(settings)), settings};
+
+    uint32_t unknown_settings_count = 0;
+    EXPECT_EQ(VK_SUCCESS, vlGetUnknownLayerSettings(known_layer_settings, &create_info, &unknown_settings_count, nullptr));
+    EXPECT_EQ(2, unknown_settings_count);
+
+    const char *unknown_settings[2] = {};
+    unknown_settings_count = 1;
+    EXPECT_EQ(VK_INCOMPLETE, vlGetUnknownLayerSettings(known_layer_settings, &create_info, &unknown_settings_count, unknown_settings));
+    EXPECT_STREQ("setting_d", unknown_settings[0]);
+
+    unknown_settings_count = 2;
+    EXPECT_EQ(VK_SUCCESS, vlGetUnknownLayerSettings(known_layer_settings, &create_info, &unknown_settings_count, unknown_settings));
+    EXPECT_STREQ("setting_d", unknown_settings[0]);
+    EXPECT_STREQ("setting_e", unknown_settings[1]);
+
+    unknown_settings_count = 0;
+    EXPECT_EQ(VK_SUCCESS, vlGetUnknownLayerSettings(known_layer_settings, nullptr, &unknown_settings_count, nullptr));
+    EXPECT_EQ(0, unknown_settings_count);
+
+    vlDestroyKnownLayerSettings(known_layer_settings, nullptr);
+}
+
+TEST(test_layer_settings_util, settings_file_parse) {
+    vl::SettingsFile settings_file;
+    settings_file.Parse(
+        "# comment = ignored\n"
+        "lunarg_test.my_setting = true,false  # trailing comment\r\n"
+        "\tlunarg_test.other_setting=76\n"
+        "no value separator\n"
+        "lunarg_test.my_setting = overridden\n"
+        "lunarg_test.equal = a=b\n"
+        "lunarg_test.empty =\n"
+        "lunarg_test.last = 82");
+
+    EXPECT_EQ(5, settings_file.GetEntries().size());
+
+    const vl::SettingsFile::Entry *my_setting = settings_file.Find("lunarg_test.my_setting");
+    ASSERT_NE(nullptr, my_setting);
+    EXPECT_EQ("overridden", my_setting->value);
+
+    const std::string prefix = "lunarg_test.";
+    const uint64_t prefix_hash = vl::HashSettingName(prefix);
+
+    const vl::SettingsFile::Entry *other_setting = settings_file.Find(prefix, prefix_hash, "other_setting");
+    ASSERT_NE(nullptr, other_setting);
+    EXPECT_EQ("76", other_setting->value);
+    EXPECT_EQ("a=b", settings_file.Find(prefix, prefix_hash, "equal")->value);
+    EXPECT_EQ("", settings_file.Find(prefix, prefix_hash, "empty")->value);
+    EXPECT_EQ("82", settings_file.Find(prefix, prefix_hash, "last")->value);
+
+    EXPECT_EQ(nullptr, settings_file.Find(prefix, prefix_hash, "my_setting_b"));
+    EXPECT_EQ(nullptr, settings_file.Find(prefix, prefix_hash, "MY_SETTING"));
+    EXPECT_EQ(nullptr, settings_file.Find("lunarg_test"));
+
+    // Values set after parsing don't override the file
+    settings_file.Insert("lunarg_test.other_setting", "82");
+    settings_file.Insert("lunarg_test.inserted", "true");
+    EXPECT_EQ("76", settings_file.Find(prefix, prefix_hash, "other_setting")->value);
+    EXPECT_EQ("true", settings_file.Find(prefix, prefix_hash, "inserted")->value);
+}
+
+TEST(test_layer_settings_util, settings_file_mapped) {
+    const std::filesystem::path filename = std::filesystem::temp_directory_path() / "test_layer_settings_util_mapped.txt";
+    {
+        std::ofstream file(filename);
+        for (int i = 0; i < 1000; ++i) {
+            file << "lunarg_test.setting_" << i << " = " << i << "\n";
+        }
+    }
+
+    vl::SettingsFile settings_file;
+    settings_file.ParseFile(filename);
+    std::filesystem::remove(filename);
+
+    EXPECT_EQ(1000, settings_file.GetEntries().size());
+    EXPECT_EQ("999", settings_file.Find("lunarg_test.setting_999")->value);
+
+    vl::SettingsFile missing_file;
+    missing_file.ParseFile(filename);
+    EXPECT_TRUE(missing_file.GetEntries().empty());
+}
+
+TEST(test_layer_settings_util, settings_file_cache) {
+    const std::filesystem::path filename = std::filesystem::temp_directory_path() / "test_layer_settings_util_cache.txt";
+    {
+        std::ofstream file(filename);
+        file << "lunarg_test.my_setting = 76\n";
+    }
+
+    std::shared_ptr<const vl::SettingsFile> first = vl::AcquireSettingsFile(filename);
+    std::shared_ptr<const vl::SettingsFile> second = vl::AcquireSettingsFile(filename);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ("76", first->Find("lunarg_test.my_setting")->value);
+
+    // Concurrent layers share the same parse
+    std::vector<std::shared_ptr<const vl::SettingsFile>> acquired(8);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < acquired.size(); ++i) {
+        threads.emplace_back([&acquired, &filename, i] { acquired[i] = vl::AcquireSettingsFile(filename); });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    for (const std::shared_ptr<const vl::SettingsFile> &settings_file : acquired) {
+        EXPECT_EQ(first, settings_file);
+    }
+
+    // A modified file is parsed again while the previous parse remains valid for its owners
+    {
+        std::ofstream file(filename);
+        file << "lunarg_test.my_setting = 82,76\n";
+    }
+
+    std::shared_ptr<const vl::SettingsFile> modified = vl::AcquireSettingsFile(filename);
+    EXPECT_NE(first, modified);
+    EXPECT_EQ("82,76", modified->Find("lunarg_test.my_setting")->value);
+    EXPECT_EQ("76", first->Find("lunarg_test.my_setting")->value);
+
+    std::filesystem::remove(filename);
+
+    std::shared_ptr<const vl::SettingsFile> missing = vl::AcquireSettingsFile(filename);
+    EXPECT_TRUE(missing->GetEntries().empty());
+}
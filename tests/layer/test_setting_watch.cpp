@@ -0,0 +1,194 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include "vulkan/layer/vk_layer_settings.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
+struct ChangedSettings {
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::set<std::string> names;
+    int notifications{0};
+
+    bool WaitNotifications(int count) {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        return this->condition.wait_for(lock, std::chrono::seconds(10), [&] { return this->notifications >= count; });
+    }
+};
+
+static void VKAPI_PTR RecordChangedSettings(void *pUserData, uint32_t settingCount, const char *const *ppSettingNames) {
+    ChangedSettings *changed_settings = static_cast<ChangedSettings *>(pUserData);
+
+    std::lock_guard<std::mutex> lock(changed_settings->mutex);
+    for (uint32_t i = 0; i < settingCount; ++i) {
+        changed_settings->names.insert(ppSettingNames[i]);
+    }
+    ++changed_settings->notifications;
+    changed_settings->condition.notify_all();
+}
+
+static void WriteSettingsFile(const std::filesystem::path &filename, const char *content) {
+    // Write then rename, as tools replacing the settings file do
+    const std::filesystem::path temporary = filename.string() + ".tmp";
+    {
+        std::ofstream file(temporary);
+        file << content;
+    }
+    std::filesystem::rename(temporary, filename);
+}
+
+static std::string GetStringSetting(VlLayerSettingSet layerSettingSet, const char *pSettingName) {
+    uint32_t value_count = 1;
+    const char *value = nullptr;
+    vlGetLayerSettingValues(layerSettingSet, pSettingName, VL_LAYER_SETTING_TYPE_STRING, &value_count, &value);
+    return value == nullptr ? "" : value;
+}
+
+#if defined(__linux__)
+
+TEST(test_layer_setting_watch, ReloadChangedFile) {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "test_layer_setting_watch";
+    std::filesystem::create_directories(directory);
+    const std::filesystem::path filename = directory / "vk_layer_settings.txt";
+
+    WriteSettingsFile(filename,
+                      "lunarg_test.my_setting = 76\n"
+                      "lunarg_test.removed_setting = true\n"
+                      "lunarg_test.same_setting = 1\n"
+                      "lunarg_other.other_setting = 1\n");
+    setenv("VK_LAYER_SETTINGS_PATH", filename.c_str(), 1);
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSetWithFlags("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr,
+                                     VL_LAYER_SETTING_SET_CREATE_WATCH_SETTINGS_FILE_BIT, &layerSettingSet);
+
+    ChangedSettings changed_settings;
+    EXPECT_EQ(VK_SUCCESS, vlSetLayerSettingsChangedCallback(layerSettingSet, RecordChangedSettings, &changed_settings));
+
+    EXPECT_EQ("76", GetStringSetting(layerSettingSet, "my_setting"));
+    EXPECT_TRUE(vlHasLayerSetting(layerSettingSet, "removed_setting"));
+
+    WriteSettingsFile(filename,
+                      "lunarg_test.my_setting = 82\n"
+                      "lunarg_test.added_setting = on\n"
+                      "lunarg_test.same_setting = 1\n"
+                      "lunarg_other.other_setting = 2\n");
+
+    ASSERT_TRUE(changed_settings.WaitNotifications(1));
+    {
+        std::lock_guard<std::mutex> lock(changed_settings.mutex);
+        EXPECT_EQ((std::set<std::string>{"my_setting", "added_setting", "removed_setting"}), changed_settings.names);
+        changed_settings.names.clear();
+    }
+
+    EXPECT_EQ("82", GetStringSetting(layerSettingSet, "my_setting"));
+    EXPECT_TRUE(vlHasLayerSetting(layerSettingSet, "added_setting"));
+    EXPECT_FALSE(vlHasLayerSetting(layerSettingSet, "removed_setting"));
+
+    // Files written in place are reloaded too
+    {
+        std::ofstream file(filename);
+        file << "lunarg_test.my_setting = 76,82\n";
+    }
+
+    ASSERT_TRUE(changed_settings.WaitNotifications(2));
+    EXPECT_EQ("76", GetStringSetting(layerSettingSet, "my_setting"));
+
+    // Files rewritten with the same size and modification time are reloaded too
+    const std::filesystem::file_time_type last_write_time = std::filesystem::last_write_time(filename);
+    {
+        std::ofstream file(filename);
+        file << "lunarg_test.my_setting = 82,76\n";
+    }
+    std::filesystem::last_write_time(filename, last_write_time);
+
+    ASSERT_TRUE(changed_settings.WaitNotifications(3));
+    EXPECT_EQ("82", GetStringSetting(layerSettingSet, "my_setting"));
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+
+    unsetenv("VK_LAYER_SETTINGS_PATH");
+    std::filesystem::remove_all(directory);
+}
+
+TEST(test_layer_setting_watch, ReleaseReplacedSnapshots) {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "test_layer_setting_watch_release";
+    std::filesystem::create_directories(directory);
+    const std::filesystem::path filename = directory / "vk_layer_settings.txt";
+
+    WriteSettingsFile(filename, "lunarg_test.my_setting = 76\n");
+    setenv("VK_LAYER_SETTINGS_PATH", filename.c_str(), 1);
+
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSetWithFlags("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr,
+                                     VL_LAYER_SETTING_SET_CREATE_WATCH_SETTINGS_FILE_BIT, &layerSettingSet);
+    vlFreezeLayerSettingSet(layerSettingSet);
+
+    ChangedSettings changed_settings;
+    EXPECT_EQ(VK_SUCCESS, vlSetLayerSettingsChangedCallback(layerSettingSet, RecordChangedSettings, &changed_settings));
+
+    // Queries run while the reloads release the frozen settings they replace
+    std::atomic<bool> querying{true};
+    std::thread query_thread([&] {
+        while (querying.load()) {
+            const std::string value = GetStringSetting(layerSettingSet, "my_setting");
+            EXPECT_TRUE(value == "76" || value == "82") << value;
+        }
+    });
+
+    VlLayerSettingSetMemoryUsage memory_usage{};
+    for (int reload = 1; reload <= 40; ++reload) {
+        WriteSettingsFile(filename, reload % 2 == 0 ? "lunarg_test.my_setting = 76\n" : "lunarg_test.my_setting = 82\n");
+        ASSERT_TRUE(changed_settings.WaitNotifications(reload));
+        if (reload == 10) {
+            vlGetLayerSettingSetMemoryUsage(layerSettingSet, &memory_usage);
+        }
+    }
+
+    querying.store(false);
+    query_thread.join();
+
+    VlLayerSettingSetMemoryUsage final_memory_usage{};
+    vlGetLayerSettingSetMemoryUsage(layerSettingSet, &final_memory_usage);
+    EXPECT_EQ(memory_usage.allocatedBytes, final_memory_usage.allocatedBytes);
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+
+    unsetenv("VK_LAYER_SETTINGS_PATH");
+    std::filesystem::remove_all(directory);
+}
+
+#endif
+
+TEST(test_layer_setting_watch, ResolvedSnapshot) {
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    EXPECT_EQ(VK_ERROR_INITIALIZATION_FAILED,
+              vlCreateLayerSettingSetWithFlags(
+                  "VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr,
+                  VL_LAYER_SETTING_SET_CREATE_RESOLVED_SNAPSHOT_BIT | VL_LAYER_SETTING_SET_CREATE_WATCH_SETTINGS_FILE_BIT,
+                  &layerSettingSet));
+    EXPECT_EQ(VK_NULL_HANDLE, layerSettingSet);
+}
+
+TEST(test_layer_setting_watch, NotWatching) {
+    VlLayerSettingSet layerSettingSet = VK_NULL_HANDLE;
+    vlCreateLayerSettingSet("VK_LAYER_LUNARG_test", nullptr, nullptr, nullptr, &layerSettingSet);
+
+    EXPECT_EQ(VK_ERROR_FEATURE_NOT_PRESENT, vlSetLayerSettingsChangedCallback(layerSettingSet, RecordChangedSettings, nullptr));
+
+    vlDestroyLayerSettingSet(layerSettingSet, nullptr);
+}
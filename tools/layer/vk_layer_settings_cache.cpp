@@ -0,0 +1,32 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Compile the vk_layer_settings.txt settings of layers into the binary caches loaded by vlCreateLayerSettingSet.
+// The settings file is located as by the layers, the tool must run with the same environment.
+//
+// Usage: vk_layer_settings_cache VK_LAYER_KHRONOS_validation [VK_LAYER_LUNARG_api_dump ...]
+#include "vulkan/layer/vk_layer_settings.h"
+
+#include <cstdio>
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        std::fprintf(stderr, "Usage: %s <layer name>...\n", argv[0]);
+        return 1;
+    }
+
+    int result = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (vlCompileLayerSettingsCache(argv[i]) == VK_SUCCESS) {
+            std::printf("Compiled the settings cache of %s\n", argv[i]);
+        } else {
+            std::fprintf(stderr, "Failed to compile the settings cache of %s\n", argv[i]);
+            result = 1;
+        }
+    }
+
+    return result;
+}
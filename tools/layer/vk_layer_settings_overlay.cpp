@@ -0,0 +1,39 @@
+// Copyright 2023 The Khronos Group Inc.
+// Copyright 2023 Valve Corporation
+// Copyright 2023 LunarG, Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Change the settings of running processes which attached the shared memory segment with vlAttachLayerSettingsOverlay.
+// Without a value, the setting is removed from the segment.
+//
+// Usage: vk_layer_settings_overlay my_segment VK_LAYER_KHRONOS_validation fine_grained_locking false
+//        vk_layer_settings_overlay --remove my_segment
+#include "vulkan/layer/vk_layer_settings.h"
+
+#include <cstdio>
+#include <cstring>
+
+int main(int argc, char *argv[]) {
+    if (argc == 3 && std::strcmp(argv[1], "--remove") == 0) {
+        if (vlRemoveLayerSettingsOverlay(argv[2]) != VK_SUCCESS) {
+            std::fprintf(stderr, "Failed to remove the settings overlay %s\n", argv[2]);
+            return 1;
+        }
+        return 0;
+    }
+
+    if (argc != 4 && argc != 5) {
+        std::fprintf(stderr, "Usage: %s <segment name> <layer name> <setting name> [<value>]\n", argv[0]);
+        std::fprintf(stderr, "       %s --remove <segment name>\n", argv[0]);
+        return 1;
+    }
+
+    const char *value = argc == 5 ? argv[4] : nullptr;
+    if (vlSetLayerSettingsOverlayValue(argv[1], argv[2], argv[3], value) != VK_SUCCESS) {
+        std::fprintf(stderr, "Failed to write %s of %s to the settings overlay %s\n", argv[3], argv[2], argv[1]);
+        return 1;
+    }
+
+    return 0;
+}